@@ -118,9 +118,12 @@ void sli::pool::grow(size_t nelements)
   char *start= n->mem;
   char *last= &start[ (nelements-1)*el_size];
 
+  // The elements of the new chunk are handed out first and in the
+  // order of their addresses. Free elements of older chunks remain
+  // available after them.
   for(char *p=start; p<last; p+=el_size)
     reinterpret_cast<link*>(p)->next=reinterpret_cast<link*>(p+el_size);
-  reinterpret_cast<link*>(last)->next = NULL;
+  reinterpret_cast<link*>(last)->next = head;
   head = reinterpret_cast<link*>(start);
 
 }
@@ -133,7 +136,10 @@ void sli::pool::grow(void)
 
 void sli::pool::reserve(size_t n)
 {
+    // the n elements are placed in one new chunk, so that objects
+    // allocated one after the other are contiguous in memory; the chunk
+    // size is rounded up to the next multiple of block_size
     const size_t capacity=total-instantiations; 
     if(capacity < n)
-    grow(((n-capacity)/block_size+1)*block_size);
+      grow((n + block_size - 1) / block_size * block_size);
 }
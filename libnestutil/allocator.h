@@ -113,7 +113,9 @@ namespace sli {
 	Reserve() ensures that the pool has at least n empty slots,
 	i.e., that the pool can store at least n additional elements
 	before more memory needs to be allocated from the operating
-	system.  
+	system. If the pool has to grow, the n slots are allocated
+	as one contiguous block, from which the next n calls to
+	alloc() are served in the order of increasing addresses.
         @note The semantics of pool::reserve(n) differ from the semantics
 	of reserve(n) for STL containers: for STL containers, n is the total
         number of elements after the reserve() call, while for pool it is the
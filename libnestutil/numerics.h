@@ -69,6 +69,20 @@ namespace numerics {
 #endif
   }
 
+/** Return x to the power mu, without calling std::pow() for the
+ *  exponents 0 and 1, which are the defaults of weight dependences.
+ *  The result is the same as that of std::pow().
+ */
+  inline
+  double pow(double x, double mu)
+  {
+    if ( mu == 1.0 )
+      return x;
+    if ( mu == 0.0 )
+      return 1.0;
+    return std::pow(x, mu);
+  }
+
 }
 
 
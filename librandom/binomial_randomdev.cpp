@@ -123,6 +123,11 @@ unsigned long librandom::BinomialRandomDev::uldev(RngPtr rng) const
 
 void librandom::BinomialRandomDev::set_p_n(double p_s, unsigned int n_s)
 {
+  // generators of superpositions set the parameters before every draw,
+  // mostly to the values they already have
+  if ( p_s == p_ && n_s == n_ )
+    return;
+
   p_ = p_s;
   n_ = n_s;
   init_();
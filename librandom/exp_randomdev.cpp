@@ -20,3 +20,14 @@
  *
  */
 #include "exp_randomdev.h"
+
+void librandom::ExpRandomDev::get_values(RngPtr r, std::vector<double>& values) const
+{
+  RandomGen& rng = *r;
+
+  for ( size_t j = 0 ; j < values.size() ; ++j )
+    values[j] = rng.drandpos();
+
+  for ( size_t j = 0 ; j < values.size() ; ++j )
+    values[j] = -std::log(values[j]);
+}
@@ -62,6 +62,11 @@ Author: Hans Ekkehard Plesser
     double operator()(void);           // non-threaded
     double operator()(RngPtr rthrd) const;   // threaded
 
+    using RandomDev::get_values;
+
+    //! draw values.size() numbers, taking logarithms in a vectorizable loop
+    void get_values(RngPtr, std::vector<double>&) const;
+
     //! set distribution parameters from SLI dict
     void set_status(const DictionaryDatum&) {} 
 
@@ -53,3 +53,29 @@ double librandom::NormalRandomDev::operator()(RngPtr r) const
   else
     return V1 * std::sqrt(-2 * std::log(S)/S);  
 }
+
+void librandom::NormalRandomDev::get_values(RngPtr r, std::vector<double>& values) const
+{
+  // Same algorithm as above, but the accepted pairs are drawn first and
+  // transformed afterwards in a loop without branches, which the
+  // compiler can vectorize.
+  RandomGen& rng = *r;
+  std::vector<double> S(values.size());
+
+  for ( size_t j = 0 ; j < values.size() ; ++j )
+  {
+    double V1;
+    double V2;
+
+    do {
+      V1 = 2 * rng.drand() - 1;
+      V2 = 2 * rng.drand() - 1;
+      S[j] = V1*V1 + V2*V2;
+    } while ( S[j] >= 1 );
+
+    values[j] = V1;
+  }
+
+  for ( size_t j = 0 ; j < values.size() ; ++j )
+    values[j] = S[j] == 0 ? 0 : values[j] * std::sqrt(-2 * std::log(S[j])/S[j]);
+}
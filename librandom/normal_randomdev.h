@@ -68,6 +68,11 @@ Author: Hans Ekkehard Plesser
     double operator()(void);
     double operator()(RngPtr) const;  // threaded
 
+    using RandomDev::get_values;
+
+    //! draw values.size() numbers, transforming them in a vectorizable loop
+    void get_values(RngPtr, std::vector<double>&) const;
+
     //! set distribution parameters from SLI dict
     void set_status(const DictionaryDatum&) {}
 
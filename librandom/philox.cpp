@@ -0,0 +1,139 @@
+/*
+ *  philox.cpp
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "philox.h"
+
+const uint32_t librandom::Philox::M0_ = 0xD2511F53U;
+const uint32_t librandom::Philox::M1_ = 0xCD9E8D57U;
+const uint32_t librandom::Philox::W0_ = 0x9E3779B9U;
+const uint32_t librandom::Philox::W1_ = 0xBB67AE85U;
+const double   librandom::Philox::I2DFactor_ = 1.0/4294967296.0;
+
+librandom::Philox::Philox(unsigned long s)
+{
+  stream_[0] = stream_[1] = 0;
+  seed_(s);
+}
+
+void librandom::Philox::seed_(unsigned long s)
+{
+  seed_value_ = s;
+  key_[0] = static_cast<uint32_t>(s);
+  key_[1] = static_cast<uint32_t>((s >> 16) >> 16);  // 0 for 32-bit long
+  block_ = 0;
+  out_next_ = 4;
+}
+
+void librandom::Philox::set_stream(unsigned long s1, unsigned long s2)
+{
+  stream_[0] = static_cast<uint32_t>(s1);
+  stream_[1] = static_cast<uint32_t>(s2);
+
+  // restart from first block and discard buffered numbers
+  seed(seed_value_);
+}
+
+double librandom::Philox::uniform(unsigned long seed, unsigned long s1,
+                                  unsigned long s2, unsigned long n)
+{
+  const uint64_t block = n / 4;
+  uint32_t x[4] = { static_cast<uint32_t>(block),
+                    static_cast<uint32_t>(block >> 32),
+                    static_cast<uint32_t>(s1),
+                    static_cast<uint32_t>(s2) };
+  rounds_(x, x+1, x+2, x+3, 1,
+          static_cast<uint32_t>(seed), static_cast<uint32_t>((seed >> 16) >> 16));
+  return I2DFactor_ * x[n % 4];
+}
+
+double librandom::Philox::drand_()
+{
+  if ( out_next_ == 4 )
+  {
+    out_[0] = static_cast<uint32_t>(block_);
+    out_[1] = static_cast<uint32_t>(block_ >> 32);
+    out_[2] = stream_[0];
+    out_[3] = stream_[1];
+    rounds_(out_, out_+1, out_+2, out_+3, 1, key_[0], key_[1]);
+    ++block_;
+    out_next_ = 0;
+  }
+  return I2DFactor_ * out_[out_next_++];
+}
+
+void librandom::Philox::fill_(std::vector<double>::iterator first,
+                              std::vector<double>::iterator last)
+{
+  // deliver what is left of the current block
+  while ( first != last && out_next_ < 4 )
+    *first++ = drand_();
+
+  // whole groups of blocks, with the words of all blocks stored
+  // separately so that the rounds are computed lane by lane
+  uint32_t x0[lanes_], x1[lanes_], x2[lanes_], x3[lanes_];
+  while ( last - first >= static_cast<long>(4 * lanes_) )
+  {
+    for ( size_t j = 0 ; j < lanes_ ; ++j )
+    {
+      const uint64_t b = block_ + j;
+      x0[j] = static_cast<uint32_t>(b);
+      x1[j] = static_cast<uint32_t>(b >> 32);
+      x2[j] = stream_[0];
+      x3[j] = stream_[1];
+    }
+    rounds_(x0, x1, x2, x3, lanes_, key_[0], key_[1]);
+    for ( size_t j = 0 ; j < lanes_ ; ++j )
+    {
+      first[4*j]   = I2DFactor_ * x0[j];
+      first[4*j+1] = I2DFactor_ * x1[j];
+      first[4*j+2] = I2DFactor_ * x2[j];
+      first[4*j+3] = I2DFactor_ * x3[j];
+    }
+    block_ += lanes_;
+    first += 4 * lanes_;
+  }
+
+  // remaining numbers block by block
+  while ( first != last )
+    *first++ = drand_();
+}
+
+void librandom::Philox::rounds_(uint32_t* x0, uint32_t* x1, uint32_t* x2, uint32_t* x3,
+                                size_t n, uint32_t k0, uint32_t k1)
+{
+  for ( int r = 0 ; r < 10 ; ++r )
+  {
+    for ( size_t j = 0 ; j < n ; ++j )
+    {
+      const uint64_t p0 = static_cast<uint64_t>(M0_) * x0[j];
+      const uint64_t p1 = static_cast<uint64_t>(M1_) * x2[j];
+      const uint32_t y0 = static_cast<uint32_t>(p1 >> 32) ^ x1[j] ^ k0;
+      const uint32_t y2 = static_cast<uint32_t>(p0 >> 32) ^ x3[j] ^ k1;
+      x1[j] = static_cast<uint32_t>(p1);
+      x3[j] = static_cast<uint32_t>(p0);
+      x0[j] = y0;
+      x2[j] = y2;
+    }
+    k0 += W0_;
+    k1 += W1_;
+  }
+}
@@ -0,0 +1,113 @@
+/*
+ *  philox.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef PHILOX_H
+#define PHILOX_H
+
+#include "randomgen.h"
+#include <vector>
+#include <stdint.h>
+
+namespace librandom
+{
+  /**
+   * Counter-based random generator Philox4x32-10.
+   *
+   * This class implements the Philox4x32 generator with 10 rounds by
+   * Salmon, Moraes, Dror and Shaw, Parallel random numbers: as easy as
+   * 1, 2, 3, Proc SC11 (2011). The generator maps a 128-bit counter and
+   * a 64-bit key to four 32-bit random numbers by a fixed bijection, and
+   * produces the same sequence as philox4x32 of the Random123 library.
+   *
+   * The seed is used as key. The counter consists of a 64-bit block
+   * number, which is incremented for every four numbers drawn, and two
+   * 32-bit stream ids. Generators with the same seed and different
+   * stream ids produce independent sequences, so that, e.g., one stream
+   * can be derived for each neuron from (seed, gid) or for each
+   * connection from (seed, source, target), independent of the thread or
+   * process that draws the numbers. Without set_stream(), both stream ids
+   * are zero.
+   *
+   * As for MT19937, numbers in [0, 1) have a resolution of 2^-32. When
+   * the buffer of RandomGen is refilled, the rounds for several blocks
+   * are computed at once in loops the compiler can vectorize.
+   */
+  class Philox : public RandomGen {
+  public:
+
+    //! Create generator with given seed
+    explicit Philox(unsigned long);
+
+    ~Philox() {};
+
+    RngPtr clone(unsigned long s)
+      {
+	return RngPtr(new Philox(s));
+      }
+
+    /**
+     * Switch to the stream with the given ids and restart it from the
+     * beginning. Only the lower 32 bits of each id are used.
+     */
+    void set_stream(unsigned long, unsigned long = 0);
+
+    /**
+     * Return number n of stream (s1, s2) of a generator seeded with
+     * seed, without creating a generator.
+     */
+    static double uniform(unsigned long seed, unsigned long s1,
+                          unsigned long s2, unsigned long n);
+
+  private:
+    //! implements seeding for RandomGen
+    void   seed_(unsigned long);
+
+    //! implements drawing a single [0,1) number for RandomGen
+    double drand_();
+
+    //! implements bulk drawing for RandomGen
+    void fill_(std::vector<double>::iterator, std::vector<double>::iterator);
+
+    /**
+     * Apply the ten rounds to n counters given by their four words.
+     * The counters are replaced by the random numbers.
+     */
+    static void rounds_(uint32_t* x0, uint32_t* x1, uint32_t* x2, uint32_t* x3,
+                        size_t n, uint32_t k0, uint32_t k1);
+
+    static const uint32_t M0_;      //!< multiplier of first word pair
+    static const uint32_t M1_;      //!< multiplier of second word pair
+    static const uint32_t W0_;      //!< key increment of first key word
+    static const uint32_t W1_;      //!< key increment of second key word
+    static const double   I2DFactor_; //!< int to double factor
+    static const size_t   lanes_ = 16;  //!< blocks computed at once by fill_()
+
+    unsigned long seed_value_;
+    uint32_t key_[2];
+    uint32_t stream_[2];
+    uint64_t block_;      //!< next block to generate
+    uint32_t out_[4];     //!< current block
+    size_t   out_next_;   //!< next number in out_ to deliver, 4 if used up
+  };
+}
+
+#endif
@@ -121,11 +121,19 @@ void librandom::PoissonRandomDev::init_()
     // tabulate Poisson CDF
     double p = std::exp(-mu_);
     P_[0] = p;
-    for ( unsigned k = 1 ; k < n_tab_ ; ++k ) {
+    unsigned k = 1;
+    for ( ; k < n_tab_ ; ++k ) {
       p *= mu_ / k;
       // avoid P_[k] > 1.0
       P_[k] = std::min(1.0, P_[k-1] + p);
+
+      // beyond mu_, the terms decrease, so once a term is too small
+      // to change the sum, all further entries equal this one
+      if ( k > mu_ && P_[k] == P_[k-1] )
+	break;
     }
+    if ( k < n_tab_ )
+      std::fill(P_.begin() + k + 1, P_.end(), P_[k]);
 
     // breaks in case of rounding issues
     assert(( P_[n_tab_ -1] <= 1.0) && 
@@ -320,3 +328,38 @@ void librandom::PoissonRandomDev::proc_f_(const unsigned K,
   fy = om_ * ((( c3_ * x2 + c2_ ) * x2 + c1_ ) * x2 + c0_ );
 
 }
+
+void librandom::PoissonRandomDev::get_uldevs(RngPtr r, std::vector<unsigned long>& values) const
+{
+  if ( mu_ == 0.0 )
+  {
+    values.assign(values.size(), 0);
+    return;
+  }
+
+  if ( mu_ >= 10.0 )
+  {
+    for ( size_t j = 0 ; j < values.size() ; ++j )
+      values[j] = PoissonRandomDev::uldev(r);
+    return;
+  }
+
+  // Case B in Ahrens & Dieter: table lookup, as in uldev()
+  RandomGen& rng = *r;
+  for ( size_t j = 0 ; j < values.size() ; ++j )
+  {
+    const double U = rng.drand();
+    unsigned long K = 0;
+    while ( U > P_[K] && K != n_tab_ )
+      ++K;
+    values[j] = K;
+  }
+}
+
+void librandom::PoissonRandomDev::get_values(RngPtr r, std::vector<double>& values) const
+{
+  std::vector<unsigned long> k(values.size());
+  get_uldevs(r, k);
+  for ( size_t j = 0 ; j < values.size() ; ++j )
+    values[j] = static_cast<double>(k[j]);
+}
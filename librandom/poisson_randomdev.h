@@ -138,6 +138,17 @@ Author: Hans Ekkehard Plesser
     double operator()(void);       //!< return as double
     double operator()(RngPtr) const;     //!< return as double, threaded
 
+    using RandomDev::get_uldevs;
+    using RandomDev::get_values;
+
+    /**
+     * Draw values.size() numbers. For lambda < 10, all uniform numbers
+     * are drawn directly from the RNG and looked up in the table in a
+     * single loop.
+     */
+    void get_uldevs(RngPtr, std::vector<unsigned long>&) const;
+    void get_values(RngPtr, std::vector<double>&) const;
+
   private:
     void init_();   //!< re-compute internal parameters
 
@@ -34,6 +34,7 @@
 #include "random_datums.h"
 #include "knuthlfg.h"
 #include "mt19937.h"
+#include "philox.h"
 #include "gslrandomgen.h"
 
 #include "binomial_randomdev.h"
@@ -103,6 +104,7 @@ void RandomNumbers::init(SLIInterpreter *i)
   // add built-in rngs
   register_rng_<librandom::KnuthLFG>("knuthlfg", rngdict);
   register_rng_<librandom::MT19937>("MT19937", rngdict);
+  register_rng_<librandom::Philox>("Philox", rngdict);
 
   // let GslRandomGen add all of the GSL rngs
   librandom::GslRandomGen::add_gsl_rngs(rngdict);
@@ -311,11 +313,19 @@ void RandomNumbers::RandomArrayFunction::execute(SLIInterpreter *i) const
   result.reserve(n);
 
   if ( rdv->has_uldev() )
+  {
+    std::vector<unsigned long> values(n);
+    rdv->get_uldevs(values);
     for( long j = 0; j < n ; ++j)
-      result.push_back(rdv->uldev());
+      result.push_back(values[j]);
+  }
   else
+  {
+    std::vector<double> values(n);
+    rdv->get_values(values);
     for( long j=0; j<n ; ++j)
-      result.push_back( (*rdv)() );
+      result.push_back(values[j]);
+  }
   
   i->OStack.pop(2);
   i->OStack.push(ArrayDatum(result));
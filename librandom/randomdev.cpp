@@ -37,3 +37,15 @@ unsigned long librandom::RandomDev::uldev(RngPtr) const
   return 0;
 }
 
+
+void librandom::RandomDev::get_values(RngPtr r, std::vector<double>& values) const
+{
+  for ( size_t j = 0 ; j < values.size() ; ++j )
+    values[j] = (*this)(r);
+}
+
+void librandom::RandomDev::get_uldevs(RngPtr r, std::vector<unsigned long>& values) const
+{
+  for ( size_t j = 0 ; j < values.size() ; ++j )
+    values[j] = uldev(r);
+}
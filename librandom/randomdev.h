@@ -24,6 +24,7 @@
 #define RANDOMDEV_H
 
 #include <cassert>
+#include <vector>
 #include "randomgen.h"
 #include "dictdatum.h"
 
@@ -160,6 +161,27 @@ namespace librandom {
     virtual unsigned long uldev(void);
     virtual unsigned long uldev(RngPtr) const;
 
+    /**
+     * Fill values with deviates drawn from the given RNG.
+     *
+     * The deviates are the same as those returned by values.size()
+     * calls to operator()(RngPtr). The default implementation makes
+     * these calls, derived classes may draw all deviates in a single
+     * loop instead, avoiding a virtual call per deviate.
+     */
+    virtual void get_values(RngPtr, std::vector<double>& values) const;
+
+    /**
+     * Fill values with integer deviates drawn from the given RNG, as
+     * get_values() does for uldev(RngPtr).
+     */
+    virtual void get_uldevs(RngPtr, std::vector<unsigned long>& values) const;
+
+    //! fill values using the RNG of the deviate generator
+    void get_values(std::vector<double>& values) const { get_values(rng_, values); }
+    //! fill values using the RNG of the deviate generator
+    void get_uldevs(std::vector<unsigned long>& values) const { get_uldevs(rng_, values); }
+
     /**
      * true if RDG implements uldev function
      */
@@ -65,14 +65,18 @@ void librandom::RandomGen::seed(const unsigned long n)
 
 void librandom::RandomGen::refill_(void)
 {
-  std::vector<double>::iterator i;
-
-  for ( i = buffer_.begin(); i != buffer_.end() ; ++i )
-    *i = drand_();
+  fill_(buffer_.begin(), buffer_.end());
 
   next_ = buffer_.begin();
 }
 
+void librandom::RandomGen::fill_(std::vector<double>::iterator first,
+                                 std::vector<double>::iterator last)
+{
+  for ( ; first != last ; ++first )
+    *first = drand_();
+}
+
 librandom::RngPtr librandom::RandomGen::create_knuthlfg_rng(unsigned long seed)
 {
   return librandom::RngPtr(new librandom::KnuthLFG(seed));
@@ -135,12 +135,14 @@
  * @note
  * For a list of available RNGs, see rngdict info in SLI.
  *
- * NEST comes at present with two built-in random number generators:
+ * NEST comes at present with three built-in random number generators:
  * - knuthlfg, the lagged Fibonacci generator from D.E.Knuth,
  *   The Art of Computer Programming, 3rd ed, vol 2, sec 3.6.
  * - MT19937, the Mersenne Twister by Matsumoto and Nishimura.
- * Implementations of both are directly derived from free code published
- * by the original authors.
+ * - Philox, the counter-based generator Philox4x32-10 by Salmon et al.,
+ *   which supports independent streams for a given seed.
+ * Implementations of the first two are directly derived from free code
+ * published by the original authors.
  *
  * If the GNU Scientific Library (v 1.2 or later) is installed,
  * all uniform random number generators from the GSL are made available,
@@ -294,6 +296,15 @@ namespace librandom {
     virtual void seed_(unsigned long) =0;  //!< seeding interface
     virtual double drand_() =0;            //!< drawing interface
 
+    /**
+     * Fill [first, last) with the next numbers from the generator.
+     * The default implementation calls drand_() for each element.
+     * Generators that can produce many numbers more efficiently at once
+     * may override this, but must deliver the same sequence as drand_().
+     */
+    virtual void fill_(std::vector<double>::iterator first,
+                       std::vector<double>::iterator last);
+
   private:
 
     void refill_();    //!< refill buffer
@@ -98,6 +98,13 @@ Integration parameters
   gsl_error_tol  double - This parameter controls the admissible error of the GSL integrator.
                           Reduce it if NEST complains about numerical instabilities.
 
+Remarks:
+  Unlike the other GSL-integrated neuron models, this model is updated
+  neuron by neuron also if the kernel property population_update is set:
+  its step size control bounds the error relative to the derivative, and
+  spikes are handled after each integration step instead of after each
+  simulation step, neither of which the population solver supports.
+
 Author: Adapted from aeif_cond_alpha by Lyle Muller
 
 Sends: SpikeEvent
@@ -39,6 +39,7 @@ nest::gamma_sup_generator::Internal_states_::Internal_states_(size_t num_bins, u
 {
     occ_.resize(num_bins, ini_occ_ref);
     occ_.back() += ini_occ_act;
+    n_trans_.resize(num_bins);
 }
 
 /* ---------------------------------------------------------------- 
@@ -47,9 +48,6 @@ nest::gamma_sup_generator::Internal_states_::Internal_states_(size_t num_bins, u
 
 nest::ulong_t nest::gamma_sup_generator::Internal_states_::update(double_t transition_prob, librandom::RngPtr rng)
 {
-    std::vector<ulong_t> n_trans;
-    n_trans.resize( occ_.size() );
-    
     // go through all states and draw number of transitioning components
     for (ulong_t i=0; i<occ_.size(); i++)
         {
@@ -67,37 +65,37 @@ nest::ulong_t nest::gamma_sup_generator::Internal_states_::update(double_t trans
                 (  occ_[i] >= 500 && transition_prob * occ_[i] <= 0.1 ))
                 {
                 poisson_dev_.set_lambda( transition_prob * occ_[i] );
-                n_trans[i] = poisson_dev_.uldev(rng);
-                if ( n_trans[i] > occ_[i] )
+                n_trans_[i] = poisson_dev_.uldev(rng);
+                if ( n_trans_[i] > occ_[i] )
                     {
-                    n_trans[i] = occ_[i];
+                    n_trans_[i] = occ_[i];
                     }
                 }
             else
                 {
                 bino_dev_.set_p_n( transition_prob, occ_[i]);
-                n_trans[i] = bino_dev_.uldev(rng); 
+                n_trans_[i] = bino_dev_.uldev(rng); 
                 }
             }
         else
             {
-            n_trans[i] = 0;
+            n_trans_[i] = 0;
             }
         }
     
     // according to above numbers, change the occupation vector
     for (ulong_t i=0; i<occ_.size(); i++)
         {
-        if (n_trans[i]>0) 
+        if (n_trans_[i]>0) 
             {
-            occ_[i] -= n_trans[i];
+            occ_[i] -= n_trans_[i];
             if (i==occ_.size()-1)
-                occ_.front() += n_trans[i];
+                occ_.front() += n_trans_[i];
             else
-                occ_[i+1] += n_trans[i]; 
+                occ_[i+1] += n_trans_[i]; 
             }
         }
-    return n_trans.back();
+    return n_trans_.back();
 }
 
 
@@ -173,6 +171,10 @@ void nest::gamma_sup_generator::init_state_(const Node& proto)
 void nest::gamma_sup_generator::init_buffers_()
 { 
   device_.init_buffers();
+  B_.ports_.clear();
+  B_.ports_recorded_ = false;
+  B_.n_spikes_.clear();
+  B_.next_ = 0;
 }
 
 void nest::gamma_sup_generator::calibrate()
@@ -192,6 +194,12 @@ void nest::gamma_sup_generator::calibrate()
   // elements are unchanged.
   Internal_states_ internal_states0 (P_.gamma_shape_, ini_occ_0, P_.n_proc_ - ini_occ_0 * P_.gamma_shape_);
   B_.internal_states_.resize( P_.num_targets_, internal_states0 );
+
+  // the order in which the hook is called for the targets may have changed
+  B_.ports_.clear();
+  B_.ports_recorded_ = false;
+  B_.n_spikes_.clear();
+  B_.next_ = 0;
 }
 
 
@@ -208,6 +216,8 @@ void nest::gamma_sup_generator::update(Time const & T, const long_t from, const
   if ( P_.rate_ <= 0 || P_.num_targets_ == 0 ) 
     return;
 
+  librandom::RngPtr rng = net_->get_rng(get_thread());
+
   for ( long_t lag = from ; lag < to ; ++lag )
   {
     Time t = T + Time::step(lag); 
@@ -215,6 +225,29 @@ void nest::gamma_sup_generator::update(Time const & T, const long_t from, const
     if ( !device_.is_active( t ) )
       continue;  // no spike at this lag
     
+    if ( !B_.ports_recorded_ )
+    {
+      // the hook draws for each target and records its port
+      DSSpikeEvent se;
+      network()->send(*this, se, lag);
+      B_.ports_recorded_ = true;
+      B_.n_spikes_.resize( B_.ports_.size() );
+      continue;
+    }
+
+    // propagate the processes of all targets and draw their spikes,
+    // in the order in which the hook would have done it
+    bool has_spikes = false;
+    for ( size_t k = 0 ; k < B_.ports_.size() ; ++k )
+    {
+      B_.n_spikes_[k] = B_.internal_states_[B_.ports_[k]].update( V_.transition_prob_, rng );
+      has_spikes = has_spikes || B_.n_spikes_[k] > 0;
+    }
+
+    if ( !has_spikes )
+      continue;
+
+    B_.next_ = 0;
     DSSpikeEvent se;
     network()->send(*this, se, lag);
   }
@@ -227,11 +260,21 @@ void nest::gamma_sup_generator::event_hook(DSSpikeEvent& e)
   // get port number
   const port prt = e.get_port();
 
-  // we handle only one port here, get reference to vector elem
+  // we handle only one port here
   assert(0 <= prt && static_cast<size_t>(prt) < B_.internal_states_.size() );
 
-  // age_distribution object propagates one time step and returns number of spikes
-  ulong_t n_spikes = B_.internal_states_[prt].update( V_.transition_prob_, net_->get_rng(get_thread()) );
+  ulong_t n_spikes;
+  if ( B_.ports_recorded_ )
+  {
+    assert(B_.next_ < B_.n_spikes_.size() && B_.ports_[B_.next_] == prt);
+    n_spikes = B_.n_spikes_[B_.next_++];
+  }
+  else
+  {
+    // ports not recorded yet, draw here
+    n_spikes = B_.internal_states_[prt].update( V_.transition_prob_, net_->get_rng(get_thread()) );
+    B_.ports_.push_back(prt);
+  }
   
   if ( n_spikes > 0 ) // we must not send events with multiplicity 0
   {
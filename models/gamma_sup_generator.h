@@ -96,18 +96,18 @@ namespace nest{
 
     /**
      * Update state.
-     * Update cannot send spikes directly, since we need to identify each
-     * target to know the age distribution of the component processes. 
-     * Since target information is in the Connectors, we send a DSSpikeEvent
-     * to all targets, which is reflected to this->event_hook() with target 
-     * information.
+     * Update propagates the component processes of all targets one step
+     * and draws the numbers of spikes of all targets. Update cannot send
+     * the spikes directly, since target information is in the Connectors.
+     * If any target has spikes, we send a DSSpikeEvent to all targets,
+     * which is reflected to this->event_hook() with target information.
      * @see event_hook, DSSpikeEvent
      */
     void update(Time const &, const long_t, const long_t);
     
     /**
      * Send out spikes.
-     * Called once per target to dispatch actual output spikes.
+     * Called once per target to dispatch the output spikes drawn by update().
      * @param contains target information.
      */
     void event_hook(DSSpikeEvent&);
@@ -143,6 +143,7 @@ namespace nest{
       librandom::BinomialRandomDev bino_dev_;       //!< random deviate generator
       librandom::PoissonRandomDev poisson_dev_;     //!< random deviate generator
       std::vector<ulong_t> occ_;                    //!< occupation numbers of internal states
+      std::vector<ulong_t> n_trans_;                //!< numbers of transitions in the current step
       
       public:
       Internal_states_(size_t num_bins, ulong_t ini_occ_ref, ulong_t ini_occ_act);  //!< initialize occupation numbers
@@ -157,6 +158,21 @@ namespace nest{
        */
 
       std::vector<Internal_states_> internal_states_;
+
+      /**
+       * Ports of the targets in the order in which the event hook is
+       * called. They are recorded during the first active step after
+       * calibration, in which the hook draws the spikes itself.
+       */
+      std::vector<port> ports_;
+      bool ports_recorded_;   //!< true once ports_ has been recorded
+
+      /**
+       * Numbers of spikes of the targets in the current time step,
+       * in the order of ports_.
+       */
+      std::vector<ulong_t> n_spikes_;
+      size_t next_;   //!< next element of n_spikes_ to hand out
       
     };
 
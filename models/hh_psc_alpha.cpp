@@ -32,7 +32,9 @@
 #include "doubledatum.h"
 #include "dictutils.h"
 #include "numerics.h"
+#include "population_rkf45.h"
 #include <limits>
+#include <algorithm>
 #include "universal_data_logger_impl.h"
 
 #include <iomanip>
@@ -313,21 +315,15 @@ void nest::hh_psc_alpha::init_buffers_()
   B_.step_ = Time::get_resolution().get_ms();
   B_.IntegrationStep_ = B_.step_;
 
-  static const gsl_odeiv_step_type* T1 = gsl_odeiv_step_rkf45;
-  
-  if ( B_.s_ == 0 )
-    B_.s_ = gsl_odeiv_step_alloc (T1, State_::STATE_VEC_SIZE);
-  else 
+  // the GSL solver is allocated by update() when it is first needed,
+  // neurons integrated by update_population() do without it
+  if ( B_.s_ != 0 )
     gsl_odeiv_step_reset(B_.s_);
     
-  if ( B_.c_ == 0 )  
-    B_.c_ = gsl_odeiv_control_y_new (1e-3, 0.0);
-  else
+  if ( B_.c_ != 0 )
     gsl_odeiv_control_init(B_.c_, 1e-3, 0.0, 1.0, 0.0);
     
-  if ( B_.e_ == 0 )  
-    B_.e_ = gsl_odeiv_evolve_alloc(State_::STATE_VEC_SIZE);
-  else 
+  if ( B_.e_ != 0 )
     gsl_odeiv_evolve_reset(B_.e_);
   
   B_.sys_.function  = hh_psc_alpha_dynamics; 
@@ -358,6 +354,13 @@ void nest::hh_psc_alpha::update(Time const & origin, const long_t from, const lo
   assert(to >= 0 && (delay) from < Scheduler::get_min_delay());
   assert(from < to);
 
+  if ( B_.s_ == 0 )
+  {
+    B_.s_ = gsl_odeiv_step_alloc(gsl_odeiv_step_rkf45, State_::STATE_VEC_SIZE);
+    B_.c_ = gsl_odeiv_control_y_new(1e-3, 0.0);
+    B_.e_ = gsl_odeiv_evolve_alloc(State_::STATE_VEC_SIZE);
+  }
+
   for ( long_t lag = from ; lag < to ; ++lag )
   {
     
@@ -417,6 +420,67 @@ void nest::hh_psc_alpha::update(Time const & origin, const long_t from, const lo
   }
 }
 
+void nest::hh_psc_alpha::update_population(std::vector<Node*>::const_iterator first,
+                                           std::vector<Node*>::const_iterator last,
+                                           std::vector<double_t>& buffer,
+                                           Time const & origin, const long_t from, const long_t to)
+{
+  assert(to >= 0 && (delay) from < Scheduler::get_min_delay());
+  assert(from < to);
+
+  const size_t n = last - first;
+  PopulationRKF45 solver(buffer, n, State_::STATE_VEC_SIZE, 1e-3);
+  for ( size_t i = 0 ; i < n ; ++i )
+  {
+    hh_psc_alpha& node = static_cast<hh_psc_alpha&>(*first[i]);
+    solver.set_system(i, node.S_.y_, node.B_.IntegrationStep_, &node);
+  }
+
+  const double_t step = Time::get_resolution().get_ms();
+
+  for ( long_t lag = from ; lag < to ; ++lag )
+  {
+    const int status = solver.integrate(hh_psc_alpha_dynamics, step);
+    if ( status != GSL_SUCCESS )
+      throw GSLSolverFailure(first[solver.failed()]->get_name(), status);
+
+    // the remainder of the step is done as in update(); the state of
+    // each neuron is kept up to date in S_.y_ to provide U_old
+    for ( size_t i = 0 ; i < n ; ++i )
+    {
+      hh_psc_alpha& node = static_cast<hh_psc_alpha&>(*first[i]);
+      double_t* const y = solver.y(i);
+      const double_t U_old = node.S_.y_[State_::V_M];
+
+      y[State_::DI_EXC] += node.B_.spike_exc_.get_value(lag) * node.V_.PSCurrInit_E_;
+      y[State_::DI_INH] += node.B_.spike_inh_.get_value(lag) * node.V_.PSCurrInit_I_;
+
+      if ( node.S_.r_ > 0 )
+        --node.S_.r_;
+      else if ( y[State_::V_M] >= 0 && U_old > y[State_::V_M] )
+      {
+        node.S_.r_ = node.V_.RefractoryCounts_;
+
+        node.set_spiketime(Time::step(origin.get_steps()+lag+1));
+
+        SpikeEvent se;
+        network()->send(node, se, lag);
+      }
+
+      std::copy(y, y + State_::STATE_VEC_SIZE, node.S_.y_);
+      node.B_.logger_.record_data(origin.get_steps() + lag);
+
+      node.B_.I_stim_ = node.B_.currents_.get_value(lag);
+    }
+  }
+
+  for ( size_t i = 0 ; i < n ; ++i )
+  {
+    hh_psc_alpha& node = static_cast<hh_psc_alpha&>(*first[i]);
+    node.B_.IntegrationStep_ = solver.h(i);
+  }
+}
+
 void nest::hh_psc_alpha::handle(SpikeEvent & e)
 {
   assert(e.get_delay() > 0);
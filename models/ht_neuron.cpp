@@ -25,8 +25,10 @@
 #ifdef HAVE_GSL_1_11
 
 #include "universal_data_logger_impl.h"
+#include "population_rkf45.h"
 
 #include <cmath>
+#include <algorithm>
 
 namespace nest{
   
@@ -445,21 +447,15 @@ namespace nest{
     B_.step_ = Time::get_resolution().get_ms();
     B_.IntegrationStep_ = B_.step_;
 
-    static const gsl_odeiv_step_type* T1 = gsl_odeiv_step_rkf45;
-  
-    if ( B_.s_ == 0 )
-      B_.s_ = gsl_odeiv_step_alloc (T1, State_::STATE_VEC_SIZE);
-    else 
+    // the GSL solver is allocated by update() when it is first needed,
+    // neurons integrated by update_population() do without it
+    if ( B_.s_ != 0 )
       gsl_odeiv_step_reset(B_.s_);
     
-    if ( B_.c_ == 0 )  
-      B_.c_ = gsl_odeiv_control_y_new (1e-3, 0.0);
-    else
+    if ( B_.c_ != 0 )
       gsl_odeiv_control_init(B_.c_, 1e-3, 0.0, 1.0, 0.0);
     
-    if ( B_.e_ == 0 )  
-      B_.e_ = gsl_odeiv_evolve_alloc(State_::STATE_VEC_SIZE);
-    else 
+    if ( B_.e_ != 0 )
       gsl_odeiv_evolve_reset(B_.e_);
   
     B_.sys_.function  = ht_neuron_dynamics; 
@@ -556,6 +552,13 @@ namespace nest{
   {
     assert(to >= 0 && (delay) from < Scheduler::get_min_delay());
     assert(from < to);
+
+    if ( B_.s_ == 0 )
+    {
+      B_.s_ = gsl_odeiv_step_alloc(gsl_odeiv_step_rkf45, State_::STATE_VEC_SIZE);
+      B_.c_ = gsl_odeiv_control_y_new(1e-3, 0.0);
+      B_.e_ = gsl_odeiv_evolve_alloc(State_::STATE_VEC_SIZE);
+    }
     
     for ( long_t lag = from ; lag < to ; ++lag )
       {
@@ -609,6 +612,84 @@ namespace nest{
 	B_.logger_.record_data(origin.get_steps()+lag);
       }
   }
+
+  void ht_neuron::update_population(std::vector<Node*>::const_iterator first,
+				    std::vector<Node*>::const_iterator last,
+				    std::vector<double_t>& buffer,
+				    Time const & origin,
+				    const long_t from, const long_t to)
+  {
+    assert(to >= 0 && (delay) from < Scheduler::get_min_delay());
+    assert(from < to);
+
+    const size_t n = last - first;
+    PopulationRKF45 solver(buffer, n, State_::STATE_VEC_SIZE, 1e-3);
+    for ( size_t i = 0 ; i < n ; ++i )
+      {
+	ht_neuron& node = static_cast<ht_neuron&>(*first[i]);
+	solver.set_system(i, node.S_.y_, node.B_.IntegrationStep_, &node);
+      }
+
+    const double_t step = Time::get_resolution().get_ms();
+
+    for ( long_t lag = from ; lag < to ; ++lag )
+      {
+	const int status = solver.integrate(ht_neuron_dynamics, step);
+	if ( status != GSL_SUCCESS )
+	  throw GSLSolverFailure(first[solver.failed()]->get_name(), status);
+
+	// the remainder of the step is done as in update()
+	for ( size_t i = 0 ; i < n ; ++i )
+	  {
+	    ht_neuron& node = static_cast<ht_neuron&>(*first[i]);
+	    double_t* const y = solver.y(i);
+
+	    // The intrinsic currents are recorded as left by the last call
+	    // of the dynamics function. The GSL solver evaluates it at the
+	    // end of each step, PopulationRKF45 does not.
+	    if ( node.B_.logger_.has_loggers() )
+	      {
+		double_t f[State_::STATE_VEC_SIZE];
+		ht_neuron_dynamics(step, y, f, &node);
+	      }
+
+	    if( node.S_.r_potassium_ && --node.S_.r_potassium_ == 0 )
+	      node.S_.g_spike_ = false;
+
+	    for(size_t k = 0; k < node.B_.spike_inputs_.size(); ++k )
+	      y[2+2*k] += node.V_.cond_steps_[k] * node.B_.spike_inputs_[k].get_value(lag);
+
+	    if( !node.S_.g_spike_ && y[State_::VM] >= y[State_::THETA] )
+	      {
+		y[State_::VM] = node.P_.E_Na;
+		y[State_::THETA] = node.P_.E_Na;
+
+		node.S_.g_spike_ = node.V_.PotassiumRefractoryCounts_ > 0;
+		node.S_.r_potassium_ = node.V_.PotassiumRefractoryCounts_;
+
+		node.set_spiketime(Time::step(origin.get_steps()+lag+1));
+
+		SpikeEvent se;
+		network()->send(node, se, lag);
+	      }
+
+	    node.B_.I_stim_ = node.B_.currents_.get_value(lag);
+
+	    if ( node.B_.logger_.has_loggers() )
+	      {
+		std::copy(y, y + State_::STATE_VEC_SIZE, node.S_.y_);
+		node.B_.logger_.record_data(origin.get_steps()+lag);
+	      }
+	  }
+      }
+
+    for ( size_t i = 0 ; i < n ; ++i )
+      {
+	ht_neuron& node = static_cast<ht_neuron&>(*first[i]);
+	std::copy(solver.y(i), solver.y(i) + State_::STATE_VEC_SIZE, node.S_.y_);
+	node.B_.IntegrationStep_ = solver.h(i);
+      }
+  }
   
   void nest::ht_neuron::handle(SpikeEvent & e)
   {
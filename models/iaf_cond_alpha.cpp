@@ -32,8 +32,10 @@
 #include "doubledatum.h"
 #include "dictutils.h"
 #include "numerics.h"
+#include "population_rkf45.h"
 #include "universal_data_logger_impl.h"
 #include <limits>
+#include <algorithm>
 
 #include <iomanip>
 #include <iostream>
@@ -86,20 +88,20 @@ inline int nest::iaf_cond_alpha_dynamics(double, const double y[], double f[], v
   
   // The following code is verbose for the sake of clarity. We assume that a
   // good compiler will optimize the verbosity away ...
-  const double_t I_syn_exc = y[S::G_EXC] * ( y[S::V_M] - node.P_.E_ex );
-  const double_t I_syn_inh = y[S::G_INH] * ( y[S::V_M] - node.P_.E_in );
-  const double_t I_leak    = node.P_.g_L * ( y[S::V_M] - node.P_.E_L  );
+  const double_t I_syn_exc = y[S::G_EXC] * ( y[S::V_M] - node.P_->E_ex );
+  const double_t I_syn_inh = y[S::G_INH] * ( y[S::V_M] - node.P_->E_in );
+  const double_t I_leak    = node.P_->g_L * ( y[S::V_M] - node.P_->E_L  );
 
   // dV_m/dt
-  f[0]= ( - I_leak - I_syn_exc - I_syn_inh + node.B_.I_stim_ + node.P_.I_e ) / node.P_.C_m;
+  f[0]= ( - I_leak - I_syn_exc - I_syn_inh + node.B_.I_stim_ + node.P_->I_e ) / node.P_->C_m;
 
   // d dg_exc/dt, dg_exc/dt
-  f[1] = -y[S::DG_EXC] / node.P_.tau_synE;
-  f[2] =  y[S::DG_EXC] - (y[S::G_EXC]/node.P_.tau_synE); 
+  f[1] = -y[S::DG_EXC] / node.P_->tau_synE;
+  f[2] =  y[S::DG_EXC] - (y[S::G_EXC]/node.P_->tau_synE); 
 
   // d dg_exc/dt, dg_exc/dt
-  f[3] = -y[S::DG_INH] / node.P_.tau_synI;
-  f[4] =  y[S::DG_INH] - (y[S::G_INH]/node.P_.tau_synI); 
+  f[3] = -y[S::DG_INH] / node.P_->tau_synI;
+  f[4] =  y[S::DG_INH] - (y[S::G_INH]/node.P_->tau_synI); 
 
   return GSL_SUCCESS;
  }
@@ -174,6 +176,14 @@ nest::iaf_cond_alpha::Buffers_::Buffers_(const Buffers_&, iaf_cond_alpha& n)
  * Parameter and state extractions and manipulation functions
  * ---------------------------------------------------------------- */
 
+bool nest::iaf_cond_alpha::Parameters_::operator==(const Parameters_& p) const
+{
+  return V_th == p.V_th && V_reset == p.V_reset && t_ref == p.t_ref
+    && g_L == p.g_L && C_m == p.C_m && E_ex == p.E_ex && E_in == p.E_in
+    && E_L == p.E_L && tau_synE == p.tau_synE && tau_synI == p.tau_synI
+    && I_e == p.I_e;
+}
+
 void nest::iaf_cond_alpha::Parameters_::get(DictionaryDatum &d) const
 {
   def<double>(d,names::V_th,         V_th);
@@ -238,8 +248,8 @@ void nest::iaf_cond_alpha::State_::set(const DictionaryDatum& d, const Parameter
 
 nest::iaf_cond_alpha::iaf_cond_alpha()
   : Archiving_Node(), 
-    P_(), 
-    S_(P_),
+    P_(new Parameters_()), 
+    S_(*P_),
     B_(*this)
 {
   recordablesMap_.create();
@@ -284,21 +294,15 @@ void nest::iaf_cond_alpha::init_buffers_()
   B_.step_ = Time::get_resolution().get_ms();
   B_.IntegrationStep_ = B_.step_;
 
-  static const gsl_odeiv_step_type* T1 = gsl_odeiv_step_rkf45;
-  
-  if ( B_.s_ == 0 )
-    B_.s_ = gsl_odeiv_step_alloc (T1, State_::STATE_VEC_SIZE);
-  else 
+  // the GSL solver is allocated by update() when it is first needed,
+  // neurons integrated by update_population() do without it
+  if ( B_.s_ != 0 )
     gsl_odeiv_step_reset(B_.s_);
     
-  if ( B_.c_ == 0 )  
-    B_.c_ = gsl_odeiv_control_y_new (1e-3, 0.0);
-  else
+  if ( B_.c_ != 0 )
     gsl_odeiv_control_init(B_.c_, 1e-3, 0.0, 1.0, 0.0);
     
-  if ( B_.e_ == 0 )  
-    B_.e_ = gsl_odeiv_evolve_alloc(State_::STATE_VEC_SIZE);
-  else 
+  if ( B_.e_ != 0 )
     gsl_odeiv_evolve_reset(B_.e_);
   
   B_.sys_.function  = iaf_cond_alpha_dynamics; 
@@ -313,9 +317,9 @@ void nest::iaf_cond_alpha::calibrate()
 {
   B_.logger_.init();  // ensures initialization in case mm connected after Simulate
 
-  V_.PSConInit_E  = 1.0 * numerics::e / P_.tau_synE;
-  V_.PSConInit_I  = 1.0 * numerics::e / P_.tau_synI;
-  V_.RefractoryCounts = Time(Time::ms(P_.t_ref)).get_steps();
+  V_.PSConInit_E  = 1.0 * numerics::e / P_->tau_synE;
+  V_.PSConInit_I  = 1.0 * numerics::e / P_->tau_synI;
+  V_.RefractoryCounts = Time(Time::ms(P_->t_ref)).get_steps();
   
   assert(V_.RefractoryCounts >= 0);  // since t_ref >= 0, this can only fail in error
 }
@@ -330,6 +334,13 @@ void nest::iaf_cond_alpha::update(Time const & origin, const long_t from, const
   assert(to >= 0 && (delay) from < Scheduler::get_min_delay());
   assert(from < to);
 
+  if ( B_.s_ == 0 )
+  {
+    B_.s_ = gsl_odeiv_step_alloc(gsl_odeiv_step_rkf45, State_::STATE_VEC_SIZE);
+    B_.c_ = gsl_odeiv_control_y_new(1e-3, 0.0);
+    B_.e_ = gsl_odeiv_evolve_alloc(State_::STATE_VEC_SIZE);
+  }
+
   for ( long_t lag = from ; lag < to ; ++lag )
   {
     
@@ -365,14 +376,14 @@ void nest::iaf_cond_alpha::update(Time const & origin, const long_t from, const
     if ( S_.r )
     {// neuron is absolute refractory
 	    --S_.r; 
-	    S_.y[State_::V_M] = P_.V_reset;  // clamp potential
+	    S_.y[State_::V_M] = P_->V_reset;  // clamp potential
     }
     else
       // neuron is not absolute refractory
-      if ( S_.y[State_::V_M] >= P_.V_th )
+      if ( S_.y[State_::V_M] >= P_->V_th )
       {
 	S_.r              = V_.RefractoryCounts;
-	S_.y[State_::V_M] = P_.V_reset;
+	S_.y[State_::V_M] = P_->V_reset;
 
 	// log spike with Archiving_Node
 	set_spiketime(Time::step(origin.get_steps()+lag+1));
@@ -393,6 +404,73 @@ void nest::iaf_cond_alpha::update(Time const & origin, const long_t from, const
   }
 }
 
+void nest::iaf_cond_alpha::update_population(std::vector<Node*>::const_iterator first,
+                                             std::vector<Node*>::const_iterator last,
+                                             std::vector<double_t>& buffer,
+                                             Time const & origin, const long_t from, const long_t to)
+{
+  assert(to >= 0 && (delay) from < Scheduler::get_min_delay());
+  assert(from < to);
+
+  const size_t n = last - first;
+  PopulationRKF45 solver(buffer, n, State_::STATE_VEC_SIZE, 1e-3);
+  for ( size_t i = 0 ; i < n ; ++i )
+  {
+    iaf_cond_alpha& node = static_cast<iaf_cond_alpha&>(*first[i]);
+    solver.set_system(i, node.S_.y, node.B_.IntegrationStep_, &node);
+  }
+
+  const double_t step = Time::get_resolution().get_ms();
+
+  for ( long_t lag = from ; lag < to ; ++lag )
+  {
+    const int status = solver.integrate(iaf_cond_alpha_dynamics, step);
+    if ( status != GSL_SUCCESS )
+      throw GSLSolverFailure(first[solver.failed()]->get_name(), status);
+
+    // the remainder of the step is done as in update()
+    for ( size_t i = 0 ; i < n ; ++i )
+    {
+      iaf_cond_alpha& node = static_cast<iaf_cond_alpha&>(*first[i]);
+      double_t* const y = solver.y(i);
+
+      if ( node.S_.r )
+      {
+        --node.S_.r;
+        y[State_::V_M] = node.P_->V_reset;
+      }
+      else if ( y[State_::V_M] >= node.P_->V_th )
+      {
+        node.S_.r      = node.V_.RefractoryCounts;
+        y[State_::V_M] = node.P_->V_reset;
+
+        node.set_spiketime(Time::step(origin.get_steps()+lag+1));
+
+        SpikeEvent se;
+        network()->send(node, se, lag);
+      }
+
+      y[State_::DG_EXC] += node.B_.spike_exc_.get_value(lag) * node.V_.PSConInit_E;
+      y[State_::DG_INH] += node.B_.spike_inh_.get_value(lag) * node.V_.PSConInit_I;
+
+      node.B_.I_stim_ = node.B_.currents_.get_value(lag);
+
+      if ( node.B_.logger_.has_loggers() )
+      {
+        std::copy(y, y + State_::STATE_VEC_SIZE, node.S_.y);
+        node.B_.logger_.record_data(origin.get_steps() + lag);
+      }
+    }
+  }
+
+  for ( size_t i = 0 ; i < n ; ++i )
+  {
+    iaf_cond_alpha& node = static_cast<iaf_cond_alpha&>(*first[i]);
+    std::copy(solver.y(i), solver.y(i) + State_::STATE_VEC_SIZE, node.S_.y);
+    node.B_.IntegrationStep_ = solver.h(i);
+  }
+}
+
 void nest::iaf_cond_alpha::handle(SpikeEvent & e)
 {
   assert(e.get_delay() > 0);
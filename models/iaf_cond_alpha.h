@@ -34,6 +34,7 @@
 #include "connection.h"
 #include "universal_data_logger.h"
 #include "recordables_map.h"
+#include "lockptr.h"
 
 #include <gsl/gsl_errno.h>
 #include <gsl/gsl_matrix.h>
@@ -146,6 +147,25 @@ namespace nest
     void get_status(DictionaryDatum &) const;
     void set_status(const DictionaryDatum &);
 
+    const void* get_shared_parameters(size_t& size) const
+    {
+      size = sizeof(Parameters_);
+      return &(*P_);
+    }
+
+    /**
+     * Update all neurons in [first, last) at once. The state vectors
+     * are integrated together by PopulationRKF45, which uses the same
+     * scheme as the GSL solver of update(), but needs no GSL solver
+     * objects in the neurons.
+     * @see Node::update_population()
+     */
+    static
+    void update_population(std::vector<Node*>::const_iterator first,
+                           std::vector<Node*>::const_iterator last,
+                           std::vector<double_t>& buffer,
+                           Time const &, const long_t, const long_t);
+
   private:
     void init_state_(const Node& proto);
     void init_buffers_();
@@ -183,6 +203,8 @@ namespace nest
   
       Parameters_();        //!< Set default parameter values
 
+      bool operator==(const Parameters_&) const;
+
       void get(DictionaryDatum&) const;  //!< Store current values in dictionary
       void set(const DictionaryDatum&);  //!< Set values from dicitonary
     };
@@ -306,7 +328,15 @@ namespace nest
     // Data members ----------------------------------------------------------- 
 
     // keep the order of these lines, seems to give best performance
-    Parameters_ P_;
+
+    /**
+     * Parameters, shared by all nodes with the same parameter values.
+     * Nodes created from the prototype share its parameters, set_status()
+     * gives a node its own copy as soon as one of its parameters differs.
+     * Reference counts are not thread-safe, so nodes must only be
+     * created and configured outside of parallel regions.
+     */
+    lockPTR<Parameters_> P_;
     State_      S_;
     Variables_  V_;
     Buffers_    B_;
@@ -355,7 +385,7 @@ namespace nest
   inline
   void iaf_cond_alpha::get_status(DictionaryDatum &d) const
   {
-    P_.get(d);
+    P_->get(d);
     S_.get(d);
     Archiving_Node::get_status(d);
 
@@ -365,7 +395,7 @@ namespace nest
   inline
   void iaf_cond_alpha::set_status(const DictionaryDatum &d)
   {
-    Parameters_ ptmp = P_;  // temporary copy in case of errors
+    Parameters_ ptmp = *P_;  // temporary copy in case of errors
     ptmp.set(d);                       // throws if BadProperty
     State_      stmp = S_;  // temporary copy in case of errors
     stmp.set(d, ptmp);                 // throws if BadProperty
@@ -376,8 +406,15 @@ namespace nest
     // consistent.
     Archiving_Node::set_status(d);
 
-    // if we get here, temporaries contain consistent set of properties
-    P_ = ptmp;
+    // if we get here, temporaries contain consistent set of properties;
+    // parameters shared with other nodes are copied before they change
+    if ( !(ptmp == *P_) )
+    {
+      if ( P_.references() > 1 )
+        P_ = lockPTR<Parameters_>(new Parameters_(ptmp));
+      else
+        *P_ = ptmp;
+    }
     S_ = stmp;
   }
 
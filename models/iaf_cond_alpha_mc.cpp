@@ -32,8 +32,10 @@
 #include "doubledatum.h"
 #include "dictutils.h"
 #include "numerics.h"
+#include "population_rkf45.h"
 #include "universal_data_logger_impl.h"
 #include <limits>
+#include <algorithm>
 
 #include <iomanip>
 #include <iostream>
@@ -461,21 +463,15 @@ void nest::iaf_cond_alpha_mc::init_buffers_()
   B_.step_ = Time::get_resolution().get_ms();
   B_.IntegrationStep_ = B_.step_;
 
-  static const gsl_odeiv_step_type* T1 = gsl_odeiv_step_rkf45;
-  
-  if ( B_.s_ == 0 )
-    B_.s_ = gsl_odeiv_step_alloc (T1, State_::STATE_VEC_SIZE);
-  else 
+  // the GSL solver is allocated by update() when it is first needed,
+  // neurons integrated by update_population() do without it
+  if ( B_.s_ != 0 )
     gsl_odeiv_step_reset(B_.s_);
     
-  if ( B_.c_ == 0 )  
-    B_.c_ = gsl_odeiv_control_y_new (1e-3, 0.0);
-  else
+  if ( B_.c_ != 0 )
     gsl_odeiv_control_init(B_.c_, 1e-3, 0.0, 1.0, 0.0);
     
-  if ( B_.e_ == 0 )  
-    B_.e_ = gsl_odeiv_evolve_alloc(State_::STATE_VEC_SIZE);
-  else 
+  if ( B_.e_ != 0 )
     gsl_odeiv_evolve_reset(B_.e_);
   
   B_.sys_.function  = iaf_cond_alpha_mc_dynamics; 
@@ -513,6 +509,13 @@ void nest::iaf_cond_alpha_mc::update(Time const & origin, const long_t from, con
   assert(to >= 0 && (delay) from < Scheduler::get_min_delay());
   assert(from < to);
 
+  if ( B_.s_ == 0 )
+  {
+    B_.s_ = gsl_odeiv_step_alloc(gsl_odeiv_step_rkf45, State_::STATE_VEC_SIZE);
+    B_.c_ = gsl_odeiv_control_y_new(1e-3, 0.0);
+    B_.e_ = gsl_odeiv_evolve_alloc(State_::STATE_VEC_SIZE);
+  }
+
   for ( long_t lag = from ; lag < to ; ++lag )
   {
     
@@ -581,6 +584,79 @@ void nest::iaf_cond_alpha_mc::update(Time const & origin, const long_t from, con
   }
 }
 
+void nest::iaf_cond_alpha_mc::update_population(std::vector<Node*>::const_iterator first,
+                                                std::vector<Node*>::const_iterator last,
+                                                std::vector<double_t>& buffer,
+                                                Time const & origin, const long_t from, const long_t to)
+{
+  assert(to >= 0 && (delay) from < Scheduler::get_min_delay());
+  assert(from < to);
+
+  const size_t n = last - first;
+  PopulationRKF45 solver(buffer, n, State_::STATE_VEC_SIZE, 1e-3);
+  for ( size_t i = 0 ; i < n ; ++i )
+  {
+    iaf_cond_alpha_mc& node = static_cast<iaf_cond_alpha_mc&>(*first[i]);
+    solver.set_system(i, node.S_.y_, node.B_.IntegrationStep_, &node);
+  }
+
+  const double_t step = Time::get_resolution().get_ms();
+
+  for ( long_t lag = from ; lag < to ; ++lag )
+  {
+    const int status = solver.integrate(iaf_cond_alpha_mc_dynamics, step);
+    if ( status != GSL_SUCCESS )
+      throw GSLSolverFailure(first[solver.failed()]->get_name(), status);
+
+    // the remainder of the step is done as in update()
+    for ( size_t i = 0 ; i < n ; ++i )
+    {
+      iaf_cond_alpha_mc& node = static_cast<iaf_cond_alpha_mc&>(*first[i]);
+      double_t* const y = solver.y(i);
+
+      for ( size_t c = 0 ; c < NCOMP ; ++c )
+      {
+        y[c*State_::STATE_VEC_COMPS + State_::DG_EXC]
+          += node.B_.spikes_[2*c  ].get_value(lag) * node.V_.PSConInit_E_[c];
+        y[c*State_::STATE_VEC_COMPS + State_::DG_INH]
+          += node.B_.spikes_[2*c+1].get_value(lag) * node.V_.PSConInit_I_[c];
+      }
+
+      if ( node.S_.r_ )
+      {
+        --node.S_.r_;
+        y[State_::V_M] = node.P_.V_reset;
+      }
+      else if ( y[State_::V_M] >= node.P_.V_th )
+      {
+        node.S_.r_     = node.V_.RefractoryCounts_;
+        y[State_::V_M] = node.P_.V_reset;
+
+        node.set_spiketime(Time::step(origin.get_steps()+lag+1));
+
+        SpikeEvent se;
+        network()->send(node, se, lag);
+      }
+
+      for ( size_t c = 0 ; c < NCOMP ; ++c )
+        node.B_.I_stim_[c] = node.B_.currents_[c].get_value(lag);
+
+      if ( node.B_.logger_.has_loggers() )
+      {
+        std::copy(y, y + State_::STATE_VEC_SIZE, node.S_.y_);
+        node.B_.logger_.record_data(origin.get_steps() + lag);
+      }
+    }
+  }
+
+  for ( size_t i = 0 ; i < n ; ++i )
+  {
+    iaf_cond_alpha_mc& node = static_cast<iaf_cond_alpha_mc&>(*first[i]);
+    std::copy(solver.y(i), solver.y(i) + State_::STATE_VEC_SIZE, node.S_.y_);
+    node.B_.IntegrationStep_ = solver.h(i);
+  }
+}
+
 void nest::iaf_cond_alpha_mc::handle(SpikeEvent & e)
 {
   assert(e.get_delay() > 0);
@@ -149,7 +149,20 @@ namespace nest {
     
     void get_status(DictionaryDatum &) const;
     void set_status(const DictionaryDatum &);
-    
+
+    /**
+     * Update all neurons in [first, last) at once. The state vectors
+     * are integrated together by PopulationRKF45, which uses the same
+     * scheme as the GSL solver of update(), but needs no GSL solver
+     * objects in the neurons.
+     * @see Node::update_population()
+     */
+    static
+    void update_population(std::vector<Node*>::const_iterator first,
+                           std::vector<Node*>::const_iterator last,
+                           std::vector<double_t>& buffer,
+                           Time const &, const long_t, const long_t);
+
   private:
     void init_state_(const Node& proto);
     void init_buffers_();
@@ -77,6 +77,13 @@ nest::iaf_neuron::State_::State_()
  * Parameter and state extractions and manipulation functions
  * ---------------------------------------------------------------- */
 
+bool nest::iaf_neuron::Parameters_::operator==(const Parameters_& p) const
+{
+  return C_ == p.C_ && Tau_ == p.Tau_ && tau_syn_ == p.tau_syn_
+    && TauR_ == p.TauR_ && U0_ == p.U0_ && V_reset_ == p.V_reset_
+    && Theta_ == p.Theta_ && I_e_ == p.I_e_;
+}
+
 void nest::iaf_neuron::Parameters_::get(DictionaryDatum &d) const
 {
   def<double>(d, names::E_L, U0_);   // Resting potential
@@ -156,7 +163,7 @@ nest::iaf_neuron::Buffers_::Buffers_(const Buffers_ &, iaf_neuron &n)
 
 nest::iaf_neuron::iaf_neuron()
   : Archiving_Node(), 
-    P_(), 
+    P_(new Parameters_()), 
     S_(),
     B_(*this)
 {
@@ -195,16 +202,16 @@ void nest::iaf_neuron::calibrate()
   const double h = Time::get_resolution().get_ms(); 
 
   // these P are independent
-  V_.P11_ = V_.P22_ = std::exp(-h/P_.tau_syn_);
-  V_.P33_ = std::exp(-h/P_.Tau_);
+  V_.P11_ = V_.P22_ = std::exp(-h/P_->tau_syn_);
+  V_.P33_ = std::exp(-h/P_->Tau_);
   V_.P21_ = h * V_.P11_;
   
   // these depend on the above. Please do not change the order.
-  V_.P30_ = 1/P_.C_*(1-V_.P33_)*P_.Tau_;
-  V_.P31_ = 1/P_.C_ * ((V_.P11_-V_.P33_)/(-1/P_.tau_syn_- -1/P_.Tau_)- h*V_.P11_)
-    /(-1/P_.Tau_ - -1/P_.tau_syn_);
-  V_.P32_ = 1/P_.C_*(V_.P33_-V_.P11_)/(-1/P_.Tau_ - -1/P_.tau_syn_);
-  V_.PSCInitialValue_=1.0 * numerics::e/P_.tau_syn_;
+  V_.P30_ = 1/P_->C_*(1-V_.P33_)*P_->Tau_;
+  V_.P31_ = 1/P_->C_ * ((V_.P11_-V_.P33_)/(-1/P_->tau_syn_- -1/P_->Tau_)- h*V_.P11_)
+    /(-1/P_->Tau_ - -1/P_->tau_syn_);
+  V_.P32_ = 1/P_->C_*(V_.P33_-V_.P11_)/(-1/P_->Tau_ - -1/P_->tau_syn_);
+  V_.PSCInitialValue_=1.0 * numerics::e/P_->tau_syn_;
 
 
   // TauR specifies the length of the absolute refractory period as 
@@ -227,7 +234,7 @@ void nest::iaf_neuron::calibrate()
   // results. However, a neuron model capable of operating with real valued spike
   // time may exhibit a different effective refractory time.
 
-  V_.RefractoryCounts_ = Time(Time::ms(P_.TauR_)).get_steps();
+  V_.RefractoryCounts_ = Time(Time::ms(P_->TauR_)).get_steps();
   assert(V_.RefractoryCounts_ >= 0);  // since t_ref_ >= 0, this can only fail in error
 }
 
@@ -245,7 +252,7 @@ void nest::iaf_neuron::update(Time const & origin, const long_t from, const long
       if ( S_.r_ == 0 )
 	{
 	  // neuron not refractory
-	  S_.y3_ = V_.P30_*(S_.y0_ + P_.I_e_) + V_.P31_*S_.y1_ + V_.P32_*S_.y2_ + V_.P33_*S_.y3_;
+	  S_.y3_ = V_.P30_*(S_.y0_ + P_->I_e_) + V_.P31_*S_.y1_ + V_.P32_*S_.y2_ + V_.P33_*S_.y3_;
 	}
       else // neuron is absolute refractory
 	--S_.r_;
@@ -259,10 +266,10 @@ void nest::iaf_neuron::update(Time const & origin, const long_t from, const long
       S_.y1_ += V_.PSCInitialValue_* B_.spikes_.get_value(lag);   
     
       // threshold crossing
-      if (S_.y3_ >= P_.Theta_)
+      if (S_.y3_ >= P_->Theta_)
 	{
 	  S_.r_ = V_.RefractoryCounts_;
-	  S_.y3_= P_.V_reset_; 
+	  S_.y3_= P_->V_reset_; 
       
 	  // A supra-threshold membrane potential should never be observable.
 	  // The reset at the time of threshold crossing enables accurate integration
@@ -29,6 +29,7 @@
 #include "ring_buffer.h"
 #include "connection.h"
 #include "universal_data_logger.h"
+#include "lockptr.h"
 
 namespace nest
 {
@@ -152,6 +153,12 @@ SeeAlso: iaf_psc_alpha, testsuite::test_iaf
     void get_status(DictionaryDatum &) const;
     void set_status(const DictionaryDatum &);
 
+    const void* get_shared_parameters(size_t& size) const
+    {
+      size = sizeof(Parameters_);
+      return &(*P_);
+    }
+
   private:
 
     void init_state_(const Node& proto);
@@ -198,6 +205,8 @@ SeeAlso: iaf_psc_alpha, testsuite::test_iaf
 
       Parameters_();  //!< Sets default parameter values
 
+      bool operator==(const Parameters_&) const;
+
       void get(DictionaryDatum&) const;  //!< Store current values in dictionary
 
       /** Set values from dictionary.
@@ -273,7 +282,7 @@ SeeAlso: iaf_psc_alpha, testsuite::test_iaf
     // Access functions for UniversalDataLogger -------------------------------
 
     //! Read out the real membrane potential
-    double_t get_V_m_() const { return S_.y3_ + P_.U0_; }
+    double_t get_V_m_() const { return S_.y3_ + P_->U0_; }
 
    // ---------------------------------------------------------------- 
 
@@ -284,9 +293,15 @@ SeeAlso: iaf_psc_alpha, testsuite::test_iaf
     * @note The order of definitions is crucial: Moving Variables_
     *       to the very end increases simulation time for brunel-2.sli
     *       from 72s to 81s on a Mac, Intel Core 2 Duo 2.2GHz, g++ 4.0.1 -O3
+    * @note The parameters are shared by all nodes with the same parameter
+    *       values. Nodes created from the prototype share its parameters,
+    *       set_status() gives a node its own copy as soon as one of its
+    *       parameters differs. Reference counts are not thread-safe, so
+    *       nodes must only be created and configured outside of parallel
+    *       regions.
     * @{
     */   
-   Parameters_ P_;
+   lockPTR<Parameters_> P_;
    State_      S_;
    Variables_  V_;
    Buffers_    B_;
@@ -335,8 +350,8 @@ port iaf_neuron::connect_sender(DataLoggingRequest &dlr,
 inline
 void iaf_neuron::get_status(DictionaryDatum &d) const
 {
-  P_.get(d);
-  S_.get(d, P_);
+  P_->get(d);
+  S_.get(d, *P_);
   Archiving_Node::get_status(d);
   (*d)[names::recordables] = recordablesMap_.get_list();
 }
@@ -344,7 +359,7 @@ void iaf_neuron::get_status(DictionaryDatum &d) const
 inline
 void iaf_neuron::set_status(const DictionaryDatum &d)
 {
-  Parameters_ ptmp = P_;  // temporary copy in case of errors
+  Parameters_ ptmp = *P_;  // temporary copy in case of errors
   const double delta_EL = ptmp.set(d); // throws if BadProperty
   State_      stmp = S_;  // temporary copy in case of errors
   stmp.set(d, ptmp, delta_EL);         // throws if BadProperty
@@ -355,8 +370,15 @@ void iaf_neuron::set_status(const DictionaryDatum &d)
   // consistent.
   Archiving_Node::set_status(d);
 
-  // if we get here, temporaries contain consistent set of properties
-  P_ = ptmp;
+  // if we get here, temporaries contain consistent set of properties;
+  // parameters shared with other nodes are copied before they change
+  if ( !(ptmp == *P_) )
+  {
+    if ( P_.references() > 1 )
+      P_ = lockPTR<Parameters_>(new Parameters_(ptmp));
+    else
+      *P_ = ptmp;
+  }
   S_ = stmp;
 }
 
@@ -327,6 +327,164 @@ namespace nest
     }
   }
 
+  void iaf_psc_alpha::update_population(std::vector<Node*>::const_iterator first,
+                                        std::vector<Node*>::const_iterator last,
+                                        std::vector<double_t>& buffer,
+                                        Time const & origin, const long_t from, const long_t to)
+  {
+    assert(to >= 0 && (delay) from < Scheduler::get_min_delay());
+    assert(from < to);
+
+    const size_t n = last - first;
+
+    // one array of length n for each quantity, the refractory counts
+    // are stored as double_t to keep the loops free of conversions
+    enum { Y0, Y1_EX, Y2_EX, Y1_IN, Y2_IN, Y3, R, W_EX, W_IN, SPIKE,
+           I_E, THETA, V_RESET, LOWER_BOUND, REF_COUNTS, EPSC, IPSC,
+           PROP_11_EX, PROP_21_EX, PROP_22_EX, PROP_31_EX, PROP_32_EX,
+           PROP_11_IN, PROP_21_IN, PROP_22_IN, PROP_31_IN, PROP_32_IN, PROP_30, EXPM1_TAU_M,
+           N_ARRAYS };
+    buffer.resize(N_ARRAYS * n);
+
+    double_t* const y0     = &buffer[Y0 * n];
+    double_t* const y1_ex  = &buffer[Y1_EX * n];
+    double_t* const y2_ex  = &buffer[Y2_EX * n];
+    double_t* const y1_in  = &buffer[Y1_IN * n];
+    double_t* const y2_in  = &buffer[Y2_IN * n];
+    double_t* const y3     = &buffer[Y3 * n];
+    double_t* const r      = &buffer[R * n];
+    double_t* const w_ex   = &buffer[W_EX * n];
+    double_t* const w_in   = &buffer[W_IN * n];
+    double_t* const spike  = &buffer[SPIKE * n];
+    double_t* const I_e    = &buffer[I_E * n];
+    double_t* const theta  = &buffer[THETA * n];
+    double_t* const V_reset     = &buffer[V_RESET * n];
+    double_t* const lower_bound = &buffer[LOWER_BOUND * n];
+    double_t* const ref_counts  = &buffer[REF_COUNTS * n];
+    double_t* const epsc   = &buffer[EPSC * n];
+    double_t* const ipsc   = &buffer[IPSC * n];
+    double_t* const P11_ex = &buffer[PROP_11_EX * n];
+    double_t* const P21_ex = &buffer[PROP_21_EX * n];
+    double_t* const P22_ex = &buffer[PROP_22_EX * n];
+    double_t* const P31_ex = &buffer[PROP_31_EX * n];
+    double_t* const P32_ex = &buffer[PROP_32_EX * n];
+    double_t* const P11_in = &buffer[PROP_11_IN * n];
+    double_t* const P21_in = &buffer[PROP_21_IN * n];
+    double_t* const P22_in = &buffer[PROP_22_IN * n];
+    double_t* const P31_in = &buffer[PROP_31_IN * n];
+    double_t* const P32_in = &buffer[PROP_32_IN * n];
+    double_t* const P30    = &buffer[PROP_30 * n];
+    double_t* const expm1_tau_m = &buffer[EXPM1_TAU_M * n];
+
+    std::vector<size_t> logged;
+    for ( size_t i = 0 ; i < n ; ++i )
+    {
+      const iaf_psc_alpha& node = static_cast<const iaf_psc_alpha&>(*first[i]);
+      y0[i]    = node.S_.y0_;
+      y1_ex[i] = node.S_.y1_ex_;
+      y2_ex[i] = node.S_.y2_ex_;
+      y1_in[i] = node.S_.y1_in_;
+      y2_in[i] = node.S_.y2_in_;
+      y3[i]    = node.S_.y3_;
+      r[i]     = node.S_.r_;
+      I_e[i]   = node.P_.I_e_;
+      theta[i] = node.P_.Theta_;
+      V_reset[i]     = node.P_.V_reset_;
+      lower_bound[i] = node.P_.LowerBound_;
+      ref_counts[i]  = node.V_.RefractoryCounts_;
+      epsc[i]   = node.V_.EPSCInitialValue_;
+      ipsc[i]   = node.V_.IPSCInitialValue_;
+      P11_ex[i] = node.V_.P11_ex_;
+      P21_ex[i] = node.V_.P21_ex_;
+      P22_ex[i] = node.V_.P22_ex_;
+      P31_ex[i] = node.V_.P31_ex_;
+      P32_ex[i] = node.V_.P32_ex_;
+      P11_in[i] = node.V_.P11_in_;
+      P21_in[i] = node.V_.P21_in_;
+      P22_in[i] = node.V_.P22_in_;
+      P31_in[i] = node.V_.P31_in_;
+      P32_in[i] = node.V_.P32_in_;
+      P30[i]    = node.V_.P30_;
+      expm1_tau_m[i] = node.V_.expm1_tau_m_;
+
+      if ( node.B_.logger_.has_loggers() )
+        logged.push_back(i);
+    }
+
+    for ( long_t lag = from ; lag < to ; ++lag )
+    {
+      for ( size_t i = 0 ; i < n ; ++i )
+      {
+        iaf_psc_alpha& node = static_cast<iaf_psc_alpha&>(*first[i]);
+        w_ex[i] = node.B_.ex_spikes_.get_value(lag);
+        w_in[i] = node.B_.in_spikes_.get_value(lag);
+      }
+
+      // same operations as in update(), with branches replaced by selections
+      for ( size_t i = 0 ; i < n ; ++i )
+      {
+        const bool not_refractory = r[i] == 0.0;
+        double_t v = P30[i]*(y0[i] + I_e[i])
+                     + P31_ex[i] * y1_ex[i] + P32_ex[i] * y2_ex[i]
+                     + P31_in[i] * y1_in[i] + P32_in[i] * y2_in[i]
+                     + expm1_tau_m[i] * y3[i] + y3[i];
+        v = ( v < lower_bound[i] ? lower_bound[i] : v );
+        y3[i] = not_refractory ? v : y3[i];
+        r[i]  = not_refractory ? r[i] : r[i] - 1.0;
+
+        y2_ex[i]  = P21_ex[i] * y1_ex[i] + P22_ex[i] * y2_ex[i];
+        y1_ex[i] *= P11_ex[i];
+        y1_ex[i] += epsc[i] * w_ex[i];
+
+        y2_in[i]  = P21_in[i] * y1_in[i] + P22_in[i] * y2_in[i];
+        y1_in[i] *= P11_in[i];
+        y1_in[i] += ipsc[i] * w_in[i];
+
+        const bool crossed = y3[i] >= theta[i];
+        r[i]     = crossed ? ref_counts[i] : r[i];
+        y3[i]    = crossed ? V_reset[i] : y3[i];
+        spike[i] = crossed ? 1.0 : 0.0;
+      }
+
+      for ( size_t i = 0 ; i < n ; ++i )
+      {
+        iaf_psc_alpha& node = static_cast<iaf_psc_alpha&>(*first[i]);
+        if ( spike[i] != 0.0 )
+        {
+          node.set_spiketime(Time::step(origin.get_steps()+lag+1));
+          SpikeEvent se;
+          network()->send(node, se, lag);
+        }
+
+        y0[i] = node.B_.currents_.get_value(lag);
+      }
+
+      for ( size_t k = 0 ; k < logged.size() ; ++k )
+      {
+        const size_t i = logged[k];
+        iaf_psc_alpha& node = static_cast<iaf_psc_alpha&>(*first[i]);
+        node.S_.y3_ = y3[i];
+        node.V_.weighted_spikes_ex_ = w_ex[i];
+        node.V_.weighted_spikes_in_ = w_in[i];
+        node.B_.logger_.record_data(origin.get_steps() + lag);
+      }
+    }
+
+    for ( size_t i = 0 ; i < n ; ++i )
+    {
+      iaf_psc_alpha& node = static_cast<iaf_psc_alpha&>(*first[i]);
+      node.S_.y0_    = y0[i];
+      node.S_.y1_ex_ = y1_ex[i];
+      node.S_.y2_ex_ = y2_ex[i];
+      node.S_.y1_in_ = y1_in[i];
+      node.S_.y2_in_ = y2_in[i];
+      node.S_.y3_    = y3[i];
+      node.S_.r_     = static_cast<int_t>(r[i]);
+      node.V_.weighted_spikes_ex_ = w_ex[i];
+      node.V_.weighted_spikes_in_ = w_in[i];
+    }
+  }
+
   void iaf_psc_alpha::handle(SpikeEvent& e)
   {
     assert(e.get_delay() > 0);
@@ -293,6 +293,123 @@ void nest::iaf_psc_delta::update(Time const & origin,
   }  
 }                           
                      
+void nest::iaf_psc_delta::update_population(std::vector<Node*>::const_iterator first,
+                                            std::vector<Node*>::const_iterator last,
+                                            std::vector<double_t>& buffer,
+                                            Time const & origin, const long_t from, const long_t to)
+{
+  assert(to >= 0 && (delay) from < Scheduler::get_min_delay());
+  assert(from < to);
+
+  const size_t n = last - first;
+  const double_t h = Time::get_resolution().get_ms();
+
+  // one array of length n for each quantity, the refractory counts
+  // and the refractory_input flags are stored as double_t to keep the
+  // loops free of conversions
+  enum { Y0, Y3, R, REFR_SPIKES, W, SPIKE,
+         I_E, V_TH, V_MIN, V_RESET, REF_COUNTS, WITH_REFR_INPUT, PROP_30, PROP_33,
+         N_ARRAYS };
+  buffer.resize(N_ARRAYS * n);
+
+  double_t* const y0          = &buffer[Y0 * n];
+  double_t* const y3          = &buffer[Y3 * n];
+  double_t* const r           = &buffer[R * n];
+  double_t* const refr_spikes = &buffer[REFR_SPIKES * n];
+  double_t* const w           = &buffer[W * n];
+  double_t* const spike       = &buffer[SPIKE * n];
+  double_t* const I_e         = &buffer[I_E * n];
+  double_t* const V_th        = &buffer[V_TH * n];
+  double_t* const V_min       = &buffer[V_MIN * n];
+  double_t* const V_reset     = &buffer[V_RESET * n];
+  double_t* const ref_counts  = &buffer[REF_COUNTS * n];
+  double_t* const with_refr_input = &buffer[WITH_REFR_INPUT * n];
+  double_t* const P30         = &buffer[PROP_30 * n];
+  double_t* const P33         = &buffer[PROP_33 * n];
+
+  std::vector<size_t> logged;
+  for ( size_t i = 0 ; i < n ; ++i )
+  {
+    const iaf_psc_delta& node = static_cast<const iaf_psc_delta&>(*first[i]);
+    y0[i]          = node.S_.y0_;
+    y3[i]          = node.S_.y3_;
+    r[i]           = node.S_.r_;
+    refr_spikes[i] = node.S_.refr_spikes_buffer_;
+    I_e[i]         = node.P_.I_e_;
+    V_th[i]        = node.P_.V_th_;
+    V_min[i]       = node.P_.V_min_;
+    V_reset[i]     = node.P_.V_reset_;
+    ref_counts[i]  = node.V_.RefractoryCounts_;
+    with_refr_input[i] = node.P_.with_refr_input_ ? 1.0 : 0.0;
+    P30[i]         = node.V_.P30_;
+    P33[i]         = node.V_.P33_;
+
+    if ( node.B_.logger_.has_loggers() )
+      logged.push_back(i);
+  }
+
+  for ( long_t lag = from ; lag < to ; ++lag )
+  {
+    // spikes arriving during the refractory period are accumulated here,
+    // since the discount factor is only needed for refractory neurons
+    for ( size_t i = 0 ; i < n ; ++i )
+    {
+      iaf_psc_delta& node = static_cast<iaf_psc_delta&>(*first[i]);
+      w[i] = node.B_.spikes_.get_value(lag);
+      if ( r[i] != 0.0 && with_refr_input[i] != 0.0 )
+        refr_spikes[i] += w[i] * std::exp(-r[i] * h / node.P_.tau_m_);
+    }
+
+    // same operations as in update(), with branches replaced by selections
+    for ( size_t i = 0 ; i < n ; ++i )
+    {
+      const bool not_refractory = r[i] == 0.0;
+      const bool add_refr_spikes = with_refr_input[i] != 0.0 && refr_spikes[i] != 0.0;
+      double_t v = P30[i]*(y0[i] + I_e[i]) + P33[i]*y3[i] + w[i];
+      v = add_refr_spikes ? v + refr_spikes[i] : v;
+      v = ( v < V_min[i] ? V_min[i] : v );
+      y3[i] = not_refractory ? v : y3[i];
+      refr_spikes[i] = not_refractory && add_refr_spikes ? 0.0 : refr_spikes[i];
+      r[i]  = not_refractory ? r[i] : r[i] - 1.0;
+
+      const bool crossed = y3[i] >= V_th[i];
+      r[i]     = crossed ? ref_counts[i] : r[i];
+      y3[i]    = crossed ? V_reset[i] : y3[i];
+      spike[i] = crossed ? 1.0 : 0.0;
+    }
+
+    for ( size_t i = 0 ; i < n ; ++i )
+    {
+      iaf_psc_delta& node = static_cast<iaf_psc_delta&>(*first[i]);
+      if ( spike[i] != 0.0 )
+      {
+        node.set_spiketime(Time::step(origin.get_steps()+lag+1));
+        SpikeEvent se;
+        network()->send(node, se, lag);
+      }
+
+      y0[i] = node.B_.currents_.get_value(lag);
+    }
+
+    for ( size_t k = 0 ; k < logged.size() ; ++k )
+    {
+      const size_t i = logged[k];
+      iaf_psc_delta& node = static_cast<iaf_psc_delta&>(*first[i]);
+      node.S_.y3_ = y3[i];
+      node.B_.logger_.record_data(origin.get_steps()+lag);
+    }
+  }
+
+  for ( size_t i = 0 ; i < n ; ++i )
+  {
+    iaf_psc_delta& node = static_cast<iaf_psc_delta&>(*first[i]);
+    node.S_.y0_ = y0[i];
+    node.S_.y3_ = y3[i];
+    node.S_.r_  = static_cast<int_t>(r[i]);
+    node.S_.refr_spikes_buffer_ = refr_spikes[i];
+  }
+}
+
 void nest::iaf_psc_delta::handle(SpikeEvent & e)
 {
   assert(e.get_delay() > 0);
@@ -296,6 +296,132 @@ void nest::iaf_psc_exp::update(const Time &origin, const long_t from, const long
   }  
 }                           
                      
+void nest::iaf_psc_exp::update_population(std::vector<Node*>::const_iterator first,
+                                          std::vector<Node*>::const_iterator last,
+                                          std::vector<double_t>& buffer,
+                                          const Time &origin, const long_t from, const long_t to)
+{
+  assert(to >= 0 && (delay) from < Scheduler::get_min_delay());
+  assert(from < to);
+
+  const size_t n = last - first;
+
+  // one array of length n for each quantity, the refractory counts
+  // are stored as double_t to keep the loops free of conversions
+  enum { I_0, I_SYN_EX, I_SYN_IN, V_M, R_REF, W_EX, W_IN, SPIKE,
+         I_E, THETA, V_RESET, REF_COUNTS, PROP_20, PROP_11EX, PROP_11IN, PROP_21EX, PROP_21IN, PROP_22,
+         N_ARRAYS };
+  buffer.resize(N_ARRAYS * n);
+
+  double_t* const i_0      = &buffer[I_0 * n];
+  double_t* const i_syn_ex = &buffer[I_SYN_EX * n];
+  double_t* const i_syn_in = &buffer[I_SYN_IN * n];
+  double_t* const V_m      = &buffer[V_M * n];
+  double_t* const r_ref    = &buffer[R_REF * n];
+  double_t* const w_ex     = &buffer[W_EX * n];
+  double_t* const w_in     = &buffer[W_IN * n];
+  double_t* const spike    = &buffer[SPIKE * n];
+  double_t* const I_e      = &buffer[I_E * n];
+  double_t* const theta    = &buffer[THETA * n];
+  double_t* const V_reset  = &buffer[V_RESET * n];
+  double_t* const ref_counts = &buffer[REF_COUNTS * n];
+  double_t* const P20   = &buffer[PROP_20 * n];
+  double_t* const P11ex = &buffer[PROP_11EX * n];
+  double_t* const P11in = &buffer[PROP_11IN * n];
+  double_t* const P21ex = &buffer[PROP_21EX * n];
+  double_t* const P21in = &buffer[PROP_21IN * n];
+  double_t* const P22   = &buffer[PROP_22 * n];
+
+  std::vector<size_t> logged;
+  for ( size_t i = 0 ; i < n ; ++i )
+  {
+    const iaf_psc_exp& node = static_cast<const iaf_psc_exp&>(*first[i]);
+    i_0[i]      = node.S_.i_0_;
+    i_syn_ex[i] = node.S_.i_syn_ex_;
+    i_syn_in[i] = node.S_.i_syn_in_;
+    V_m[i]      = node.S_.V_m_;
+    r_ref[i]    = node.S_.r_ref_;
+    I_e[i]      = node.P_.I_e_;
+    theta[i]    = node.P_.Theta_;
+    V_reset[i]  = node.P_.V_reset_;
+    ref_counts[i] = node.V_.RefractoryCounts_;
+    P20[i]   = node.V_.P20_;
+    P11ex[i] = node.V_.P11ex_;
+    P11in[i] = node.V_.P11in_;
+    P21ex[i] = node.V_.P21ex_;
+    P21in[i] = node.V_.P21in_;
+    P22[i]   = node.V_.P22_;
+
+    if ( node.B_.logger_.has_loggers() )
+      logged.push_back(i);
+  }
+
+  for ( long_t lag = from; lag < to; ++lag )
+  {
+    for ( size_t i = 0 ; i < n ; ++i )
+    {
+      iaf_psc_exp& node = static_cast<iaf_psc_exp&>(*first[i]);
+      w_ex[i] = node.B_.spikes_ex_.get_value(lag);
+      w_in[i] = node.B_.spikes_in_.get_value(lag);
+    }
+
+    // same operations as in update(), with branches replaced by selections
+    for ( size_t i = 0 ; i < n ; ++i )
+    {
+      const bool not_refractory = r_ref[i] == 0.0;
+      const double_t v = V_m[i]*P22[i] + i_syn_ex[i]*P21ex[i] + i_syn_in[i]*P21in[i] + (I_e[i]+i_0[i])*P20[i];
+      V_m[i]   = not_refractory ? v : V_m[i];
+      r_ref[i] = not_refractory ? r_ref[i] : r_ref[i] - 1.0;
+
+      i_syn_ex[i] *= P11ex[i];
+      i_syn_in[i] *= P11in[i];
+
+      i_syn_ex[i] += w_ex[i];
+      i_syn_in[i] += w_in[i];
+
+      const bool crossed = V_m[i] >= theta[i];
+      r_ref[i] = crossed ? ref_counts[i] : r_ref[i];
+      V_m[i]   = crossed ? V_reset[i] : V_m[i];
+      spike[i] = crossed ? 1.0 : 0.0;
+    }
+
+    for ( size_t i = 0 ; i < n ; ++i )
+    {
+      iaf_psc_exp& node = static_cast<iaf_psc_exp&>(*first[i]);
+      if ( spike[i] != 0.0 )
+      {
+        node.set_spiketime(Time::step(origin.get_steps()+lag+1));
+        SpikeEvent se;
+        network()->send(node, se, lag);
+      }
+
+      i_0[i] = node.B_.currents_.get_value(lag);
+    }
+
+    for ( size_t k = 0 ; k < logged.size() ; ++k )
+    {
+      const size_t i = logged[k];
+      iaf_psc_exp& node = static_cast<iaf_psc_exp&>(*first[i]);
+      node.S_.V_m_ = V_m[i];
+      node.V_.weighted_spikes_ex_ = w_ex[i];
+      node.V_.weighted_spikes_in_ = w_in[i];
+      node.B_.logger_.record_data(origin.get_steps() + lag);
+    }
+  }
+
+  for ( size_t i = 0 ; i < n ; ++i )
+  {
+    iaf_psc_exp& node = static_cast<iaf_psc_exp&>(*first[i]);
+    node.S_.i_0_      = i_0[i];
+    node.S_.i_syn_ex_ = i_syn_ex[i];
+    node.S_.i_syn_in_ = i_syn_in[i];
+    node.S_.V_m_      = V_m[i];
+    node.S_.r_ref_    = static_cast<int_t>(r_ref[i]);
+    node.V_.weighted_spikes_ex_ = w_ex[i];
+    node.V_.weighted_spikes_in_ = w_in[i];
+  }
+}
+
 void nest::iaf_psc_exp::handle(SpikeEvent &e)
 {
   assert ( e.get_delay() > 0 );
@@ -150,6 +150,19 @@ namespace nest
     void get_status(DictionaryDatum &) const;
     void set_status(const DictionaryDatum &);
 
+    /**
+     * Update all neurons in [first, last) at once. State and parameters
+     * are gathered into arrays in buffer, so that the compiler can
+     * vectorize the loops over the neurons. The results are identical
+     * to those of update().
+     * @see Node::update_population()
+     */
+    static
+    void update_population(std::vector<Node*>::const_iterator first,
+                           std::vector<Node*>::const_iterator last,
+                           std::vector<double_t>& buffer,
+                           const Time &, const long_t, const long_t);
+
   private:
 
     void init_state_(const Node& proto);
@@ -110,6 +110,10 @@ void nest::mip_generator::init_state_(const Node& proto)
 void nest::mip_generator::init_buffers_()
 { 
   device_.init_buffers();
+
+  B_.n_spikes_.clear();
+  B_.next_ = 0;
+  B_.n_targets_ = -1;
 }
 
 void nest::mip_generator::calibrate()
@@ -118,6 +122,11 @@ void nest::mip_generator::calibrate()
 
   // rate_ is in Hz, dt in ms, so we have to convert from s to ms
   V_.poisson_dev_.set_lambda(Time::get_resolution().get_ms() * P_.rate_ * 1e-3);
+
+  // connections may have changed since the last simulation
+  B_.n_spikes_.clear();
+  B_.next_ = 0;
+  B_.n_targets_ = -1;
 }
 
 
@@ -130,22 +139,58 @@ void nest::mip_generator::update(Time const & T, const long_t from, const long_t
   assert(to >= 0 && (delay) from < Scheduler::get_min_delay());
   assert(from < to);
 
+  if ( !device_.is_active(T) || P_.rate_ <= 0 )
+    return; // no spikes to be generated
+
+  librandom::RngPtr rng = net_->get_rng(get_thread());
+
   for ( long_t lag = from ; lag < to ; ++lag )
   {
-    if ( !device_.is_active(T) || P_.rate_ <= 0 )
-      return; // no spikes to be generated
-    
     // generate spikes of mother process for each time slice
     ulong_t n_mother_spikes = V_.poisson_dev_.uldev(P_.rng_);
 
-    if ( n_mother_spikes )
-    {
-      DSSpikeEvent se;
+    if ( n_mother_spikes == 0 )
+      continue;
+
+    DSSpikeEvent se;
+    se.set_multiplicity(n_mother_spikes);
 
-      se.set_multiplicity(n_mother_spikes);
+    if ( B_.n_targets_ < 0 )
+    {
+      // the hook copies for each target and counts the targets
       network()->send(*this, se, lag);
+      B_.n_targets_ = B_.next_;
+      B_.next_ = 0;
+      continue;
+    }
+
+    // copy the mother spikes for all targets, in the order of the hooks
+    B_.n_spikes_.resize(B_.n_targets_);
+    B_.next_ = 0;
+    bool has_spikes = false;
+    for ( size_t i = 0 ; i < B_.n_spikes_.size() ; ++i )
+    {
+      B_.n_spikes_[i] = copy_spikes_(n_mother_spikes, rng);
+      has_spikes = has_spikes || B_.n_spikes_[i] > 0;
     }
+
+    if ( has_spikes )
+      network()->send(*this, se, lag);
+  }
+}
+
+nest::ulong_t nest::mip_generator::copy_spikes_(ulong_t n_mother_spikes,
+                                                librandom::RngPtr& rng) const
+{
+  ulong_t n_spikes = 0;
+
+  for (ulong_t n = 0; n < n_mother_spikes; n++)
+  {
+    if ( rng->drand() < P_.p_copy_ )
+      n_spikes++;
   }
+
+  return n_spikes;
 }
 
 void nest::mip_generator::event_hook(DSSpikeEvent& e)
@@ -160,14 +205,17 @@ void nest::mip_generator::event_hook(DSSpikeEvent& e)
   // store the number of mother spikes again during the next call of event_hook().
   // reichert
 
-  librandom::RngPtr rng = net_->get_rng(get_thread());
   ulong_t n_mother_spikes = e.get_multiplicity();
-  ulong_t n_spikes = 0;
+  ulong_t n_spikes;
 
-  for (ulong_t n = 0; n < n_mother_spikes; n++)
+  if ( B_.next_ < B_.n_spikes_.size() )
+    n_spikes = B_.n_spikes_[B_.next_++];
+  else
   {
-    if ( rng->drand() < P_.p_copy_ )
-      n_spikes++;
+    // targets not counted yet
+    librandom::RngPtr rng = net_->get_rng(get_thread());
+    n_spikes = copy_spikes_(n_mother_spikes, rng);
+    ++B_.next_;
   }
 
   if (n_spikes > 0)
@@ -129,6 +129,10 @@ SeeAlso: Device
     void init_buffers_();
     void calibrate();
 
+    /**
+     * Draw the mother spikes and copy them into the child processes of
+     * all targets, as event_hook() would do target by target.
+     */
     void update(Time const &, const long_t, const long_t);
     
     /**
@@ -136,6 +140,11 @@ SeeAlso: Device
      */
     void event_hook(DSSpikeEvent&);
 
+    /**
+     * Number of spikes of a child process, given the number of mother spikes.
+     */
+    ulong_t copy_spikes_(ulong_t, librandom::RngPtr&) const;
+
     // ------------------------------------------------------------
     
     /**
@@ -160,6 +169,20 @@ SeeAlso: Device
         
     // ------------------------------------------------------------
 
+    struct Buffers_ {
+      std::vector<ulong_t> n_spikes_; //!< numbers of copied spikes, one per target
+      size_t next_;                   //!< next element of n_spikes_ to hand out
+
+      /**
+       * Number of targets on the thread of the generator. It is counted
+       * during the first step with mother spikes after calibration, -1
+       * until then.
+       */
+      long_t n_targets_;
+    };
+
+    // ------------------------------------------------------------
+
     struct Variables_ {
       librandom::PoissonRandomDev poisson_dev_;  //!< random deviate generator
     };
@@ -169,6 +192,7 @@ SeeAlso: Device
     StimulatingDevice<SpikeEvent> device_;
     Parameters_ P_;
     Variables_  V_;
+    Buffers_    B_;
     
   };
 
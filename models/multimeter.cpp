@@ -24,6 +24,12 @@
 
 namespace nest
 {
+  // in the order of DataLoggingRequest::Reduction
+  const char* const Multimeter::Parameters_::reduction_names_[] =
+    { "none", "decimate", "min", "max", "mean" };
+
+  const size_t Multimeter::Parameters_::n_reductions_ = 5;
+
   Multimeter::Multimeter()
     : Node(),
       device_(*this, RecordingDevice::MULTIMETER, "dat", true, true),
@@ -44,7 +50,8 @@ namespace nest
 
   port Multimeter::check_connection(Connection& c, port receptor_type)  
   { 
-    DataLoggingRequest e(P_.interval_, P_.record_from_);
+    DataLoggingRequest e(P_.interval_, P_.record_from_,
+                         P_.reduction_, P_.reduction_window_);
     e.set_sender(*this);
     c.check_event(e);
     port p = c.get_target()->connect_sender(e, receptor_type);
@@ -55,14 +62,21 @@ namespace nest
   
   nest::Multimeter::Parameters_::Parameters_()
     : interval_(Time::ms(1.0)),
-      record_from_()
+      record_from_(),
+      reduction_(DataLoggingRequest::NO_REDUCTION),
+      reduction_window_(Time::ms(1.0)),
+      population_mean_(false)
   {}
   
   nest::Multimeter::Parameters_::Parameters_(const Parameters_& p)
     : interval_(p.interval_),
-      record_from_(p.record_from_)
+      record_from_(p.record_from_),
+      reduction_(p.reduction_),
+      reduction_window_(p.reduction_window_),
+      population_mean_(p.population_mean_)
   {
     interval_.calibrate();
+    reduction_window_.calibrate();
   }
 
   nest::Multimeter::Buffers_::Buffers_()
@@ -77,14 +91,19 @@ namespace nest
     for ( size_t j = 0 ; j < record_from_.size() ; ++j )
       ad.push_back(LiteralDatum(record_from_[j]));
     (*d)[names::record_from] = ad;
+
+    (*d)[names::reduction] = LiteralDatum(reduction_names_[reduction_]);
+    (*d)[names::reduction_window] = reduction_window_.get_ms();
+    (*d)[names::population_mean] = population_mean_;
   }  
 
   void nest::Multimeter::Parameters_::set(const DictionaryDatum &d, const Buffers_& b)
   {
-    if ( b.has_targets_ && ( d->known(names::interval) || d->known(names::record_from) ) )
-      throw BadProperty("The recording interval and the list of properties to record "
-			"cannot be changed after the multimeter has been connected to "
-			"nodes.");
+    if ( b.has_targets_ && ( d->known(names::interval) || d->known(names::record_from)
+                             || d->known(names::reduction) || d->known(names::reduction_window) ) )
+      throw BadProperty("The recording interval, the list of properties to record "
+			"and the reduction cannot be changed after the multimeter has "
+			"been connected to nodes.");
 
     double_t v;
     if ( updateValue<double_t>(d, names::interval, v) )
@@ -101,6 +120,35 @@ namespace nest
 			    "the simulation resolution"); 
       }
 
+    if ( updateValue<double_t>(d, names::reduction_window, v) )
+      {      
+	reduction_window_ = Time::step(Time(Time::ms(v)).get_steps());
+	if ( reduction_window_.get_steps() < 1
+	     || std::abs(1 - reduction_window_.get_ms() / v) 
+	        > 10 * std::numeric_limits<double>::epsilon() )
+	  throw BadProperty("The reduction window must be a multiple of "
+			    "the simulation resolution"); 
+      }
+
+    std::string red;
+    if ( updateValue<std::string>(d, names::reduction, red) )
+      {
+	size_t r = 0;
+	while ( r < n_reductions_ && red != reduction_names_[r] )
+	  ++r;
+	if ( r == n_reductions_ )
+	  throw BadProperty("/reduction must be one of none, decimate, min, max, mean.");
+	reduction_ = static_cast<DataLoggingRequest::Reduction>(r);
+      }
+
+    if ( reduction_ != DataLoggingRequest::NO_REDUCTION
+	 && ( reduction_window_ < interval_
+	      || reduction_window_.get_steps() % interval_.get_steps() != 0 ) )
+      throw BadProperty("The reduction window must be a multiple of "
+			"the recording interval.");
+
+    updateValue<bool>(d, names::population_mean, population_mean_);
+
     // extract data 
     if ( d->known(names::record_from) )
     {
@@ -116,7 +164,7 @@ namespace nest
   {
     const Multimeter& asd = dynamic_cast<const Multimeter&>(np);
     device_.init_state(asd.device_);
-    S_.data_.clear();
+    S_.clear();
   }
 
   void Multimeter::init_buffers_()
@@ -168,27 +216,28 @@ namespace nest
     // easy access to relevant information
     DataLoggingReply::Container const & info = reply.get_info();
 
+    // data is stored by column, one per recorded variable
+    if ( S_.data_.size() != info.num_vars() )
+      S_.data_.resize(info.num_vars());
+
     // If this is the first Reply arriving, we need to mark the beginning of the data
     // for this round of replies
     if ( V_.new_request_ )
-      V_.current_request_data_start_ = S_.data_.size();
+      V_.current_request_data_start_ = S_.size();
 
     size_t inactive_skipped = 0;  // count records that have been skipped during inactivity
 
     // record all data, time point by time point
     for ( size_t j = 0 ; j < info.size() ; ++j )
     {
-      if ( not info[j].timestamp.is_finite() )
-        break;
-
-      if ( !is_active(info[j].timestamp) )
+      if ( !is_active(info.timestamp(j)) )
       {
         ++inactive_skipped;
 	continue;
       }
 
       // store stamp for current data set in event for logging
-      reply.set_stamp(info[j].timestamp);
+      reply.set_stamp(info.timestamp(j));
 
       // record sender and time information; in accumulator mode only for first Reply in slice
       if ( !device_.to_accumulator() || V_.new_request_ )
@@ -197,22 +246,28 @@ namespace nest
       if ( !device_.to_accumulator() )
       {
         // "print" actual data, but not in accumulator mode
-        print_value_(info[j].data);
+        print_value_(info, j);
 
         if ( device_.to_memory() )
-          S_.data_.push_back(info[j].data);
+          for ( size_t k = 0 ; k < info.num_vars() ; ++k )
+            S_.data_[k].push_back(info.value(k, j));
       }
       else
       {
         if ( V_.new_request_ )  // first reply in slice, push back to create new time points
-          S_.data_.push_back(info[j].data);
+        {
+          for ( size_t k = 0 ; k < info.num_vars() ; ++k )
+            S_.data_[k].push_back(info.value(k, j));
+          S_.n_accumulated_.push_back(1);
+        }
         else
         {  // add data; offset j from current_request_data_start_, but inactive skipped entries subtracted
           assert(j >= inactive_skipped);
-          assert(V_.current_request_data_start_ + j - inactive_skipped < S_.data_.size());
-          assert(S_.data_[V_.current_request_data_start_ + j - inactive_skipped].size() == info[j].data.size());
-          for ( size_t k = 0 ; k < info[j].data.size() ; ++k )
-            S_.data_[V_.current_request_data_start_ + j - inactive_skipped][k] += info[j].data[k];
+          const size_t t = V_.current_request_data_start_ + j - inactive_skipped;
+          assert(t < S_.size());
+          for ( size_t k = 0 ; k < info.num_vars() ; ++k )
+            S_.data_[k][t] += info.value(k, j);
+          ++S_.n_accumulated_[t];
         }
       }
     }
@@ -220,29 +275,26 @@ namespace nest
     V_.new_request_ = false;  // correct either we are done with the first reply or any later one
   }
 
-  void Multimeter::print_value_(const std::vector<double_t>& values)
+  void Multimeter::print_value_(const DataLoggingReply::Container& info, size_t j)
   {
-    if ( values.size() < 1 )
+    const size_t n_vars = info.num_vars();
+    if ( n_vars < 1 )
       return;
 
-    for ( size_t j = 0 ; j < values.size()-1 ; ++j )
-      device_.print_value(values[j], false);
+    for ( size_t k = 0 ; k < n_vars-1 ; ++k )
+      device_.print_value(info.value(k, j), false);
     
-    device_.print_value(values[values.size()-1]);
+    device_.print_value(info.value(n_vars-1, j));
   }
 
 
   void Multimeter::add_data_(DictionaryDatum& d) const
   {
-    // re-organize data into one vector per recorded variable
+    // data is already organized as one vector per recorded variable
+    const std::vector<double_t> empty;
     for ( size_t v = 0 ; v < P_.record_from_.size() ; ++v )
       {
-	std::vector<double_t> dv(S_.data_.size());
-	for ( size_t t = 0 ; t < S_.data_.size() ; ++t ) 
-        {
-          assert(v < S_.data_[t].size());
-          dv[t] = S_.data_[t][v];
-        }
+        const std::vector<double_t>& dv = v < S_.data_.size() ? S_.data_[v] : empty;
         initialize_property_doublevector(d, P_.record_from_[v]);
         if ( device_.to_accumulator() && not dv.empty() )
           accumulate_property(d, P_.record_from_[v], dv);
@@ -251,6 +303,44 @@ namespace nest
       }
   }
 
+  void Multimeter::average_data_(DictionaryDatum& d) const
+  {
+    // collect the number of contributions from all threads; threads
+    // without targets have no data
+    std::vector<long_t> n(S_.n_accumulated_);
+    const SiblingContainer* siblings = network()->get_thread_siblings(get_gid());
+    std::vector<Node*>::const_iterator sibling;
+    for (sibling = siblings->begin() + 1; sibling != siblings->end(); ++sibling)
+    {
+      const std::vector<long_t>& ns =
+        dynamic_cast<const Multimeter&>(**sibling).S_.n_accumulated_;
+      if ( n.empty() )
+        n = ns;
+      else if ( not ns.empty() )
+      {
+        assert(ns.size() == n.size());
+        for ( size_t t = 0 ; t < n.size() ; ++t )
+          n[t] += ns[t];
+      }
+    }
+
+    for ( size_t v = 0 ; v < P_.record_from_.size() ; ++v )
+      {
+        Token tok = d->lookup2(P_.record_from_[v]);
+        DoubleVectorDatum* dv = dynamic_cast<DoubleVectorDatum*>(tok.datum());
+        assert(dv != 0);
+        assert((*dv)->empty() || (*dv)->size() == n.size());
+        for ( size_t t = 0 ; t < (*dv)->size() ; ++t )
+          (**dv)[t] /= n[t];
+      }
+  }
+
+  void Multimeter::State_::clear()
+  {
+    data_.clear();
+    n_accumulated_.clear();
+  }
+
   bool Multimeter::is_active(Time const & T) const
   {
     const long_t stamp = T.get_steps();
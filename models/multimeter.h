@@ -69,10 +69,26 @@ to memory, to screen, with GID or with weight. You must activate accumulator mod
 before simulating. Accumulator data is never written to file. You must extract it
 from the device using GetStatus.
 
+In accumulator mode, set /population_mean to true to obtain the average
+across all recorded nodes instead of the sum. Each value is then divided by
+the number of nodes that contributed to it on the MPI process.
+
+Reduction:
+For long simulations with a short recording interval, the recorded nodes can
+reduce their samples before sending them to the multimeter. Set /reduction to
+one of the following values and /reduction_window to a multiple of /interval:
+  none      - record every sample (default)
+  decimate  - record only the last sample of each window
+  min, max  - record the minimum or maximum of the samples of each window
+  mean      - record the mean of the samples of each window
+Windows end at multiples of /reduction_window; the time stamp of a record is
+the end of its window. The first window after the start of a simulation may
+contain fewer samples. Reduction can be combined with accumulator mode.
+
 Note:
- - The set of variables to record and the recording interval must be set
-   BEFORE the multimeter is connected to any node, and cannot be changed
-   afterwards.
+ - The set of variables to record, the recording interval and the reduction
+   must be set BEFORE the multimeter is connected to any node, and cannot be
+   changed afterwards.
  - A multimeter cannot be frozen.
  - If you record with multimeter in accumulator mode and some of the nodes
    you record from and others are not, data will only be collected from the
@@ -85,6 +101,9 @@ Parameters:
      record_from  array  - Array containing the names of variables to record
                            from, obtained from the /recordables entry of the
                            model from which one wants to record
+     reduction    string - Reduction of samples per window, see above
+     reduction_window double - Length of reduction window in ms
+     population_mean  bool   - In accumulator mode, average instead of sum
   
 Examples:
 SLI ] /iaf_cond_alpha Create /n Set
@@ -213,7 +232,7 @@ namespace nest {
      *       RecordingDevice::print_value() can handle. Otherwise, specialization is
      *       required.
      */
-    void print_value_(const std::vector<double_t>&);
+    void print_value_(const DataLoggingReply::Container&, size_t);
     
     /**
      * Add recorded data to dictionary.
@@ -223,6 +242,12 @@ namespace nest {
      */
     void add_data_(DictionaryDatum&) const;
 
+    /**
+     * Divide accumulated data by the number of contributing nodes.
+     * Called on thread 0 after the data of all siblings has been added.
+     */
+    void average_data_(DictionaryDatum&) const;
+
     // ------------------------------------------------------------
 
     RecordingDevice device_;
@@ -234,6 +259,13 @@ namespace nest {
     struct Parameters_ {
       Time interval_;                 //!< recording interval, in ms
       std::vector<Name> record_from_; //!< which data to record
+      DataLoggingRequest::Reduction reduction_; //!< reduction of samples per window
+      Time reduction_window_;         //!< reduction window, in ms
+      bool population_mean_;          //!< average across nodes in accumulator mode
+
+      //! Names of reductions, indexed by DataLoggingRequest::Reduction
+      static const char* const reduction_names_[];
+      static const size_t n_reductions_;
       
       Parameters_();
       Parameters_(const Parameters_&);
@@ -245,16 +277,24 @@ namespace nest {
 
     struct State_ {
       /** Recorded data.
-       * First dimension: time
-       * Second dimension: recorded variables
+       * First dimension: recorded variables
+       * Second dimension: time
        * @note In normal mode, data is stored as follows:
        *          For each recorded node, all data points for one time slice are put
-       *          after one another in the first dimension. Each entry is a vector
-       *          containing one element per recorded quantity.
+       *          after one another in the second dimension.
        *        In accumulating mode, only one data point is stored per time step and
        *          values are added across nodes.
        */
       std::vector<std::vector<double_t> > data_;      //!< Recorded data
+
+      //! Number of nodes added to each data point in accumulating mode
+      std::vector<long_t> n_accumulated_;
+
+      //! Number of recorded data points
+      size_t size() const { return data_.empty() ? 0 : data_[0].size(); }
+
+      //! Erase all recorded data
+      void clear();
     };
 
     // ------------------------------------------------------------
@@ -316,6 +356,9 @@ namespace nest {
       std::vector<Node*>::const_iterator sibling;
       for (sibling = siblings->begin() + 1; sibling != siblings->end(); ++sibling)
         (*sibling)->get_status(d);
+
+      if ( P_.population_mean_ && device_.to_accumulator() )
+        average_data_(dd);
     }
 
     P_.get(d);
@@ -334,7 +377,7 @@ namespace nest {
     
     // Set properties in device. As a side effect, this will clear data_,
     // if /clear_events set in d
-    device_.set_status(d, S_.data_);
+    device_.set_status(d, S_);
 
     P_ = ptmp;
   }
@@ -167,11 +167,13 @@ void nest::noise_generator::update(Time const &origin, const long_t from, const
     // >= in case we woke from inactivity  
     if( now >= B_.next_step_ )
     {
-      // compute new currents
+      // compute new currents, drawing the normal deviates for all
+      // targets at once
+      V_.normal_dev_.get_values(net_->get_rng(get_thread()), B_.amps_);
       for ( AmpVec_::iterator it = B_.amps_.begin() ;
             it != B_.amps_.end() ; ++it )
 	{
-	  *it = P_.mean_ + P_.std_ * V_.normal_dev_(net_->get_rng(get_thread()));
+	  *it = P_.mean_ + P_.std_ * *it;
 	}
 
       // use now as reference, in case we woke up from inactive period
@@ -27,6 +27,8 @@
 #include "dictutils.h"
 #include "exceptions.h"
 
+const size_t nest::poisson_generator::max_block_size_;
+
 /* ----------------------------------------------------------------
  * Default constructors defining default parameter
  * ---------------------------------------------------------------- */
@@ -84,6 +86,10 @@ void nest::poisson_generator::init_state_(const Node& proto)
 void nest::poisson_generator::init_buffers_()
 {
   device_.init_buffers();
+
+  B_.n_spikes_.clear();
+  B_.next_ = 0;
+  B_.n_targets_ = -1;
 }
 
 void nest::poisson_generator::calibrate()
@@ -92,6 +98,12 @@ void nest::poisson_generator::calibrate()
 
   // rate_ is in Hz, dt in ms, so we have to convert from s to ms
   V_.poisson_dev_.set_lambda(Time::get_resolution().get_ms() * P_.rate_ * 1e-3);
+
+  // connections may have changed since the last simulation, and spike
+  // numbers drawn for the old rate must not be used
+  B_.n_spikes_.clear();
+  B_.next_ = 0;
+  B_.n_targets_ = -1;
 }
 
 
@@ -112,6 +124,35 @@ void nest::poisson_generator::update(Time const & T, const long_t from, const lo
     if ( !device_.is_active( T + Time::step(lag) ) )
       continue;  // no spike at this lag
 
+    if ( B_.n_targets_ < 0 )
+    {
+      // the hook draws for each target and counts the targets
+      DSSpikeEvent se;
+      network()->send(*this, se, lag);
+      B_.n_targets_ = B_.next_;
+      B_.next_ = 0;
+      continue;
+    }
+
+    if ( B_.next_ == B_.n_spikes_.size() )
+    {
+      // draw for all targets and the next remaining active steps of the
+      // slice, step by step as the hook would have done; at most as many
+      // steps as fit into max_block_size_ numbers, but at least one
+      size_t max_steps = B_.n_targets_ > 0 ? max_block_size_ / B_.n_targets_ : 1;
+      if ( max_steps == 0 )
+        max_steps = 1;
+
+      size_t n_steps = 0;
+      for ( long_t l = lag ; l < to && n_steps < max_steps ; ++l )
+        if ( device_.is_active( T + Time::step(l) ) )
+          ++n_steps;
+
+      B_.n_spikes_.resize(n_steps * B_.n_targets_);
+      V_.poisson_dev_.get_uldevs(net_->get_rng(get_thread()), B_.n_spikes_);
+      B_.next_ = 0;
+    }
+
     DSSpikeEvent se;
     network()->send(*this, se, lag);
   }
@@ -119,8 +160,15 @@ void nest::poisson_generator::update(Time const & T, const long_t from, const lo
 
 void nest::poisson_generator::event_hook(DSSpikeEvent& e)
 {
-  librandom::RngPtr rng = net_->get_rng(get_thread());
-  ulong_t n_spikes = V_.poisson_dev_.uldev(rng);
+  ulong_t n_spikes;
+  if ( B_.next_ < B_.n_spikes_.size() )
+    n_spikes = B_.n_spikes_[B_.next_++];
+  else
+  {
+    // targets not counted yet
+    n_spikes = V_.poisson_dev_.uldev(net_->get_rng(get_thread()));
+    ++B_.next_;
+  }
 
   if ( n_spikes > 0 ) // we must not send events with multiplicity 0
   {
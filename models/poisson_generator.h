@@ -93,6 +93,20 @@ Remarks:
 
    http://ken.brainworks.uni-freiburg.de/cgi-bin/mailman/private/nest_developer/2011-January/002977.html
 
+   The generator does not draw the numbers of spikes target by target in
+   the hook. Once it knows its number of targets, it draws the numbers for
+   all targets and several active steps of a time slice in one go, and the
+   hook only hands them out. A block holds at most 4096 numbers, or the
+   numbers for a single step if the generator has more targets. The
+   numbers are drawn in the same order as before, so that the spike
+   trains do not change, provided that nothing else draws from the RNG
+   of the thread while the spikes of the generator are delivered. This
+   holds for the built-in synapse models, but a synapse model from an
+   extension module that draws random numbers when it transmits a spike,
+   such as a stochastic release synapse, receives different numbers than
+   before, since its draws no longer alternate with those of the
+   generator. The spike trains are statistically equivalent.
+
 SeeAlso: poisson_generator_ps, Device, parrot_neuron
 */
 
@@ -143,6 +157,25 @@ SeeAlso: poisson_generator_ps, Device, parrot_neuron
 
     // ------------------------------------------------------------
 
+    struct Buffers_ {
+      std::vector<ulong_t> n_spikes_; //!< spike numbers, one per target and active step
+      size_t next_;                   //!< next element of n_spikes_ to hand out
+
+      /**
+       * Number of targets on the thread of the generator. It is counted
+       * during the first active step after calibration, -1 until then.
+       */
+      long_t n_targets_;
+    };
+
+    /**
+     * Largest number of spike numbers drawn in one go, unless a single
+     * step has more targets. Bounds the memory of Buffers_::n_spikes_.
+     */
+    static const size_t max_block_size_ = 4096;
+
+    // ------------------------------------------------------------
+
     struct Variables_ {
       librandom::PoissonRandomDev poisson_dev_;  //!< Random deviate generator
     };
@@ -152,6 +185,7 @@ SeeAlso: poisson_generator_ps, Device, parrot_neuron
     StimulatingDevice<SpikeEvent> device_;
     Parameters_ P_;
     Variables_  V_;
+    Buffers_    B_;
 
   };
 
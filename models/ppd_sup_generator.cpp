@@ -178,6 +178,10 @@ void nest::ppd_sup_generator::init_state_(const Node& proto)
 void nest::ppd_sup_generator::init_buffers_()
 { 
   device_.init_buffers();
+  B_.ports_.clear();
+  B_.ports_recorded_ = false;
+  B_.n_spikes_.clear();
+  B_.next_ = 0;
 }
 
 void nest::ppd_sup_generator::calibrate()
@@ -203,6 +207,12 @@ void nest::ppd_sup_generator::calibrate()
   // elements are unchanged.
   Age_distribution_ age_distribution0 (num_age_bins, ini_occ_0, P_.n_proc_ - ini_occ_0 * num_age_bins);
   B_.age_distributions_.resize( P_.num_targets_, age_distribution0 );
+
+  // the order in which the hook is called for the targets may have changed
+  B_.ports_.clear();
+  B_.ports_recorded_ = false;
+  B_.n_spikes_.clear();
+  B_.next_ = 0;
 }
 
 
@@ -219,6 +229,8 @@ void nest::ppd_sup_generator::update(Time const & T, const long_t from, const lo
   if ( P_.rate_ <= 0 || P_.num_targets_ == 0 ) 
     return;
 
+  librandom::RngPtr rng = net_->get_rng(get_thread());
+
   for ( long_t lag = from ; lag < to ; ++lag )
   {
     Time t = T + Time::step(lag); 
@@ -235,6 +247,29 @@ void nest::ppd_sup_generator::update(Time const & T, const long_t from, const lo
     else
       V_.hazard_step_t_ = V_.hazard_step_;    
     
+    if ( !B_.ports_recorded_ )
+    {
+      // the hook draws for each target and records its port
+      DSSpikeEvent se;
+      network()->send(*this, se, lag);
+      B_.ports_recorded_ = true;
+      B_.n_spikes_.resize( B_.ports_.size() );
+      continue;
+    }
+
+    // propagate the processes of all targets and draw their spikes,
+    // in the order in which the hook would have done it
+    bool has_spikes = false;
+    for ( size_t k = 0 ; k < B_.ports_.size() ; ++k )
+    {
+      B_.n_spikes_[k] = B_.age_distributions_[B_.ports_[k]].update( V_.hazard_step_t_, rng );
+      has_spikes = has_spikes || B_.n_spikes_[k] > 0;
+    }
+
+    if ( !has_spikes )
+      continue;
+
+    B_.next_ = 0;
     DSSpikeEvent se;
     network()->send(*this, se, lag);
   }
@@ -246,11 +281,21 @@ void nest::ppd_sup_generator::event_hook(DSSpikeEvent& e)
   // get port number
   const port prt = e.get_port();
 
-  // we handle only one port here, get reference to vector element 
+  // we handle only one port here
   assert(0 <= prt && static_cast<size_t>(prt) < B_.age_distributions_.size() );
 
-  // age_distribution object propagates one time step and returns number of spikes
-  ulong_t n_spikes = B_.age_distributions_[prt].update( V_.hazard_step_t_, net_->get_rng(get_thread()) );
+  ulong_t n_spikes;
+  if ( B_.ports_recorded_ )
+  {
+    assert(B_.next_ < B_.n_spikes_.size() && B_.ports_[B_.next_] == prt);
+    n_spikes = B_.n_spikes_[B_.next_++];
+  }
+  else
+  {
+    // ports not recorded yet, draw here
+    n_spikes = B_.age_distributions_[prt].update( V_.hazard_step_t_, net_->get_rng(get_thread()) );
+    B_.ports_.push_back(prt);
+  }
   
   if ( n_spikes > 0 ) // we must not send events with multiplicity 0
   {
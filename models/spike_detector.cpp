@@ -54,7 +54,7 @@ void nest::spike_detector::init_buffers_()
 {
   device_.init_buffers();
 
-  std::vector<std::vector<Event*> > tmp(2, std::vector<Event*>());
+  std::vector<std::vector<Spike_> > tmp(2, std::vector<Spike_>());
   B_.spikes_.swap(tmp);
 }
 
@@ -75,14 +75,10 @@ void nest::spike_detector::calibrate()
 
 void nest::spike_detector::update(Time const&, const long_t, const long_t)
 {
-  for(std::vector<Event*>::iterator 
-      e = B_.spikes_[network()->read_toggle()].begin();
-      e != B_.spikes_[network()->read_toggle()].end(); ++e)
-  {
-    assert(*e != 0);
-    device_.record_event(**e);
-    delete *e;
-  }
+  for(std::vector<Spike_>::const_iterator 
+      s = B_.spikes_[network()->read_toggle()].begin();
+      s != B_.spikes_[network()->read_toggle()].end(); ++s)
+    device_.record_spike(s->sender_, Time::step(s->step_), s->offset_, s->weight_);
   
   // do not use swap here to clear, since we want to keep the reserved()
   // memory for the next round
@@ -127,11 +123,13 @@ void nest::spike_detector::handle(SpikeEvent & e)
     else
       dest_buffer = network()->write_toggle();  // locally delivered events
 
-    for (int_t i = 0; i < e.get_multiplicity(); ++i)
-    {
-      // We store the complete events
-      Event *event = e.clone();
-      B_.spikes_[dest_buffer].push_back(event);
-    }
+    Spike_ spike;
+    spike.sender_ = e.get_sender_gid();
+    spike.step_   = e.get_stamp().get_steps();
+    spike.offset_ = e.get_offset();
+    spike.weight_ = e.get_weight();
+
+    // record the spike once for each unit of multiplicity
+    B_.spikes_[dest_buffer].insert(B_.spikes_[dest_buffer].end(), e.get_multiplicity(), spike);
   }
 }
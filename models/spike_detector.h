@@ -139,13 +139,27 @@ namespace nest
      */
     void update(Time const &, const long_t, const long_t);
 
+    /**
+     * Properties of a buffered spike.
+     *
+     * Only the data needed by RecordingDevice::record_spike() is kept, so
+     * that buffering a spike does not require a copy of the event on the
+     * heap.
+     */
+    struct Spike_ {
+      index    sender_;  //!< GID of the sender
+      long_t   step_;    //!< time stamp in steps
+      double_t offset_;  //!< offset of a precise spike
+      double_t weight_;  //!< weight of the connection
+    };
+
     /**
      * Buffer for incoming spikes. 
      *
      * This data structure buffers all incoming spikes until they are
      * passed to the RecordingDevice for storage or output during update().
      * update() always reads from spikes_[network()->read_toggle()] and
-     * deletes all events that have been read.
+     * clears it afterwards, keeping the allocated memory.
      *
      * Events arriving from locally sending nodes, i.e., devices without
      * proxies, are stored in spikes_[network()->write_toggle()], to ensure
@@ -159,7 +173,7 @@ namespace nest
      * from the global queue before any node is updated.
      */
     struct Buffers_ {
-      std::vector<std::vector<Event*> > spikes_; 
+      std::vector<std::vector<Spike_> > spikes_; 
     };
     
     RecordingDevice device_;
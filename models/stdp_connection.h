@@ -73,6 +73,7 @@
 #include "connection_het_wd.h"
 #include "archiving_node.h"
 #include "generic_connector.h"
+#include "numerics.h"
 #include <cmath>
 
 namespace nest
@@ -160,14 +161,14 @@ namespace nest
 inline
 double_t STDPConnection::facilitate_(double_t w, double_t kplus)
 {
-  double_t norm_w = (w / Wmax_) + (lambda_ * std::pow(1.0 - (w/Wmax_), mu_plus_) * kplus);
+  double_t norm_w = (w / Wmax_) + (lambda_ * numerics::pow(1.0 - (w/Wmax_), mu_plus_) * kplus);
   return norm_w < 1.0 ? norm_w * Wmax_ : Wmax_;
 }
 
 inline 
 double_t STDPConnection::depress_(double_t w, double_t kminus)
 {
-  double_t norm_w = (w / Wmax_) - (alpha_ * lambda_ * std::pow(w/Wmax_, mu_minus_) * kminus);
+  double_t norm_w = (w / Wmax_) - (alpha_ * lambda_ * numerics::pow(w/Wmax_, mu_minus_) * kminus);
   return norm_w > 0.0 ? norm_w * Wmax_ : 0.0;
 }
 
@@ -202,8 +203,8 @@ void STDPConnection::send(Event& e, double_t t_lastspike, const CommonSynapsePro
   double_t dendritic_delay = Time(Time::step(delay_)).get_ms();
 
   //get spike history in relevant range (t1, t2] from post-synaptic neuron
-  std::deque<histentry>::iterator start;
-  std::deque<histentry>::iterator finish;
+  history_iterator start;
+  history_iterator finish;
 
   // For a new synapse, t_lastspike contains the point in time of the last spike.
   // So we initially read the history(t_last_spike - dendritic_delay, ...,  T_spike-dendritic_delay]
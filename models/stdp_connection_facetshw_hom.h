@@ -366,8 +366,8 @@ void STDPFACETSHWConnectionHom::send(Event& e, double_t t_lastspike, STDPFACETSH
   double_t dendritic_delay = Time(Time::step(delay_)).get_ms();
 
   //get spike history in relevant range (t1, t2] from post-synaptic neuron
-  std::deque<histentry>::iterator start;
-  std::deque<histentry>::iterator finish;
+  history_iterator start;
+  history_iterator finish;
   target_->get_history(t_lastspike - dendritic_delay, t_spike - dendritic_delay,
 			       &start, &finish);
   //facilitation due to post-synaptic spikes since last pre-synaptic spike
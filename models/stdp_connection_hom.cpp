@@ -40,8 +40,11 @@ namespace nest
     alpha_(1.0),
     mu_plus_(1.0),
     mu_minus_(1.0),
-    Wmax_(100.0)
-  { }
+    Wmax_(100.0),
+    exp_plus_()
+  {
+    exp_plus_.set(tau_plus_, Time::get_resolution().get_ms());
+  }
 
   void STDPHomCommonProperties::get_status(DictionaryDatum & d) const
   {
@@ -65,6 +68,14 @@ namespace nest
     updateValue<double_t>(d, "mu_plus", mu_plus_);
     updateValue<double_t>(d, "mu_minus", mu_minus_);
     updateValue<double_t>(d, "Wmax", Wmax_);   
+
+    exp_plus_.set(tau_plus_, Time::get_resolution().get_ms());
+  }
+
+  void STDPHomCommonProperties::calibrate(const TimeConverter &tc)
+  {
+    CommonSynapseProperties::calibrate(tc);
+    exp_plus_.set(tau_plus_, Time::get_resolution().get_ms());
   }
 
 
@@ -72,6 +72,8 @@
 
 #include "connection_het_wd.h"
 #include "archiving_node.h"
+#include "exp_table.h"
+#include "numerics.h"
 #include <cmath>
 
 namespace nest
@@ -102,6 +104,11 @@ namespace nest
        */
       void set_status(const DictionaryDatum & d, ConnectorModel& cm);
 
+      /**
+       * Tabulate the decay of the presynaptic trace for the new resolution.
+       */
+      void calibrate(const TimeConverter &);
+
       // overloaded for all supported event types
       void check_event(SpikeEvent&) {}
  
@@ -114,6 +121,8 @@ namespace nest
       double_t mu_plus_;
       double_t mu_minus_;  
       double_t Wmax_;
+
+      ExpTable exp_plus_;  //!< exp(dt/tau_plus_)
     };
 
 
@@ -211,14 +220,14 @@ namespace nest
 inline
 double_t STDPConnectionHom::facilitate_(double_t w, double_t kplus, const STDPHomCommonProperties &cp)
 {
-  double_t norm_w = (w / cp.Wmax_) + (cp.lambda_ * std::pow(1.0 - (w/cp.Wmax_), cp.mu_plus_) * kplus);
+  double_t norm_w = (w / cp.Wmax_) + (cp.lambda_ * numerics::pow(1.0 - (w/cp.Wmax_), cp.mu_plus_) * kplus);
   return norm_w < 1.0 ? norm_w * cp.Wmax_ : cp.Wmax_;
 }
 
 inline 
 double_t STDPConnectionHom::depress_(double_t w, double_t kminus, const STDPHomCommonProperties &cp)
 {
-  double_t norm_w = (w / cp.Wmax_) - (cp.alpha_ * cp.lambda_ * std::pow(w/cp.Wmax_, cp.mu_minus_) * kminus);
+  double_t norm_w = (w / cp.Wmax_) - (cp.alpha_ * cp.lambda_ * numerics::pow(w/cp.Wmax_, cp.mu_minus_) * kminus);
   return norm_w > 0.0 ? norm_w * cp.Wmax_ : 0.0;
 }
 
@@ -250,8 +259,8 @@ void STDPConnectionHom::send(Event& e, double_t t_lastspike, const STDPHomCommon
   double_t dendritic_delay = Time(Time::step(delay_)).get_ms(); 
     
   //get spike history in relevant range (t1, t2] from post-synaptic neuron
-  std::deque<histentry>::iterator start;
-  std::deque<histentry>::iterator finish;    
+  history_iterator start;
+  history_iterator finish;    
   target_->get_history(t_lastspike - dendritic_delay, t_spike - dendritic_delay, 
 			       &start, &finish);
   //facilitation due to post-synaptic spikes since last pre-synaptic spike
@@ -262,7 +271,7 @@ void STDPConnectionHom::send(Event& e, double_t t_lastspike, const STDPHomCommon
     ++start;
     if (minus_dt == 0)
       continue;
-    weight_ = facilitate_(weight_, Kplus_ * std::exp(minus_dt / cp.tau_plus_), cp);
+    weight_ = facilitate_(weight_, Kplus_ * cp.exp_plus_(minus_dt), cp);
   }
   
 
@@ -274,7 +283,7 @@ void STDPConnectionHom::send(Event& e, double_t t_lastspike, const STDPHomCommon
   e.set_rport(rport_);
   e();
 
-  Kplus_ = Kplus_ * std::exp((t_lastspike - t_spike) /  cp.tau_plus_) + 1.0;
+  Kplus_ = Kplus_ * cp.exp_plus_(t_lastspike - t_spike) + 1.0;
   }
 
 } // of namespace nest
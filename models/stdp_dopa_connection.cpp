@@ -44,8 +44,11 @@ namespace nest
     tau_n_(200.0),
     b_(0.0),
     Wmin_(0.0),
-    Wmax_(200.0)
-  {}
+    Wmax_(200.0),
+    exp_plus_()
+  {
+    exp_plus_.set(tau_plus_, Time::get_resolution().get_ms());
+  }
 
   void STDPDopaCommonProperties::get_status(DictionaryDatum & d) const
   {
@@ -87,6 +90,14 @@ namespace nest
     updateValue<double_t>(d, "b", b_);
     updateValue<double_t>(d, "Wmin", Wmin_);
     updateValue<double_t>(d, "Wmax", Wmax_);
+
+    exp_plus_.set(tau_plus_, Time::get_resolution().get_ms());
+  }
+
+  void STDPDopaCommonProperties::calibrate(const TimeConverter &tc)
+  {
+    CommonSynapseProperties::calibrate(tc);
+    exp_plus_.set(tau_plus_, Time::get_resolution().get_ms());
   }
 
   Node* STDPDopaCommonProperties::get_node()
@@ -103,6 +114,7 @@ namespace nest
   //
 
   STDPDopaConnection::STDPDopaConnection() :
+    Kplus_(0.0),
     c_(0.0),
     n_(0.0),
     dopa_spikes_idx_(0),
@@ -112,6 +124,7 @@ namespace nest
   STDPDopaConnection::STDPDopaConnection(const STDPDopaConnection &rhs) :
     ConnectionHetWD(rhs)
   {
+    Kplus_ = rhs.Kplus_;
     c_ = rhs.c_;
     n_ = rhs.n_;
     dopa_spikes_idx_ = rhs.dopa_spikes_idx_;
@@ -81,6 +81,7 @@
 
 #include "connection_het_wd.h"
 #include "archiving_node.h"
+#include "exp_table.h"
 #include "volume_transmitter.h"
 #include "spikecounter.h"
 
@@ -115,6 +116,11 @@ namespace nest
      */
     void set_status(const DictionaryDatum& d, ConnectorModel& cm);
 
+    /**
+     * Tabulate the decay of the presynaptic trace for the new resolution.
+     */
+    void calibrate(const TimeConverter &);
+
     // overloaded for all supported event types
     void check_event(SpikeEvent&) {}
 
@@ -131,6 +137,8 @@ namespace nest
     double_t b_;
     double_t Wmin_;
     double_t Wmax_;
+
+    ExpTable exp_plus_;  //!< exp(dt/tau_plus_)
   };
 
 
@@ -337,8 +345,8 @@ namespace nest
     const vector<spikecounter>& dopa_spikes = cp.vt_->deliver_spikes();
 
     // get spike history in relevant range (t_last_update, t_spike] from post-synaptic neuron
-    std::deque<histentry>::iterator start;
-    std::deque<histentry>::iterator finish;
+    history_iterator start;
+    history_iterator finish;
     target_->get_history(t_last_update_ - dendritic_delay, t_spike - dendritic_delay, &start, &finish);
 
     // facilitation due to post-synaptic spikes since last update
@@ -350,7 +358,7 @@ namespace nest
       t0 = start->t_ + dendritic_delay;
       minus_dt = t_last_update_ - t0;
       if ( start->t_ < t_spike )  // only depression if pre- and postsyn. spike occur at the same time
-	facilitate_(Kplus_ * std::exp( minus_dt / cp.tau_plus_ ), cp);
+	facilitate_(Kplus_ * cp.exp_plus_( minus_dt ), cp);
       ++start;
     }
 
@@ -364,7 +372,7 @@ namespace nest
     e.set_rport(rport_);
     e();
 
-    Kplus_ = Kplus_ * std::exp( ( t_last_update_ - t_spike ) / cp.tau_plus_) + 1.0;
+    Kplus_ = Kplus_ * cp.exp_plus_( t_last_update_ - t_spike ) + 1.0;
     t_last_update_ = t_spike;
   }
 
@@ -379,8 +387,8 @@ namespace nest
     double_t dendritic_delay = Time(Time::step(delay_)).get_ms();
 
     // get spike history in relevant range (t_last_update, t_trig] from postsyn. neuron
-    std::deque<histentry>::iterator start;
-    std::deque<histentry>::iterator finish;
+    history_iterator start;
+    history_iterator finish;
     target_->get_history(t_last_update_ - dendritic_delay, t_trig - dendritic_delay, &start, &finish);
 
     // facilitation due to postsyn. spikes since last update
@@ -391,7 +399,7 @@ namespace nest
       process_dopa_spikes_(dopa_spikes, t0, start->t_ + dendritic_delay, cp);
       t0 = start->t_ + dendritic_delay;
       minus_dt = t_last_update_ - t0;
-      facilitate_(Kplus_ * std::exp( minus_dt / cp.tau_plus_ ), cp);
+      facilitate_(Kplus_ * cp.exp_plus_( minus_dt ), cp);
       ++start;
     }
     
@@ -399,7 +407,7 @@ namespace nest
     // but do increment/decrement as there are no spikes to be handled at t_trig
     process_dopa_spikes_(dopa_spikes, t0, t_trig, cp);
     n_ = n_ * std::exp( ( dopa_spikes[dopa_spikes_idx_].spike_time_ - t_trig ) / cp.tau_n_ );
-    Kplus_ = Kplus_ * std::exp( ( t_last_update_ - t_trig ) / cp.tau_plus_);
+    Kplus_ = Kplus_ * cp.exp_plus_( t_last_update_ - t_trig );
 
     t_last_update_ = t_trig;
     dopa_spikes_idx_ = 0;
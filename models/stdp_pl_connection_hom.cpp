@@ -38,8 +38,11 @@ namespace nest
     tau_plus_(20.0),
     lambda_(0.1),
     alpha_(1.0),
-    mu_(0.4)
-  { }
+    mu_(0.4),
+    exp_plus_()
+  {
+    exp_plus_.set(tau_plus_, Time::get_resolution().get_ms());
+  }
 
   void STDPPLHomCommonProperties::get_status(DictionaryDatum & d) const
   {
@@ -59,6 +62,14 @@ namespace nest
     updateValue<double_t>(d, "lambda", lambda_);
     updateValue<double_t>(d, "alpha", alpha_);
     updateValue<double_t>(d, "mu", mu_);
+
+    exp_plus_.set(tau_plus_, Time::get_resolution().get_ms());
+  }
+
+  void STDPPLHomCommonProperties::calibrate(const TimeConverter &tc)
+  {
+    CommonSynapseProperties::calibrate(tc);
+    exp_plus_.set(tau_plus_, Time::get_resolution().get_ms());
   }
 
 
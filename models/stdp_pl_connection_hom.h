@@ -53,6 +53,8 @@
 
 #include "connection_het_wd.h"
 #include "archiving_node.h"
+#include "exp_table.h"
+#include "numerics.h"
 #include <cmath>
 
 namespace nest
@@ -82,7 +84,12 @@ namespace nest
        * Set properties from the values given in dictionary.
        */
       void set_status(const DictionaryDatum & d, ConnectorModel& cm);
- 
+
+      /**
+       * Tabulate the decay of the presynaptic trace for the new resolution.
+       */
+      void calibrate(const TimeConverter &);
+
     private:
 
       // data members common to all connections
@@ -90,6 +97,8 @@ namespace nest
       double_t lambda_;
       double_t alpha_;
       double_t mu_;
+
+      ExpTable exp_plus_;  //!< exp(dt/tau_plus_)
     };
 
 
@@ -187,7 +196,7 @@ namespace nest
 inline
 double_t STDPPLConnectionHom::facilitate_(double_t w, double_t kplus, const STDPPLHomCommonProperties &cp)
 {
-  return w + (cp.lambda_ * std::pow(w,cp.mu_) * kplus);
+  return w + (cp.lambda_ * numerics::pow(w,cp.mu_) * kplus);
 }
 
 inline 
@@ -223,8 +232,8 @@ void STDPPLConnectionHom::send(Event& e, double_t t_lastspike, const STDPPLHomCo
   double_t dendritic_delay = Time(Time::step(delay_)).get_ms(); 
     
   //get spike history in relevant range (t1, t2] from post-synaptic neuron
-  std::deque<histentry>::iterator start;
-  std::deque<histentry>::iterator finish;    
+  history_iterator start;
+  history_iterator finish;    
   target_->get_history(t_lastspike - dendritic_delay, t_spike - dendritic_delay, 
 			       &start, &finish);
   //facilitation due to post-synaptic spikes since last pre-synaptic spike
@@ -235,7 +244,7 @@ void STDPPLConnectionHom::send(Event& e, double_t t_lastspike, const STDPPLHomCo
     ++start;
     if (minus_dt == 0)
       continue;
-    weight_ = facilitate_(weight_, Kplus_ * std::exp(minus_dt / cp.tau_plus_), cp);
+    weight_ = facilitate_(weight_, Kplus_ * cp.exp_plus_(minus_dt), cp);
   }
 
   //depression due to new pre-synaptic spike
@@ -247,7 +256,7 @@ void STDPPLConnectionHom::send(Event& e, double_t t_lastspike, const STDPPLHomCo
   e.set_rport(rport_);
   e();
 
-  Kplus_ = Kplus_ * std::exp((t_lastspike - t_spike) /  cp.tau_plus_) + 1.0;
+  Kplus_ = Kplus_ * cp.exp_plus_(t_lastspike - t_spike) + 1.0;
 }
 
 } // of namespace nest
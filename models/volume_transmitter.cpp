@@ -29,6 +29,7 @@
 #include "dictutils.h"
 #include "arraydatum.h"
 #include "connector.h"
+#include "connection_store.h"
 #include "spikecounter.h"
 
 #include <numeric>
@@ -38,7 +39,8 @@
  * ---------------------------------------------------------------- */
 
 nest::volume_transmitter::Parameters_::Parameters_()
-  : deliver_interval_(1) // in steps of mindelay
+  : deliver_interval_(1), // in steps of mindelay, 0: no periodic delivery
+    max_history_(1000)
 {}
 
 /* ----------------------------------------------------------------
@@ -48,11 +50,17 @@ nest::volume_transmitter::Parameters_::Parameters_()
 void nest::volume_transmitter::Parameters_::get(DictionaryDatum & d) const
 {
   def<long_t>(d, "deliver_interval", deliver_interval_);
+  def<long_t>(d, "max_history", max_history_);
 }
 
 void::nest::volume_transmitter::Parameters_::set(const DictionaryDatum & d)
 {
   updateValue<long_t>(d, "deliver_interval", deliver_interval_);
+  if ( deliver_interval_ < 0 )
+    throw BadProperty("deliver_interval must not be negative.");
+  updateValue<long_t>(d, "max_history", max_history_);
+  if ( max_history_ < 1 )
+    throw BadProperty("max_history must be positive.");
 }
 
 /* ----------------------------------------------------------------
@@ -85,10 +93,28 @@ void nest::volume_transmitter::register_connector(Connector& c)
   B_.targets_.push_back(&c);
 }
 
+void nest::volume_transmitter::register_connector(ConnectionStore& c)
+{
+  B_.target_stores_.push_back(&c);
+}
+
 void nest::volume_transmitter::calibrate()
 {
   // +1 as pseudo dopa spike at t_trig is inserted after trigger_update_weight
-  B_.spikecounter_.reserve(Scheduler::get_min_delay()*P_.deliver_interval_+1);
+  if ( P_.deliver_interval_ > 0 )
+    B_.spikecounter_.reserve(Scheduler::get_min_delay()*P_.deliver_interval_+1);
+  else
+    B_.spikecounter_.reserve(P_.max_history_+Scheduler::get_min_delay()+1);
+}
+
+void nest::volume_transmitter::finalize()
+{
+  // without periodic delivery, bring all synapses up to date, so that
+  // their weights are correct when they are inspected after the simulation;
+  // periodic delivery is left to update(), so that the weights do not
+  // depend on how the simulation time is split into calls to Simulate
+  if ( P_.deliver_interval_ == 0 )
+    deliver_(network()->get_time().get_ms());
 }
 
 void nest::volume_transmitter::update(const Time&, const long_t from, const long_t to)
@@ -107,20 +133,36 @@ void nest::volume_transmitter::update(const Time&, const long_t from, const long
   }
 
   // all spikes stored in spikecounter_ are delivered to the target synapses
-  if ( ( network()->get_slice_origin().get_steps() + to ) % ( P_.deliver_interval_ * Scheduler::get_min_delay() ) == 0 )
+  // if periodic delivery is requested; otherwise the synapses catch up with
+  // the spike history when they transmit the next presynaptic spike, and
+  // the history is only delivered once it holds more than max_history spikes
+  const long_t t_end = network()->get_slice_origin().get_steps() + to;
+  if ( P_.deliver_interval_ > 0 )
   {
-    double_t t_trig = Time(Time::step(network()->get_slice_origin().get_steps() + to)).get_ms();
+    if ( t_end % ( P_.deliver_interval_ * Scheduler::get_min_delay() ) == 0 )
+      deliver_(Time(Time::step(t_end)).get_ms());
+  }
+  else if ( B_.spikecounter_.size() > static_cast<size_t>(P_.max_history_) )
+    deliver_(Time(Time::step(t_end)).get_ms());
+}
 
-    if ( !B_.spikecounter_.empty() )
-      for ( index i = 0; i < B_.targets_.size(); ++i )
-	B_.targets_[i]->trigger_update_weight(B_.spikecounter_, t_trig);
+void nest::volume_transmitter::deliver_(const double_t t_trig)
+{
+  // nothing to do if the synapses have already been updated to t_trig
+  if ( B_.spikecounter_.size() == 1 && B_.spikecounter_[0].spike_time_ == t_trig )
+    return;
 
-    // clear spikecounter
-    B_.spikecounter_.clear();
+  for ( index i = 0; i < B_.targets_.size(); ++i )
+    B_.targets_[i]->trigger_update_weight(B_.spikecounter_, t_trig);
 
-    // as with trigger_update_weight dopamine trace has been updated to t_trig, insert pseudo last dopa spike at t_trig
-    B_.spikecounter_.push_back(spikecounter(t_trig, 0.0));
-  }
+  for ( index i = 0; i < B_.target_stores_.size(); ++i )
+    B_.target_stores_[i]->trigger_update_weight(B_.spikecounter_, t_trig);
+
+  // clear spikecounter
+  B_.spikecounter_.clear();
+
+  // as with trigger_update_weight dopamine trace has been updated to t_trig, insert pseudo last dopa spike at t_trig
+  B_.spikecounter_.push_back(spikecounter(t_trig, 0.0));
 }
 
 void nest::volume_transmitter::handle(SpikeEvent& e)
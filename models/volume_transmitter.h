@@ -45,11 +45,24 @@ user-specific subset of synapses.  It is assumed that the
 neuromodulatory signal is a function of the spike times of all spikes
 emitted by the population of neurons connected to the volume
 transmitter.  The neuromodulatory dynamics is calculated in the
-synapses itself. The volume transmitter interacts in a hybrid
-structure with the neuromodulated synapses. In addition to the
-delivery of the neuromodulatory spikes triggered by every pre-synaptic
-spike, the neuromodulatory spike history is delivered in discrete time
-intervals of a manifold of the minimal synaptic delay. In order to
+synapses itself. The volume transmitter keeps the history of
+neuromodulatory spikes, and each synapse catches up with this history
+when it transmits its next pre-synaptic spike. By default, the
+history is additionally delivered to all assigned synapses in discrete
+time intervals of a manifold of the minimal synaptic delay, which
+bounds the length of the history kept in memory. Setting
+deliver_interval to 0 disables this periodic delivery. Synapses whose
+source does not spike are then only updated at the end of each call to
+Simulate, so that their weights are up to date when they are inspected
+with GetStatus, or at the end of a time slice once the history holds
+more than max_history spikes, which bounds its memory. Since
+synapses bound their weight at each delivery, the weights can depend
+on deliver_interval and max_history. The default deliver_interval of 1
+keeps the periodic delivery of earlier versions, so that existing
+simulations give the same weights; it costs one sweep over all assigned
+synapses per d_min. Networks with many neuromodulated synapses and
+sparse presynaptic activity can save most of these sweeps with
+deliver_interval 0. In order to
 insure the link between the neuromodulatory synapses and the volume
 transmitter, the volume transmitter is passed as a parameter when a
 neuromodulatory synapse is defined. The implementation is based on the
@@ -67,7 +80,12 @@ pre_neuron post_neuron /stdp_dopamine_synapse Connect
 Parameters:
 deliver_interval - time interval given in d_min time steps, in which
                    the volume signal is delivered from the volume
-                   transmitter to the assigned synapses
+                   transmitter to all assigned synapses. 0 disables
+                   the periodic delivery (default: 1).
+max_history      - number of neuromodulatory spikes after which the
+                   history is delivered to all assigned synapses at the
+                   end of the time slice if deliver_interval is 0
+                   (default: 1000).
 
 References:
 [1] Potjans W, Morrison A and Diesmann M (2010). Enabling functional
@@ -77,6 +95,7 @@ References:
 
 Author: Wiebke Potjans, Abigail Morrison
 Remarks: major changes to update function after code revision in Apr 2013 (SK)
+The periodic delivery became optional in October 2026.
 Receives: SpikeEvent
 
 SeeAlso: stdp_dopamine_synapse
@@ -94,10 +113,12 @@ namespace nest
    *
    * This class manages spike recording for normal and precise spikes. It
    * receives spikes via its handle(SpikeEvent&) method and buffers them. In the
-   * update() method it stores the newly collected buffer elements, which are delivered
-   * in time steps of (d_min*deliver_interval) to the neuromodulated synapses.
-   * In addition the synapses can ask the volume transmitter to deliver the elements stored
-   * in the update() method with the method deliver_spikes().
+   * update() method it stores the newly collected buffer elements. The synapses
+   * ask the volume transmitter to deliver the elements stored since their last
+   * update with the method deliver_spikes() when they transmit a spike. All
+   * synapses are brought up to date in time steps of (d_min*deliver_interval)
+   * or, if deliver_interval is 0, in finalize() and whenever the history
+   * holds more than max_history spikes at the end of a time slice.
    *
    *
    *
@@ -136,15 +157,23 @@ namespace nest
   protected:
 
     void register_connector(Connector& c);
+    void register_connector(ConnectionStore& c);
 
   private:
 
     void init_state_(Node const &);
     void init_buffers_();
     void calibrate();
+    void finalize();
 
     void update(const Time&, const long_t, const long_t);
 
+    /**
+     * Propagate all target synapses to time t_trig and restart the
+     * spike history with a pseudo spike at t_trig.
+     */
+    void deliver_(double_t t_trig);
+
     // --------------------------------------------
 
     /**
@@ -154,7 +183,8 @@ namespace nest
       Parameters_();
       void get(DictionaryDatum&) const;
       void set(const DictionaryDatum&);
-      long_t deliver_interval_; //!< update interval in d_min time steps
+      long_t deliver_interval_; //!< update interval in d_min time steps, 0 for none
+      long_t max_history_;      //!< spikes kept without delivery if deliver_interval_ is 0
     };
 
     //-----------------------------------------------
@@ -162,6 +192,7 @@ namespace nest
     struct Buffers_ {
       RingBuffer neuromodulatory_spikes_; //!< buffer to store incoming spikes
       vector<Connector*> targets_;        //!< vector to store target synapses
+      vector<ConnectionStore*> target_stores_; //!< target synapses in compact connection storage
       vector<spikecounter> spikecounter_; //!< vector to store and deliver spikes
     };
 
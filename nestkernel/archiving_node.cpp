@@ -29,6 +29,7 @@
 
 #include "archiving_node.h"
 #include "dictutils.h"
+#include <limits>
 
 namespace nest {
 
@@ -40,7 +41,12 @@ namespace nest {
     triplet_Kminus_(0.0),
     tau_minus_(20.0),
     tau_minus_triplet_(110.0),
-    last_spike_(-1.0)
+    last_spike_(-1.0),
+    history_(),
+    hist_begin_(0),
+    hist_end_(0),
+    K_cache_t_(-std::numeric_limits<double_t>::max()),
+    K_cache_(0.0)
   {}
 
   nest::Archiving_Node::Archiving_Node(const Archiving_Node& n)
@@ -50,71 +56,96 @@ namespace nest {
      triplet_Kminus_(n.triplet_Kminus_),
      tau_minus_(n.tau_minus_),
      tau_minus_triplet_(n.tau_minus_triplet_),
-     last_spike_(n.last_spike_)
+     last_spike_(n.last_spike_),
+     history_(),
+     hist_begin_(0),
+     hist_end_(0),
+     K_cache_t_(-std::numeric_limits<double_t>::max()),
+     K_cache_(0.0)
   {}
 
   void Archiving_Node::register_stdp_connection(double_t t_first_read)
   {
-    // Mark all entries in the deque, which we will not read in future as read by this input
+    // Mark all entries in the history, which we will not read in future as read by this input
     // input, so that we savely increment the incoming number of
     // connections afterwards without leaving spikes in the history.
     // For details see bug #218. MH 08-04-22
 
-    for ( std::deque<histentry>::iterator runner = history_.begin();
-	  runner != history_.end() && runner->t_ <= t_first_read;
-	  ++runner)
-      (runner->access_counter_)++;
+    const size_t last = find_(t_first_read, true);
+    for ( size_t i = hist_begin_ ; i != last ; ++i )
+      (entry_(i).access_counter_)++;
 
     n_incoming_++;    
   }
  
   void Archiving_Node::unregister_stdp_connection(double_t t_last_read)
   {
-    // Mark all entries in the deque we have read as unread 
+    // Mark all entries in the history we have read as unread 
     // so that we can savely decrement the incoming number of
     // connections afterwards without loosing entries, which
     // are still needed. For details see bug #218. MH 08-04-22
 
-    for ( std::deque<histentry>::iterator runner = history_.begin();
-	  runner != history_.end() && runner->t_ <= t_last_read;
-	  ++runner)
-      (runner->access_counter_)--;
+    const size_t last = find_(t_last_read, true);
+    for ( size_t i = hist_begin_ ; i != last ; ++i )
+      (entry_(i).access_counter_)--;
 
     n_incoming_--;
   }
 
-  double_t nest::Archiving_Node::get_K_value(double_t t)
+  size_t nest::Archiving_Node::find_(double_t t, bool after) const
   {
-    if (history_.empty()) return Kminus_;
-    int i = history_.size() - 1;
-    while (i >= 0)
+    // entries are ordered by time
+    size_t lo = hist_begin_;
+    size_t hi = hist_end_;
+    while ( lo < hi )
       {
-	if (t > history_[i].t_)
-	  return (history_[i].Kminus_*std::exp((history_[i].t_ - t)/tau_minus_));
-	i--;
+	const size_t mid = lo + (hi - lo) / 2;
+	const double_t t_mid = entry_(mid).t_;
+	if ( t_mid < t || ( after && t_mid == t ) )
+	  lo = mid + 1;
+	else
+	  hi = mid;
       }
-    return 0;
+    return lo;
+  }
+
+  double_t nest::Archiving_Node::get_K_value(double_t t)
+  {
+    if (hist_begin_ == hist_end_) return Kminus_;
+
+    if (t == K_cache_t_) return K_cache_;
+    K_cache_t_ = t;
+
+    // the trace after the most recent spike is needed most often
+    const histentry& last = entry_(hist_end_ - 1);
+    if (t > last.t_)
+      return K_cache_ = (last.Kminus_*std::exp((last.t_ - t)/tau_minus_));
+
+    // latest entry with t_ < t
+    const size_t i = find_(t, false);
+    if (i == hist_begin_)
+      return K_cache_ = 0;
+    const histentry& h = entry_(i - 1);
+    return K_cache_ = (h.Kminus_*std::exp((h.t_ - t)/tau_minus_));
   }
 
   void nest::Archiving_Node::get_K_values(double_t t, double_t& K_value, double_t& triplet_K_value)
   {
     // case when the neuron has not yet spiked
-    if (history_.empty()) {
+    if (hist_begin_ == hist_end_) {
       triplet_K_value = triplet_Kminus_;
       K_value = Kminus_; 
       return;
     }
-    // case 
-    int i = history_.size() - 1;
-    while (i >= 0)
-      {
-	if (t > history_[i].t_) {
-	  triplet_K_value = (history_[i].triplet_Kminus_*std::exp((history_[i].t_ - t)/tau_minus_triplet_));
-	  K_value = (history_[i].Kminus_*std::exp((history_[i].t_ - t)/tau_minus_));
-	  return;
-	}
-	i--;
-      }
+
+    // latest entry with t_ < t
+    const size_t i = find_(t, false);
+    if (i != hist_begin_) {
+      const histentry& h = entry_(i - 1);
+      triplet_K_value = (h.triplet_Kminus_*std::exp((h.t_ - t)/tau_minus_triplet_));
+      K_value = (h.Kminus_*std::exp((h.t_ - t)/tau_minus_));
+      return;
+    }
 
     // we only get here if t< time of all spikes in history)
 
@@ -124,27 +155,33 @@ namespace nest {
   }
 
   void nest::Archiving_Node::get_history(double_t t1, double_t t2,
-				   std::deque<histentry>::iterator* start,
-				   std::deque<histentry>::iterator* finish)
+				   history_iterator* start,
+				   history_iterator* finish)
   {
-    *finish = history_.end();
-    if (history_.empty())
-      {
-	*start = *finish;
-	return;
-      }
-    else
+    histentry* const buf = history_.empty() ? 0 : &history_[0];
+    const size_t mask = history_.size() - 1;
+
+    size_t i = find_(t1, true);
+    *start = history_iterator(buf, mask, i);
+    for ( ; i != hist_end_ && entry_(i).t_ <= t2 ; ++i )
+      (entry_(i).access_counter_)++;
+    *finish = history_iterator(buf, mask, i);
+  }
+
+  void nest::Archiving_Node::push_entry_(const histentry& h)
+  {
+    if ( hist_end_ - hist_begin_ == history_.size() )
       {
-	std::deque<histentry>::iterator runner = history_.begin();
-	while ((runner != history_.end()) && (runner->t_ <= t1)) ++runner;
-	*start = runner;
-	while ((runner != history_.end()) && (runner->t_ <= t2))
-	  {
-	    (runner->access_counter_)++;
-	    ++runner;
-	  }
-	*finish = runner;
+	// full: double the capacity, keeping the running numbers
+	std::vector<histentry> grown(history_.empty() ? 8 : 2 * history_.size(),
+				     histentry(0.0, 0.0, 0.0, 0));
+	const size_t mask = grown.size() - 1;
+	for ( size_t i = hist_begin_ ; i != hist_end_ ; ++i )
+	  grown[i & mask] = entry_(i);
+	history_.swap(grown);
       }
+    entry_(hist_end_) = h;
+    ++hist_end_;
   }
 
   void nest::Archiving_Node::set_spiketime(Time const & t_sp)
@@ -153,10 +190,10 @@ namespace nest {
       {
 	  // prune all spikes from history which are no longer needed
           // except the penultimate one. we might still need it.
-	  while (history_.size() > 1)
+	  while (hist_end_ - hist_begin_ > 1)
 	  {
-	      if (history_.front().access_counter_ >= n_incoming_)
-		  history_.pop_front();
+	      if (entry_(hist_begin_).access_counter_ >= n_incoming_)
+		  ++hist_begin_;
 	      else
 		break;		
 	  }
@@ -164,7 +201,8 @@ namespace nest {
 	  Kminus_ = Kminus_ * std::exp((last_spike_ - t_sp.get_ms())/tau_minus_) + 1.0;
 	  triplet_Kminus_ = triplet_Kminus_ * std::exp((last_spike_ - t_sp.get_ms())/tau_minus_triplet_) + 1.0;
 	  last_spike_ = t_sp.get_ms();
-	  history_.push_back( histentry( last_spike_, Kminus_, triplet_Kminus_,0) );
+	  push_entry_( histentry( last_spike_, Kminus_, triplet_Kminus_,0) );
+	  K_cache_t_ = -std::numeric_limits<double_t>::max();
       }
       else
       {
@@ -178,7 +216,7 @@ namespace nest {
     def<double>(d, names::tau_minus, tau_minus_);
     def<double>(d, names::tau_minus_triplet, tau_minus_triplet_);
 #ifdef DEBUG_ARCHIVER
-    def<int>(d, names::archiver_length, history_.size());
+    def<int>(d, names::archiver_length, hist_end_ - hist_begin_);
 #endif
   }
 
@@ -195,6 +233,7 @@ namespace nest {
 
     tau_minus_ = new_tau_minus;
     tau_minus_triplet_ = new_tau_minus_triplet;
+    K_cache_t_ = -std::numeric_limits<double_t>::max();
 
     // check, if to clear spike history and K_minus
     bool clear = false;
@@ -209,6 +248,8 @@ namespace nest {
       Kminus_ = 0.0;
       triplet_Kminus_ = 0.0;
       history_.clear();
+      hist_begin_ = hist_end_ = 0;
+      K_cache_t_ = -std::numeric_limits<double_t>::max();
   }
 
 } // of namespace nest
@@ -36,7 +36,7 @@
 #include "dictdatum.h"
 #include "nest_time.h"
 #include "histentry.h"
-#include <deque>
+#include <vector>
 
 #define DEBUG_ARCHIVER 1
 
@@ -46,6 +46,15 @@ namespace nest {
  * \class Archiving_Node
  * a node which archives spike history for the purposes of
  * timing dependent plasticity
+ *
+ * The history is kept in a circular buffer whose capacity is a power of
+ * two and which is doubled when it is full. Entries are addressed by
+ * their running number, so that the entries needed by a synapse can be
+ * found by bisection instead of a linear scan from the oldest entry.
+ * Entries are still removed from the front once all incoming STDP
+ * connections have read them. The Kminus trace returned last is cached,
+ * since all synapses transmitting spikes with the same delay at the same
+ * time ask for the same value.
  */
   class Archiving_Node: 
     public Node 
@@ -82,19 +91,20 @@ namespace nest {
   void get_K_values(double_t t, double_t& Kminus, double_t& triplet_Kminus); 
 
   /**
-   * \fn double_t get_triplet_K_value(std::deque<histentry>::iterator &iter)
+   * \fn double_t get_triplet_K_value(const history_iterator &iter)
    * return the triplet Kminus value for the associated iterator.
    */
 
-  double_t get_triplet_K_value(const std::deque<histentry>::iterator &iter);
+  double_t get_triplet_K_value(const history_iterator &iter);
   
   /**
-   * \fn void get_history(long_t t1, long_t t2, std::deque<Archiver::histentry>::iterator* start, std::deque<Archiver::histentry>::iterator* finish)
+   * \fn void get_history(double_t t1, double_t t2, history_iterator* start, history_iterator* finish)
    * return the spike times (in steps) of spikes which occurred in the range (t1,t2].
+   * The iterators are invalidated by the next call to set_spiketime().
    */
   void get_history(double_t t1, double_t t2, 
-                   std::deque<histentry>::iterator* start,
-  		   std::deque<histentry>::iterator* finish);
+                   history_iterator* start,
+  		   history_iterator* finish);
 
   /**
    * Register a new incoming STDP connection.
@@ -136,6 +146,20 @@ namespace nest {
 
  private:
 
+  /**
+   * return the running number of the first entry in the history
+   * with t_ > t (after) or t_ >= t (not after), or hist_end_ if there
+   * is none. The history is searched by bisection.
+   */
+  size_t find_(double_t t, bool after) const;
+
+  // return the entry with running number i
+  histentry& entry_(size_t i) { return history_[i & (history_.size() - 1)]; }
+  const histentry& entry_(size_t i) const { return history_[i & (history_.size() - 1)]; }
+
+  // append entry, doubling the capacity of the buffer if necessary
+  void push_entry_(const histentry&);
+
   // number of incoming connections from stdp connectors.
   // needed to determine, if every incoming connection has
   // read the spikehistory for a given point in time
@@ -154,8 +178,19 @@ namespace nest {
 
   double_t last_spike_;
 
-  // spiking history needed by stdp synapses
-  std::deque<histentry> history_;
+  // spiking history needed by stdp synapses, circular buffer
+  // whose size is a power of two
+  std::vector<histentry> history_;
+
+  // running numbers of the oldest entry and one past the newest entry
+  size_t hist_begin_;
+  size_t hist_end_;
+
+  // result of the last call to get_K_value(), which is reused by all
+  // synapses that deliver a spike with the same delay at the same time;
+  // invalidated by every change of the history
+  double_t K_cache_t_;
+  double_t K_cache_;
 
 };
   
@@ -0,0 +1,379 @@
+/*
+ *  async_writer.cpp
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "async_writer.h"
+#include "exceptions.h"
+
+#include <cassert>
+#include <iostream>
+#include <cstring>
+
+#ifdef HAVE_ASYNC_WRITER
+// global handler function of the writer thread
+extern "C"
+void* nest_async_writer_handler(void* w)
+{
+  static_cast<nest::AsyncWriter*>(w)->run();
+  return NULL;
+}
+#endif
+
+/* ----------------------------------------------------------------
+ * Chunks and queues
+ * ---------------------------------------------------------------- */
+
+nest::AsyncWriter::Chunk::Chunk()
+  : target_(0),
+    data_(chunk_size),
+    size_(0)
+{}
+
+nest::AsyncWriter::Queue_::Queue_(size_t capacity)
+  : ring_(capacity, 0),
+    head_(0),
+    tail_(0)
+{
+  assert((capacity & (capacity - 1)) == 0);
+}
+
+bool nest::AsyncWriter::Queue_::push(Chunk* c)
+{
+  const size_t tail = tail_;
+  if (tail - head_ == ring_.size())
+    return false;
+
+  ring_[tail & (ring_.size() - 1)] = c;
+  __sync_synchronize();  // publish the entry before the new tail
+  tail_ = tail + 1;
+  return true;
+}
+
+nest::AsyncWriter::Chunk* nest::AsyncWriter::Queue_::pop()
+{
+  const size_t head = head_;
+  if (head == tail_)
+    return 0;
+
+  __sync_synchronize();  // read the entry only after the tail
+  Chunk* c = ring_[head & (ring_.size() - 1)];
+  __sync_synchronize();  // release the slot only after reading it
+  head_ = head + 1;
+  return c;
+}
+
+nest::AsyncWriter::Lane_::Lane_()
+  : full_(256),
+    free_(256),
+    written_(0)
+{}
+
+nest::AsyncWriter::Lane_::~Lane_()
+{
+  // all pushed chunks have been written when lanes are destroyed
+  assert(written_ == full_.pushed());
+  while (Chunk* c = free_.pop())
+    delete c;
+}
+
+/* ----------------------------------------------------------------
+ * Writer
+ * ---------------------------------------------------------------- */
+
+nest::AsyncWriter::AsyncWriter()
+  : lanes_(),
+    stop_(false),
+    running_(false)
+{
+#ifdef HAVE_ASYNC_WRITER
+  pthread_mutex_init(&mutex_, NULL);
+  pthread_cond_init(&work_, NULL);
+  pthread_cond_init(&done_, NULL);
+#endif
+}
+
+nest::AsyncWriter::~AsyncWriter()
+{
+  stop();
+  for (size_t t = 0; t < lanes_.size(); ++t)
+    delete lanes_[t];
+
+#ifdef HAVE_ASYNC_WRITER
+  pthread_cond_destroy(&done_);
+  pthread_cond_destroy(&work_);
+  pthread_mutex_destroy(&mutex_);
+#endif
+}
+
+void nest::AsyncWriter::start(thread n_threads)
+{
+  if (running_ && lanes_.size() == static_cast<size_t>(n_threads))
+    return;
+  stop();
+
+  if (lanes_.size() != static_cast<size_t>(n_threads))
+  {
+    for (size_t t = 0; t < lanes_.size(); ++t)
+      delete lanes_[t];
+    lanes_.resize(n_threads);
+    for (size_t t = 0; t < lanes_.size(); ++t)
+      lanes_[t] = new Lane_();
+  }
+
+#ifdef HAVE_ASYNC_WRITER
+  stop_ = false;
+  __sync_synchronize();
+  const int status = pthread_create(&thread_, NULL, nest_async_writer_handler, static_cast<void*>(this));
+  if (status != 0)
+  {
+    std::cerr << "Error creating I/O writer thread. Error code "
+              << status << std::endl
+              << "which is: " << std::strerror(status) << std::endl;
+    throw PthreadException(status);
+  }
+  running_ = true;
+#endif
+}
+
+void nest::AsyncWriter::stop()
+{
+  if (!running_)
+    return;
+
+#ifdef HAVE_ASYNC_WRITER
+  pthread_mutex_lock(&mutex_);
+  stop_ = true;
+  pthread_cond_signal(&work_);
+  pthread_mutex_unlock(&mutex_);
+  pthread_join(thread_, NULL);
+#endif
+  running_ = false;
+}
+
+bool nest::AsyncWriter::push(thread t, Chunk* c)
+{
+  assert(running_);
+  if (!lanes_[t]->full_.push(c))
+    return false;
+
+#ifdef HAVE_ASYNC_WRITER
+  // Signalling under the mutex cannot get lost: the writer checks the
+  // queues while holding the mutex before it goes to sleep.
+  pthread_mutex_lock(&mutex_);
+  pthread_cond_signal(&work_);
+  pthread_mutex_unlock(&mutex_);
+#endif
+  return true;
+}
+
+nest::AsyncWriter::Chunk* nest::AsyncWriter::get_chunk(thread t)
+{
+  Chunk* c = 0;
+  if (static_cast<size_t>(t) < lanes_.size())
+    c = lanes_[t]->free_.pop();
+  return c != 0 ? c : new Chunk();
+}
+
+void nest::AsyncWriter::wait(thread t)
+{
+  if (!running_)
+    return;
+
+#ifdef HAVE_ASYNC_WRITER
+  Lane_& lane = *lanes_[t];
+  pthread_mutex_lock(&mutex_);
+  while (lane.written_ != lane.full_.pushed())
+    pthread_cond_wait(&done_, &mutex_);
+  pthread_mutex_unlock(&mutex_);  // also makes all effects of the writes visible
+#endif
+}
+
+bool nest::AsyncWriter::has_work_() const
+{
+  for (size_t t = 0; t < lanes_.size(); ++t)
+    if (lanes_[t]->written_ != lanes_[t]->full_.pushed())
+      return true;
+  return false;
+}
+
+void nest::AsyncWriter::run()
+{
+#ifdef HAVE_ASYNC_WRITER
+  while (true)
+  {
+    // Sleep until a chunk is pushed or stop() is called. The stop flag is
+    // read before looking at the queues: all chunks pushed before stop()
+    // was called are then seen by the loop below.
+    pthread_mutex_lock(&mutex_);
+    while (!stop_ && !has_work_())
+      pthread_cond_wait(&work_, &mutex_);
+    const bool stopping = stop_;
+    pthread_mutex_unlock(&mutex_);
+
+    for (size_t t = 0; t < lanes_.size(); ++t)
+    {
+      Lane_& lane = *lanes_[t];
+      bool wrote = false;
+      while (Chunk* c = lane.full_.pop())
+      {
+        c->target_->write(&c->data_[0], c->size_);
+        c->size_ = 0;
+        // enlarged chunks are not kept, so that memory use stays bounded
+        if (c->data_.size() > chunk_size || !lane.free_.push(c))
+          delete c;
+        __sync_synchronize();
+        ++lane.written_;
+        wrote = true;
+      }
+
+      if (wrote)
+      {
+        pthread_mutex_lock(&mutex_);
+        pthread_cond_broadcast(&done_);
+        pthread_mutex_unlock(&mutex_);
+      }
+    }
+
+    if (stopping)
+      break;
+  }
+#endif
+}
+
+/* ----------------------------------------------------------------
+ * Stream buffer
+ * ---------------------------------------------------------------- */
+
+nest::AsyncStreamBuffer::AsyncStreamBuffer()
+  : std::streambuf(),
+    writer_(0),
+    t_(0),
+    target_(0),
+    chunk_(0)
+{}
+
+nest::AsyncStreamBuffer::~AsyncStreamBuffer()
+{
+  close();
+}
+
+void nest::AsyncStreamBuffer::open(AsyncWriter& writer, thread t, std::ostream& target)
+{
+  close();
+
+  writer_ = &writer;
+  t_ = t;
+  target_ = &target;
+  chunk_ = writer_->get_chunk(t_);
+  chunk_->target_ = target_;
+  set_put_area_(0);
+}
+
+void nest::AsyncStreamBuffer::wait()
+{
+  if (chunk_ == 0)
+    return;
+
+  hand_over_();
+  writer_->wait(t_);
+
+  // If the queue was full, the output is still in the chunk. All earlier
+  // chunks have been written now, so it can be written in order here.
+  if (pptr() != pbase())
+  {
+    target_->write(&chunk_->data_[0], pptr() - pbase());
+    set_put_area_(0);
+  }
+}
+
+void nest::AsyncStreamBuffer::close()
+{
+  if (chunk_ == 0)
+    return;
+
+  wait();
+  delete chunk_;
+  chunk_ = 0;
+  target_ = 0;
+  setp(0, 0);
+}
+
+nest::AsyncStreamBuffer::int_type nest::AsyncStreamBuffer::overflow(int_type c)
+{
+  if (chunk_ == 0)
+    return traits_type::eof();
+
+  hand_over_();
+  if (!traits_type::eq_int_type(c, traits_type::eof()))
+    return sputc(traits_type::to_char_type(c));
+  return traits_type::not_eof(c);
+}
+
+int nest::AsyncStreamBuffer::sync()
+{
+  if (chunk_ != 0)
+    hand_over_();
+  return 0;
+}
+
+void nest::AsyncStreamBuffer::hand_over_()
+{
+  chunk_->size_ = pptr() - pbase();
+  if (chunk_->size_ == 0)
+    return;
+
+  if (!writer_->is_running())
+  {
+    target_->write(&chunk_->data_[0], chunk_->size_);
+    set_put_area_(0);
+  }
+  else if (writer_->push(t_, chunk_))
+  {
+    chunk_ = writer_->get_chunk(t_);
+    chunk_->target_ = target_;
+    set_put_area_(0);
+  }
+  else if (pptr() == epptr())
+  {
+    if (chunk_->data_.size() < AsyncWriter::max_chunk_size)
+    {
+      // the writer is behind: keep collecting in a larger chunk
+      const size_t size = 2 * chunk_->data_.size();
+      chunk_->data_.resize(size < AsyncWriter::max_chunk_size ? size : AsyncWriter::max_chunk_size);
+      set_put_area_(chunk_->size_);
+    }
+    else
+    {
+      // the chunk cannot grow further: wait until the writer has written
+      // all earlier chunks of this thread and write the chunk in order here
+      writer_->wait(t_);
+      target_->write(&chunk_->data_[0], chunk_->size_);
+      set_put_area_(0);
+    }
+  }
+}
+
+void nest::AsyncStreamBuffer::set_put_area_(size_t offset)
+{
+  char* begin = &chunk_->data_[0];
+  setp(begin, begin + chunk_->data_.size());
+  pbump(static_cast<int>(offset));
+}
@@ -0,0 +1,230 @@
+/*
+ *  async_writer.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef ASYNC_WRITER_H
+#define ASYNC_WRITER_H
+
+#include "config.h"
+
+#if defined(HAVE_PTHREADS) || defined(_OPENMP)
+// OpenMP implementations on all supported platforms are based on pthreads
+#define HAVE_ASYNC_WRITER
+#ifdef HAVE_PTHREAD_IGNORED
+#undef __PURE_CNAME
+#include <pthread.h>
+#define __PURE_CNAME
+#else
+#include <pthread.h>
+#endif
+#endif
+
+#include <vector>
+#include <ostream>
+#include <streambuf>
+#include "nest.h"
+
+namespace nest
+{
+
+  /**
+   * Background thread writing the file output of recording devices.
+   *
+   * Each simulation thread hands filled chunks of output to the writer
+   * through a single-producer single-consumer queue of its own. Pushing
+   * a chunk never blocks; it takes a lock only to wake the writer thread,
+   * which sleeps on a condition variable while all queues are empty. The
+   * writer thread takes the chunks from all queues, writes them to their
+   * target streams and returns the empty chunks through a second queue
+   * per simulation thread, so that output is recorded without memory
+   * allocation once enough chunks exist. Chunks of the same simulation
+   * thread are written in the order in which they were pushed.
+   *
+   * The Scheduler starts the writer at the beginning of each call to
+   * Simulate if the kernel property async_io is set, and stops it after
+   * all nodes have been finalized. While the writer is not running, or if
+   * no thread library is available, output is written synchronously.
+   *
+   * @see AsyncStreamBuffer, RecordingDevice
+   */
+  class AsyncWriter
+  {
+  public:
+
+    /**
+     * Block of output for one target stream.
+     */
+    struct Chunk
+    {
+      std::ostream*     target_;  //!< stream to write the data to
+      std::vector<char> data_;    //!< the data, only the first size_ bytes are valid
+      size_t            size_;    //!< number of valid bytes
+
+      Chunk();
+    };
+
+    //! Initial capacity of a chunk in bytes
+    static const size_t chunk_size = 65536;
+
+    //! Capacity up to which a chunk is enlarged while the queue is full
+    static const size_t max_chunk_size = 16 * chunk_size;
+
+    AsyncWriter();
+    ~AsyncWriter();
+
+    /**
+     * Start the writer thread for n_threads simulation threads.
+     */
+    void start(thread n_threads);
+
+    /**
+     * Write all chunks that have been pushed and stop the writer thread.
+     */
+    void stop();
+
+    bool is_running() const { return running_; }
+
+    /**
+     * Hand a chunk of simulation thread t to the writer.
+     * @return false if the queue of t is full; the caller keeps the chunk.
+     */
+    bool push(thread t, Chunk* c);
+
+    /**
+     * Return an empty chunk for simulation thread t.
+     */
+    Chunk* get_chunk(thread t);
+
+    /**
+     * Wait until all chunks pushed by simulation thread t have been written.
+     */
+    void wait(thread t);
+
+    /**
+     * Main loop of the writer thread.
+     */
+    void run();
+
+  private:
+
+    /**
+     * Lock-free queue of chunks for one producer and one consumer.
+     */
+    class Queue_
+    {
+    public:
+      explicit Queue_(size_t capacity);
+
+      bool push(Chunk*);    //!< called by the producer only
+      Chunk* pop();         //!< called by the consumer only
+      size_t pushed() const { return tail_; }
+
+    private:
+      std::vector<Chunk*> ring_;  //!< ring buffer, size is a power of two
+      volatile size_t head_;      //!< number of chunks popped so far
+      volatile size_t tail_;      //!< number of chunks pushed so far
+    };
+
+    /**
+     * Queues of one simulation thread.
+     */
+    struct Lane_
+    {
+      Queue_ full_;             //!< chunks to write
+      Queue_ free_;             //!< written chunks for reuse
+      volatile size_t written_; //!< number of chunks written from full_
+
+      Lane_();
+      ~Lane_();
+    };
+
+    /**
+     * Return true if any queue holds chunks that have not been written.
+     */
+    bool has_work_() const;
+
+    std::vector<Lane_*> lanes_;
+    volatile bool stop_;   //!< signals the writer thread to finish
+    bool running_;
+
+#ifdef HAVE_ASYNC_WRITER
+    pthread_t       thread_;
+    pthread_mutex_t mutex_;   //!< protects waiting on work_ and done_
+    pthread_cond_t  work_;    //!< signals a pushed chunk or stop_ to the writer
+    pthread_cond_t  done_;    //!< signals written chunks to waiting threads
+#endif
+  };
+
+  /**
+   * Stream buffer collecting output in chunks for the AsyncWriter.
+   *
+   * The buffer uses the current chunk as its put area. When the chunk is
+   * full or the stream is flushed, the chunk is handed to the writer, or,
+   * while the writer is not running, written to the target directly. If
+   * the queue of the writer is full, the chunk is enlarged instead, so
+   * that the simulation thread does not wait for the file system. A chunk
+   * that has reached AsyncWriter::max_chunk_size is written directly once
+   * the writer has written all earlier chunks of the thread.
+   */
+  class AsyncStreamBuffer : public std::streambuf
+  {
+  public:
+    AsyncStreamBuffer();
+    ~AsyncStreamBuffer();
+
+    /**
+     * Collect output for target, to be written by writer on behalf of
+     * simulation thread t.
+     */
+    void open(AsyncWriter& writer, thread t, std::ostream& target);
+
+    /**
+     * Hand over all output and wait until it has been written, so that
+     * the target can be flushed or closed. Output that the writer cannot
+     * take because its queue is full is written directly.
+     */
+    void wait();
+
+    /**
+     * Write all output and detach from the target.
+     */
+    void close();
+
+  protected:
+    int_type overflow(int_type c);
+    int sync();
+
+  private:
+    AsyncStreamBuffer(const AsyncStreamBuffer&);            //!< not implemented
+    AsyncStreamBuffer& operator=(const AsyncStreamBuffer&); //!< not implemented
+
+    void hand_over_();
+    void set_put_area_(size_t offset);
+
+    AsyncWriter*        writer_;
+    thread              t_;
+    std::ostream*       target_;
+    AsyncWriter::Chunk* chunk_;
+  };
+
+}
+
+#endif
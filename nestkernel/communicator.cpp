@@ -29,6 +29,7 @@
 #include <mpi.h>
 #endif /* #ifdef HAVE_MPI */
 
+#include <cstring>
 #include <limits>
 #include <numeric>
 #include <time.h>
@@ -49,8 +50,11 @@ int nest::Communicator::num_processes_ = 1;
 int nest::Communicator::n_vps_ = 1;
 int nest::Communicator::send_buffer_size_ = 1;
 int nest::Communicator::recv_buffer_size_ = 1;
+int nest::Communicator::min_send_buffer_size_ = 1;
 bool nest::Communicator::initialized_ = false;
 bool nest::Communicator::use_Allgather_ = true;
+bool nest::Communicator::use_Alltoallv_ = false;
+const size_t nest::Communicator::PACKED_HEADER_SIZE;
 
 #ifdef HAVE_MPI
 
@@ -66,10 +70,25 @@ MPI::Intracomm comm=0;
 MPI_Comm comm=0;
 #endif /* #ifdef HAVE_MUSIC */
 
+// Pending exchange started by start_packed() and the number of bytes
+// of the local packed buffer in use.
+#if MPI_VERSION >= 3
+MPI_Request packed_request = MPI_REQUEST_NULL;
+#endif
+nest::uint_t packed_used = 0;
+
+// Number of exchanges in a row in which all packed buffers used less
+// than a quarter of the block. The block is only shrunk after
+// PACKED_SHRINK_DELAY of them, so that a single quiet slice does not
+// undo the growth caused by a burst of spikes.
+nest::uint_t packed_quiet_exchanges = 0;
+const nest::uint_t PACKED_SHRINK_DELAY = 16;
+
 template<> MPI_Datatype MPI_Type<nest::int_t>::type = MPI_INT;
 template<> MPI_Datatype MPI_Type<nest::double_t>::type = MPI_DOUBLE;
 template<> MPI_Datatype MPI_Type<nest::long_t>::type = MPI_LONG;
 template<> MPI_Datatype MPI_Type<nest::uint_t>::type = MPI_INT;
+template<> MPI_Datatype MPI_Type<unsigned char>::type = MPI_BYTE;
 
 MPI_Datatype MPI_OFFGRID_SPIKE = 0;
 
@@ -155,6 +174,10 @@ void nest::Communicator::init(int* argc, char** argv[])
  */
 void nest::Communicator::finalize()
 {
+#if MPI_VERSION >= 3
+  // complete an exchange still in flight, see start_packed()
+  MPI_Wait(&packed_request, MPI_STATUS_IGNORE);
+#endif
   MPI_Type_free(&MPI_OFFGRID_SPIKE);
 
   int finalized;
@@ -463,6 +486,166 @@ void nest::Communicator::communicate_Allgather(std::vector<T>& send_buffer,
     }
 }
 
+void nest::Communicator::communicate_packed(std::vector<unsigned char>& send_buffer,
+                                            std::vector<unsigned char>& recv_buffer,
+                                            std::vector<int>& displacements,
+                                            std::vector<int>& recv_counts)
+{
+  start_packed(send_buffer, recv_buffer);
+  finish_packed(send_buffer, recv_buffer, displacements, recv_counts);
+}
+
+void nest::Communicator::start_packed(std::vector<unsigned char>& send_buffer,
+                                      std::vector<unsigned char>& recv_buffer)
+{
+  assert(send_buffer.size() >= PACKED_HEADER_SIZE);
+#if MPI_VERSION >= 3
+  assert(packed_request == MPI_REQUEST_NULL);
+#endif
+
+  if (num_processes_ == 1)    //purely thread-based
+    return;
+
+  // the header holds the number of bytes in use, including the header
+  const uint_t used = send_buffer.size();
+  std::memcpy(&send_buffer[0], &used, sizeof(uint_t));
+  if (used < static_cast<uint_t>(send_buffer_size_))
+    send_buffer.resize(send_buffer_size_, 0);
+  packed_used = used;
+
+  // if our data does not fit, only the first block is sent, and the
+  // header tells the others about the overflow
+  recv_buffer.resize(recv_buffer_size_);
+#if MPI_VERSION >= 3
+  MPI_Iallgather(&send_buffer[0], send_buffer_size_, MPI_BYTE,
+		 &recv_buffer[0], send_buffer_size_, MPI_BYTE, comm, &packed_request);
+#else
+  MPI_Allgather(&send_buffer[0], send_buffer_size_, MPI_BYTE,
+		&recv_buffer[0], send_buffer_size_, MPI_BYTE, comm);
+#endif
+}
+
+void nest::Communicator::finish_packed(std::vector<unsigned char>& send_buffer,
+                                       std::vector<unsigned char>& recv_buffer,
+                                       std::vector<int>& displacements,
+                                       std::vector<int>& recv_counts)
+{
+  if (num_processes_ == 1)    //purely thread-based
+    {
+      displacements[0] = PACKED_HEADER_SIZE;
+      recv_counts[0] = send_buffer.size() - PACKED_HEADER_SIZE;
+      recv_buffer.swap(send_buffer);
+      return;
+    }
+
+#if MPI_VERSION >= 3
+  MPI_Wait(&packed_request, MPI_STATUS_IGNORE);
+#endif
+
+  uint_t max_used = 0;
+  bool overflow = false;
+  for (int pid = 0; pid < num_processes_; ++pid)
+    {
+      uint_t n;
+      std::memcpy(&n, &recv_buffer[pid * send_buffer_size_], sizeof(uint_t));
+      recv_counts[pid] = n;
+      overflow = overflow || n > static_cast<uint_t>(send_buffer_size_);
+      max_used = std::max(max_used, n);
+    }
+
+  int disp = 0;
+  for (int pid = 0; pid < num_processes_; ++pid)
+    {
+      displacements[pid] = overflow ? disp : pid * send_buffer_size_;
+      disp += recv_counts[pid];
+    }
+
+  // The first block of every buffer has arrived already, so the second
+  // round carries only the bytes beyond it. The buffers are then joined
+  // in recv_buffer.
+  if (overflow)
+    {
+      const int block = send_buffer_size_;
+      std::vector<int> tail_counts(num_processes_);
+      std::vector<int> tail_displacements(num_processes_);
+      int tail_disp = 0;
+      for (int pid = 0; pid < num_processes_; ++pid)
+	{
+	  tail_counts[pid] = std::max(recv_counts[pid] - block, 0);
+	  tail_displacements[pid] = tail_disp;
+	  tail_disp += tail_counts[pid];
+	}
+
+      std::vector<unsigned char> tails(tail_disp);
+      MPI_Allgatherv(&send_buffer[0] + block, tail_counts[rank_], MPI_BYTE,
+		     &tails[0], &tail_counts[0], &tail_displacements[0], MPI_BYTE, comm);
+
+      std::vector<unsigned char> joined(disp);
+      for (int pid = 0; pid < num_processes_; ++pid)
+	{
+	  const int head = recv_counts[pid] - tail_counts[pid];
+	  std::memcpy(&joined[displacements[pid]], &recv_buffer[pid * block], head);
+	  if (tail_counts[pid] > 0)
+	    std::memcpy(&joined[displacements[pid] + head], &tails[tail_displacements[pid]],
+			tail_counts[pid]);
+	}
+      recv_buffer.swap(joined);
+    }
+
+  for (int pid = 0; pid < num_processes_; ++pid)
+    {
+      displacements[pid] += PACKED_HEADER_SIZE;
+      recv_counts[pid] -= PACKED_HEADER_SIZE;
+    }
+
+  adapt_packed_buffer_size(max_used);
+}
+
+void nest::Communicator::communicate_Alltoallv(std::vector<uint_t>& send_buffer,
+                                               std::vector<int>& send_counts,
+                                               std::vector<uint_t>& recv_buffer,
+                                               std::vector<int>& displacements,
+                                               std::vector<int>& recv_counts)
+{
+  exchange_Alltoallv(send_buffer, send_counts, recv_buffer, displacements, recv_counts);
+}
+
+void nest::Communicator::communicate_Alltoallv(std::vector<unsigned char>& send_buffer,
+                                               std::vector<int>& send_counts,
+                                               std::vector<unsigned char>& recv_buffer,
+                                               std::vector<int>& displacements,
+                                               std::vector<int>& recv_counts)
+{
+  exchange_Alltoallv(send_buffer, send_counts, recv_buffer, displacements, recv_counts);
+}
+
+void nest::Communicator::adapt_packed_buffer_size(uint_t max_used)
+{
+  // All processes see the same headers and thus agree on the new size.
+  // Blocks that are more than three quarters full are grown to leave 50%
+  // headroom. Blocks that were less than a quarter full in the last
+  // PACKED_SHRINK_DELAY exchanges are shrunk to twice the largest
+  // buffer, but not below the size set by set_buffer_sizes(). In
+  // between, the size is kept, so that it does not oscillate.
+  const uint_t size = send_buffer_size_;
+  if (max_used > size - size / 4)
+    {
+      send_buffer_size_ = max_used + max_used / 2;
+      packed_quiet_exchanges = 0;
+    }
+  else if (max_used < size / 4)
+    {
+      if (++packed_quiet_exchanges >= PACKED_SHRINK_DELAY)
+	{
+	  send_buffer_size_ = std::max(2 * static_cast<int>(max_used), min_send_buffer_size_);
+	  packed_quiet_exchanges = 0;
+	}
+    }
+  else
+    packed_quiet_exchanges = 0;
+  recv_buffer_size_ = send_buffer_size_ * num_processes_;
+}
+
 void nest::Communicator::communicate(std::vector<OffGridSpike>& send_buffer, 
                                      std::vector<OffGridSpike>& recv_buffer, 
                                      std::vector<int>& displacements)
@@ -989,6 +1172,53 @@ void nest::Communicator::communicate(std::vector<OffGridSpike>& send_buffer,
   recv_buffer.swap(send_buffer);
 }
 
+/**
+ * communicate packed spikes if compiled without MPI
+ */
+void nest::Communicator::communicate_packed(std::vector<unsigned char>& send_buffer,
+                                            std::vector<unsigned char>& recv_buffer,
+                                            std::vector<int>& displacements,
+                                            std::vector<int>& recv_counts)
+{
+  finish_packed(send_buffer, recv_buffer, displacements, recv_counts);
+}
+
+void nest::Communicator::finish_packed(std::vector<unsigned char>& send_buffer,
+                                       std::vector<unsigned char>& recv_buffer,
+                                       std::vector<int>& displacements,
+                                       std::vector<int>& recv_counts)
+{
+  assert(send_buffer.size() >= PACKED_HEADER_SIZE);
+  displacements[0] = PACKED_HEADER_SIZE;
+  recv_counts[0] = send_buffer.size() - PACKED_HEADER_SIZE;
+  recv_buffer.swap(send_buffer);
+}
+
+/**
+ * communicate (Alltoallv) if compiled without MPI
+ */
+void nest::Communicator::communicate_Alltoallv(std::vector<uint_t>& send_buffer,
+                                               std::vector<int>& send_counts,
+                                               std::vector<uint_t>& recv_buffer,
+                                               std::vector<int>& displacements,
+                                               std::vector<int>& recv_counts)
+{
+  displacements[0] = 0;
+  recv_counts[0] = send_counts[0];
+  recv_buffer.swap(send_buffer);
+}
+
+void nest::Communicator::communicate_Alltoallv(std::vector<unsigned char>& send_buffer,
+                                               std::vector<int>& send_counts,
+                                               std::vector<unsigned char>& recv_buffer,
+                                               std::vector<int>& displacements,
+                                               std::vector<int>& recv_counts)
+{
+  displacements[0] = 0;
+  recv_counts[0] = send_counts[0];
+  recv_buffer.swap(send_buffer);
+}
+
 void nest::Communicator::communicate(std::vector<double_t>& send_buffer,
                                      std::vector<double_t>& recv_buffer,
                                      std::vector<int>& displacements)
@@ -168,6 +168,69 @@ public:
   static void communicate(double_t, std::vector<double_t>&);
   static void communicate(std::vector<int_t>&);
 
+  /**
+   * Exchange the packed spike buffers of all processes.
+   *
+   * The first PACKED_HEADER_SIZE bytes of send_buffer are reserved for
+   * the Communicator, the remainder holds the packed spikes. All
+   * processes exchange blocks of send_buffer_size_ bytes, and the header
+   * of each block tells the receivers how many bytes are in use. If a
+   * process has more data than fits into a block, only the bytes beyond
+   * the block are exchanged in a second round. After each exchange, the
+   * block size is adapted to the largest buffer of all processes, so
+   * that the second round is rarely needed.
+   *
+   * On return, displacements[pid] and recv_counts[pid] are the position
+   * and number of bytes of the packed spikes of process pid in
+   * recv_buffer.
+   */
+  static void communicate_packed(std::vector<unsigned char>& send_buffer,
+                                 std::vector<unsigned char>& recv_buffer,
+                                 std::vector<int>& displacements,
+                                 std::vector<int>& recv_counts);
+
+  /**
+   * Start the exchange of communicate_packed() without waiting for it to
+   * complete. Neither buffer may be touched until finish_packed() has
+   * been called with the same buffers, and no other exchange of packed
+   * buffers may be started in between. If the MPI library does not
+   * support non-blocking collectives, the blocks are exchanged here.
+   */
+  static void start_packed(std::vector<unsigned char>& send_buffer,
+                           std::vector<unsigned char>& recv_buffer);
+
+  /**
+   * Complete the exchange started by start_packed(). On return, the
+   * arguments are set as by communicate_packed().
+   */
+  static void finish_packed(std::vector<unsigned char>& send_buffer,
+                            std::vector<unsigned char>& recv_buffer,
+                            std::vector<int>& displacements,
+                            std::vector<int>& recv_counts);
+
+  /**
+   * Exchange data between pairs of processes.
+   *
+   * send_buffer holds the data for all processes one after the other,
+   * send_counts[pid] elements for process pid. On return, the data
+   * received from process pid is found in recv_buffer at position
+   * displacements[pid], and recv_counts[pid] is its size. Only pairs of
+   * processes with data to exchange communicate, see MPI_Alltoallv.
+   */
+  static void communicate_Alltoallv(std::vector<uint_t>& send_buffer,
+                                    std::vector<int>& send_counts,
+                                    std::vector<uint_t>& recv_buffer,
+                                    std::vector<int>& displacements,
+                                    std::vector<int>& recv_counts);
+  static void communicate_Alltoallv(std::vector<unsigned char>& send_buffer,
+                                    std::vector<int>& send_counts,
+                                    std::vector<unsigned char>& recv_buffer,
+                                    std::vector<int>& displacements,
+                                    std::vector<int>& recv_counts);
+
+  //! Number of bytes at the beginning of a packed buffer used by the Communicator
+  static const size_t PACKED_HEADER_SIZE = sizeof(uint_t);
+
   /**
    * Collect GIDs for all nodes in a given node list across processes.
    * The NodeListType should be one of LocalNodeList, LocalLeafList, LocalChildList.
@@ -203,12 +266,14 @@ public:
   static int get_send_buffer_size();
   static int get_recv_buffer_size();
   static bool get_use_Allgather();
+  static bool get_use_Alltoallv();
   static bool get_initialized();
   static int get_num_spikes();
    
   static void set_num_threads(thread num_threads);
   static void set_buffer_sizes(int send_buffer_size, int recv_buffer_size);
   static void set_use_Allgather(bool use_Allgather);
+  static void set_use_Alltoallv(bool use_Alltoallv);
 
 private:
 
@@ -219,8 +284,10 @@ private:
   static int n_vps_;             //!< the number of virtual processes
   static int send_buffer_size_;  //!< expected size of send buffer
   static int recv_buffer_size_;  //!< size of receive buffer
+  static int min_send_buffer_size_;  //!< send buffer size set by set_buffer_sizes()
   static bool initialized_;      //!< whether MPI is initialized
   static bool use_Allgather_;    //!< using Allgather communication
+  static bool use_Alltoallv_;    //!< using sparse Alltoallv spike exchange
   static int num_spikes_;
   
   static std::vector<int> comm_step_;  //!< array containing communication partner for each step.
@@ -228,6 +295,13 @@ private:
 
   static void init_communication();
 
+  /**
+   * Adapt send_buffer_size_ for packed buffers to the largest number
+   * of bytes used by any process in the last exchange. The size never
+   * drops below min_send_buffer_size_.
+   */
+  static void adapt_packed_buffer_size(uint_t max_used);
+
   static void communicate_Allgather(std::vector<uint_t>& send_buffer,
                                     std::vector<uint_t>& recv_buffer,
                                     std::vector<int>& displacements);
@@ -236,6 +310,13 @@ private:
                                     std::vector<int>& displacements);
   static void communicate_Allgather(std::vector<int_t>&);
 
+  template <typename T>
+  static void exchange_Alltoallv(std::vector<T>& send_buffer,
+                                 std::vector<int>& send_counts,
+                                 std::vector<T>& recv_buffer,
+                                 std::vector<int>& displacements,
+                                 std::vector<int>& recv_counts);
+
   template <typename T>
   static void communicate_Allgatherv(std::vector<T>& send_buffer,
                                      std::vector<T>& recv_buffer,
@@ -321,6 +402,55 @@ public:
   static void communicate(double_t, std::vector<double_t>&);
   static void communicate(std::vector<int_t>&) {}
 
+  /**
+   * Exchange the packed spike buffers of all processes.
+   *
+   * The first PACKED_HEADER_SIZE bytes of send_buffer are reserved for
+   * the Communicator, the remainder holds the packed spikes. All
+   * processes exchange blocks of send_buffer_size_ bytes, and the header
+   * of each block tells the receivers how many bytes are in use. If a
+   * process has more data than fits into a block, only the bytes beyond
+   * the block are exchanged in a second round. After each exchange, the
+   * block size is adapted to the largest buffer of all processes, so
+   * that the second round is rarely needed.
+   *
+   * On return, displacements[pid] and recv_counts[pid] are the position
+   * and number of bytes of the packed spikes of process pid in
+   * recv_buffer.
+   */
+  static void communicate_packed(std::vector<unsigned char>& send_buffer,
+                                 std::vector<unsigned char>& recv_buffer,
+                                 std::vector<int>& displacements,
+                                 std::vector<int>& recv_counts);
+  static void start_packed(std::vector<unsigned char>&, std::vector<unsigned char>&) {}
+  static void finish_packed(std::vector<unsigned char>& send_buffer,
+                            std::vector<unsigned char>& recv_buffer,
+                            std::vector<int>& displacements,
+                            std::vector<int>& recv_counts);
+
+  /**
+   * Exchange data between pairs of processes.
+   *
+   * send_buffer holds the data for all processes one after the other,
+   * send_counts[pid] elements for process pid. On return, the data
+   * received from process pid is found in recv_buffer at position
+   * displacements[pid], and recv_counts[pid] is its size. Only pairs of
+   * processes with data to exchange communicate, see MPI_Alltoallv.
+   */
+  static void communicate_Alltoallv(std::vector<uint_t>& send_buffer,
+                                    std::vector<int>& send_counts,
+                                    std::vector<uint_t>& recv_buffer,
+                                    std::vector<int>& displacements,
+                                    std::vector<int>& recv_counts);
+  static void communicate_Alltoallv(std::vector<unsigned char>& send_buffer,
+                                    std::vector<int>& send_counts,
+                                    std::vector<unsigned char>& recv_buffer,
+                                    std::vector<int>& displacements,
+                                    std::vector<int>& recv_counts);
+
+  //! Number of bytes at the beginning of a packed buffer used by the Communicator
+  static const size_t PACKED_HEADER_SIZE = sizeof(uint_t);
+
    /**
    * Collect GIDs for all nodes in a given node list across processes.
    * The NodeListType should be one of LocalNodeList, LocalLeafList, LocalChildList.
@@ -361,12 +491,14 @@ public:
   static int get_send_buffer_size();
   static int get_recv_buffer_size();
   static bool get_use_Allgather();
+  static bool get_use_Alltoallv();
   static bool get_initialized();
   static int get_num_spikes() ;
 
   static void set_num_threads(thread num_threads);
   static void set_buffer_sizes(int send_buffer_size, int recv_buffer_size);
   static void set_use_Allgather(bool use_Allgather);
+  static void set_use_Alltoallv(bool use_Alltoallv);
 
 private:
 
@@ -377,8 +509,10 @@ private:
   static int n_vps_;             //!< the number of virtual processes
   static int send_buffer_size_;  //!< expected size of send buffer
   static int recv_buffer_size_;  //!< size of receive buffer
+  static int min_send_buffer_size_;  //!< send buffer size set by set_buffer_sizes()
   static bool initialized_;      //!< whether MPI is initialized
   static bool use_Allgather_;    //!< using Allgather communication
+  static bool use_Alltoallv_;    //!< using sparse Alltoallv spike exchange
   static int num_spikes_;
 };
 
@@ -431,6 +565,11 @@ inline bool Communicator::get_use_Allgather()
   return use_Allgather_;
 }
 
+inline bool Communicator::get_use_Alltoallv()
+{
+  return use_Alltoallv_;
+}
+
 inline int Communicator::get_num_spikes()
 {
   return num_spikes_;
@@ -450,6 +589,7 @@ inline void Communicator::set_buffer_sizes(int send_buffer_size, int recv_buffer
 {
   send_buffer_size_ = send_buffer_size;
   recv_buffer_size_ = recv_buffer_size;
+  min_send_buffer_size_ = send_buffer_size;
 }
 
 inline void Communicator::set_use_Allgather(bool use_Allgather)
@@ -457,6 +597,11 @@ inline void Communicator::set_use_Allgather(bool use_Allgather)
   use_Allgather_ = use_Allgather;
 }
 
+inline void Communicator::set_use_Alltoallv(bool use_Alltoallv)
+{
+  use_Alltoallv_ = use_Alltoallv;
+}
+
 } // namespace nest
 
 #endif /* #ifndef COMMUNICATOR_H */
@@ -55,6 +55,35 @@ extern MPI_Comm comm;
 template <typename T>
 struct MPI_Type { static MPI_Datatype type; };
 
+template <typename T>
+void nest::Communicator::exchange_Alltoallv(std::vector<T>& send_buffer,
+                                            std::vector<int>& send_counts,
+                                            std::vector<T>& recv_buffer,
+                                            std::vector<int>& displacements,
+                                            std::vector<int>& recv_counts)
+{
+  // first tell every process how much data to expect
+  MPI_Alltoall(&send_counts[0], 1, MPI_INT, &recv_counts[0], 1, MPI_INT, comm);
+
+  std::vector<int> send_displacements(num_processes_, 0);
+  int recv_size = recv_counts[0];
+  displacements[0] = 0;
+  for (int pid = 1; pid < num_processes_; ++pid)
+  {
+    send_displacements[pid] = send_displacements[pid - 1] + send_counts[pid - 1];
+    displacements[pid] = recv_size;
+    recv_size += recv_counts[pid];
+  }
+
+  // keep the buffers non-empty, so that their first element can be addressed
+  if (send_buffer.empty())
+    send_buffer.resize(1);
+  recv_buffer.resize(recv_size > 0 ? recv_size : 1);
+
+  MPI_Alltoallv(&send_buffer[0], &send_counts[0], &send_displacements[0], MPI_Type<T>::type,
+                &recv_buffer[0], &recv_counts[0], &displacements[0], MPI_Type<T>::type, comm);
+}
+
 template <typename T>
 void nest::Communicator::communicate_Allgatherv(std::vector<T>& send_buffer,
                                                 std::vector<T>& recv_buffer,
@@ -34,8 +34,13 @@
 namespace nest
 {
 
+const size_t ConnectionManager::THREAD_MASK_BITS;
+
 ConnectionManager::ConnectionManager(Network& net)
-        : net_(net)
+        : net_(net),
+          compact_storage_(true),
+          thread_mask_words_(1),
+          num_source_threads_(0)
 {}
 
 ConnectionManager::~ConnectionManager()
@@ -72,8 +77,19 @@ void ConnectionManager::init_()
 
   connections_.swap(tmp);
 
+  tVVConnectionStore tmp_stores(net_.get_num_threads());
+  stores_.swap(tmp_stores);
+
+  std::vector<std::vector<index> >(net_.get_num_threads()).swap(new_sources_);
+  new_sources_limit_.assign(net_.get_num_threads(), 1024);
+  google::sparsetable<index>().swap(target_thread_entries_);
+  std::vector<unsigned long>().swap(target_thread_masks_);
+  thread_mask_words_ = (net_.get_num_threads() + THREAD_MASK_BITS - 1) / THREAD_MASK_BITS;
+  num_source_threads_ = 0;
+
   num_connections_ = 0;
   num_conn_changed_since_counted_ = false;
+  stores_changed_ = false;
 }
 
 void ConnectionManager::delete_connections_()
@@ -82,6 +98,10 @@ void ConnectionManager::delete_connections_()
     for (tVVConnector::nonempty_iterator iit = it->nonempty_begin(); iit != it->nonempty_end(); ++iit)
       for ( tVConnector::iterator iiit = iit->begin(); iiit != iit->end(); ++iiit)
 	delete (*iiit).connector;
+
+  for (tVVConnectionStore::iterator it = stores_.begin(); it != stores_.end(); ++it)
+    for (std::vector<ConnectionStore*>::iterator iit = it->begin(); iit != it->end(); ++iit)
+      delete *iit;
 }
 
 void ConnectionManager::clear_prototypes_()
@@ -219,6 +239,28 @@ index ConnectionManager::validate_connector(thread tid, index gid, index syn_id)
   return static_cast<index>(syn_vec_index);
 }
 
+ConnectionStore& ConnectionManager::validate_store_(thread tid, index syn_id)
+{
+  assert_valid_syn_id(syn_id);
+
+  if (stores_[tid].size() < prototypes_.size())
+    stores_[tid].resize(prototypes_.size(), 0);
+
+  if (stores_[tid][syn_id] == 0)
+  {
+    ConnectionStore* store = prototypes_[syn_id]->get_connection_store();
+    if (store == 0)
+    {
+      net_.message(SLIInterpreter::M_ERROR, "ConnectionManager::validate_store_",
+                   "Synapse type " + prototypes_[syn_id]->get_name()
+                   + " does not support compact connection storage.");
+      throw KernelException();
+    }
+    stores_[tid][syn_id] = store;
+  }
+  return *stores_[tid][syn_id];
+}
+
 index ConnectionManager::copy_synapse_prototype(index old_id, std::string new_name)
 {
   // we can assert here, as nestmodule checks this for us
@@ -233,7 +275,65 @@ index ConnectionManager::copy_synapse_prototype(index old_id, std::string new_na
 
 void ConnectionManager::get_status(DictionaryDatum& d) const
 {
-  def<long>(d, "num_connections", get_num_connections());
+  const size_t num_connections = get_num_connections();
+  def<long>(d, "num_connections", num_connections);
+  def<bool>(d, "compact_connection_storage", compact_storage_);
+  def<double>(d, "bytes_per_synapse", num_connections > 0 ?
+              static_cast<double>(get_num_bytes_()) / num_connections : 0.0);
+}
+
+void ConnectionManager::set_status(const DictionaryDatum& d)
+{
+  bool compact_storage = compact_storage_;
+  updateValue<bool>(d, "compact_connection_storage", compact_storage);
+
+  if (compact_storage == compact_storage_)
+    return;
+
+  for (size_t syn_id = 0; syn_id < prototypes_.size(); ++syn_id)
+    if (prototypes_[syn_id] != 0 && prototypes_[syn_id]->get_num_connectors() > 0)
+    {
+      net_.message(SLIInterpreter::M_ERROR, "ConnectionManager::set_status",
+                   "Cannot change connection storage after connections have been created. Please call ResetKernel first.");
+      throw KernelException();
+    }
+
+  compact_storage_ = compact_storage;
+}
+
+size_t ConnectionManager::get_num_bytes_() const
+{
+  size_t num_bytes = 0;
+  for (size_t t = 0; t < new_sources_.size(); ++t)
+    num_bytes += new_sources_[t].capacity() * sizeof(index);
+  num_bytes += target_thread_entries_.num_nonempty() * sizeof(index)
+               + target_thread_masks_.capacity() * sizeof(unsigned long);
+
+  if (compact_storage_)
+  {
+    for (tVVConnectionStore::const_iterator it = stores_.begin(); it != stores_.end(); ++it)
+    {
+      num_bytes += it->capacity() * sizeof(ConnectionStore*);
+      for (std::vector<ConnectionStore*>::const_iterator iit = it->begin(); iit != it->end(); ++iit)
+        if (*iit != 0)
+          num_bytes += (*iit)->get_num_bytes();
+    }
+    return num_bytes;
+  }
+
+  // For the sparse table, we count one empty tVConnector and one bit per
+  // index, which underestimates the bookkeeping of the table groups.
+  for (tVVVConnector::const_iterator it = connections_.begin(); it != connections_.end(); ++it)
+  {
+    num_bytes += it->size() / 8;
+    for (tVVConnector::const_nonempty_iterator iit = it->nonempty_begin(); iit != it->nonempty_end(); ++iit)
+    {
+      num_bytes += sizeof(tVConnector) + iit->capacity() * sizeof(syn_id_connector);
+      for (tVConnector::const_iterator iiit = iit->begin(); iiit != iit->end(); ++iiit)
+        num_bytes += (*iiit).connector->get_num_bytes();
+    }
+  }
+  return num_bytes;
 }
 
 void ConnectionManager::set_prototype_status(index syn_id, const DictionaryDatum& d)
@@ -256,7 +356,15 @@ DictionaryDatum ConnectionManager::get_synapse_status(index gid, index syn_id, p
   int syn_vec_index = get_syn_vec_index (tid,gid,syn_id);
   assert_valid_syn_id(syn_id);
   DictionaryDatum dict(new Dictionary);
-  connections_[tid].get(gid)[syn_vec_index].connector->get_synapse_status(dict, p);
+  if (compact_storage_)
+  {
+    sort_stores();
+    ConnectionStore* store = get_store_(tid, syn_id);
+    assert(store != 0);
+    store->get_synapse_status(gid, dict, p);
+  }
+  else
+    connections_[tid].get(gid)[syn_vec_index].connector->get_synapse_status(dict, p);
   (*dict)[names::source] = gid;
   (*dict)[names::synapse_model] = LiteralDatum(get_synapse_prototype(syn_id).get_name());
 
@@ -266,6 +374,15 @@ DictionaryDatum ConnectionManager::get_synapse_status(index gid, index syn_id, p
 void ConnectionManager::set_synapse_status(index gid, index syn_id, port p, thread tid, const DictionaryDatum& dict)
 {
   assert_valid_syn_id(syn_id);
+  if (compact_storage_)
+  {
+    sort_stores();
+    ConnectionStore* store = get_store_(tid, syn_id);
+    assert(store != 0);
+    store->set_synapse_status(gid, dict, p);
+    return;
+  }
+
   int syn_vec_index = get_syn_vec_index (tid,gid,syn_id);
   connections_[tid].get(gid)[syn_vec_index].connector->set_synapse_status(dict, p);
 }
@@ -279,6 +396,14 @@ DictionaryDatum ConnectionManager::get_connector_status(const Node& node, index
   index gid = node.get_gid();
   for (thread tid = 0; tid < net_.get_num_threads(); tid++)
   {
+    if (compact_storage_)
+    {
+      sort_stores();
+      const ConnectionStore* store = get_store_(tid, syn_id);
+      if (store != 0)
+        store->get_status(gid, dict);
+      continue;
+    }
     index syn_vec_index = validate_connector(tid, gid, syn_id);
     connections_[tid].get(gid)[syn_vec_index].connector->get_status(dict);
   }
@@ -292,6 +417,14 @@ DictionaryDatum ConnectionManager::get_connector_status(index gid, index syn_id)
   DictionaryDatum dict(new Dictionary);
   for (thread tid = 0; tid < net_.get_num_threads(); tid++)
   {
+    if (compact_storage_)
+    {
+      sort_stores();
+      const ConnectionStore* store = get_store_(tid, syn_id);
+      if (store != 0)
+        store->get_status(gid, dict);
+      continue;
+    }
     index syn_vec_index = validate_connector(tid, gid, syn_id);
     connections_[tid].get(gid)[syn_vec_index].connector->get_status(dict);
   }
@@ -303,12 +436,23 @@ void ConnectionManager::set_connector_status(Node& node, index syn_id, thread ti
   assert_valid_syn_id(syn_id);
 
   index gid = node.get_gid();
+  if (compact_storage_)
+  {
+    sort_stores();
+    ConnectionStore* store = get_store_(tid, syn_id);
+    if (store != 0)
+      store->set_status(gid, dict);
+    return;
+  }
+
   index syn_vec_index = validate_connector(tid, gid, syn_id);
   connections_[tid].get(gid)[syn_vec_index].connector->set_status(dict);
 }
 
 ArrayDatum ConnectionManager::find_connections(DictionaryDatum params)
 {
+  sort_stores();
+
   ArrayDatum connectome;
   ulong_t source=0L;
   bool have_source = updateValue<long>(params, names::source, source);
@@ -337,7 +481,20 @@ ArrayDatum ConnectionManager::find_connections(DictionaryDatum params)
 
   for (thread t = 0; t < net_.get_num_threads(); ++t)
   {
-    if (have_synmodel)
+    if (compact_storage_)
+    {
+      for (size_t sid = have_synmodel ? syn_id : 0; sid < (have_synmodel ? syn_id + 1 : prototypes_.size()); ++sid)
+      {
+        const ConnectionStore* store = get_store_(t, sid);
+        if (store == 0)
+          continue;
+        std::vector<long>* p = store->find_connections(source, params);
+        for (size_t i = 0; i < p->size(); ++i)
+          connectome.push_back(ConnectionDatum(ConnectionID(source, 0, t, sid, (*p)[i])));
+        delete p;
+      }
+    }
+    else if (have_synmodel)
     {
       int syn_vec_index = get_syn_vec_index(t, source, syn_id);
       if (source < connections_[t].size() && syn_vec_index != -1)
@@ -366,8 +523,10 @@ void ConnectionManager::find_connections(ArrayDatum& connectome, thread t, index
   delete p;
 }
 
-ArrayDatum ConnectionManager::get_connections(DictionaryDatum params) const
+ArrayDatum ConnectionManager::get_connections(DictionaryDatum params)
 {
+  sort_stores();
+
   ArrayDatum connectome;
 
   const Token& source_t = params->lookup(names::source);
@@ -420,6 +579,12 @@ void ConnectionManager::get_connections(ArrayDatum& connectome, TokenArray const
 { 
   connectome.reserve(prototypes_[syn_id]->get_num_connections());
 
+  if (compact_storage_)
+  {
+    get_connections_compact_(connectome, source, target, syn_id);
+    return;
+  }
+
   if (source==0 and target == 0)
   {
 #ifdef _OPENMP
@@ -565,9 +730,60 @@ void ConnectionManager::get_connections(ArrayDatum& connectome, TokenArray const
   } // else
 }
 
+void ConnectionManager::get_connections_compact_(ArrayDatum& connectome, TokenArray const *source, TokenArray const *target, size_t syn_id) const
+{
+#ifdef _OPENMP
+#pragma omp parallel
+  {
+    thread t = omp_get_thread_num();
+#else
+  for (thread t = 0; t < net_.get_num_threads(); ++t)
+  {
+#endif
+    ArrayDatum conns_in_thread;
+    const ConnectionStore* store = get_store_(t, syn_id);
+    if (store != 0)
+    {
+      std::vector<index> sources;
+      if (source == 0)
+        store->get_sources(sources);
+      else
+        for (index s = 0; s < source->size(); ++s)
+          sources.push_back(source->get(s));
+
+      conns_in_thread.reserve(store->get_num_connections());
+      for (std::vector<index>::const_iterator s = sources.begin(); s != sources.end(); ++s)
+        if (target == 0)
+          store->get_connections(*s, t, syn_id, conns_in_thread);
+        else
+          for (index t_id = 0; t_id < target->size(); ++t_id)
+            store->get_connections(*s, target->get(t_id), t, syn_id, conns_in_thread);
+    }
+
+    if (conns_in_thread.size()>0)
+    {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+      connectome.append_move(conns_in_thread);
+    }
+  }
+}
+
 // Return connections to all targets 
 void ConnectionManager::get_connections(ArrayDatum& connectome, index source, thread t, index syn_id) const
 {
+  if (compact_storage_)
+  {
+    const ConnectionStore* store = get_store_(t, syn_id);
+    if (store != 0)
+    {
+      connectome.reserve(store->get_num_connections(source));
+      store->get_connections(source, t, syn_id, connectome);
+    }
+    return;
+  }
+
   int syn_vec_index = get_syn_vec_index(t, source, syn_id);
   size_t n_ports=connections_[t].get(source)[syn_vec_index].connector->get_num_connections(); 
   connectome.reserve(n_ports);
@@ -576,22 +792,49 @@ void ConnectionManager::get_connections(ArrayDatum& connectome, index source, th
 
 void ConnectionManager::connect(Node& s, Node& r, index s_gid, thread tid, index syn)
 {
-  index syn_vec_index = validate_connector(tid, s_gid, syn);
-  connections_[tid].get(s_gid)[syn_vec_index].connector->register_connection(s, r);
+  if (compact_storage_)
+  {
+    validate_store_(tid, syn).register_connection(s_gid, s, r);
+    stores_changed_ = true;
+  }
+  else
+  {
+    index syn_vec_index = validate_connector(tid, s_gid, syn);
+    connections_[tid].get(s_gid)[syn_vec_index].connector->register_connection(s, r);
+  }
+  add_source_(tid, s_gid);
   num_conn_changed_since_counted_ = true;
 }
 
 void ConnectionManager::connect(Node& s, Node& r, index s_gid, thread tid, double_t w, double_t d, index syn)
 {
-  index syn_vec_index = validate_connector(tid, s_gid, syn);
-  connections_[tid].get(s_gid)[syn_vec_index].connector->register_connection(s, r, w, d);
+  if (compact_storage_)
+  {
+    validate_store_(tid, syn).register_connection(s_gid, s, r, w, d);
+    stores_changed_ = true;
+  }
+  else
+  {
+    index syn_vec_index = validate_connector(tid, s_gid, syn);
+    connections_[tid].get(s_gid)[syn_vec_index].connector->register_connection(s, r, w, d);
+  }
+  add_source_(tid, s_gid);
   num_conn_changed_since_counted_ = true;
 }
 
 void ConnectionManager::connect(Node& s, Node& r, index s_gid, thread tid, DictionaryDatum& p, index syn)
 {
-  index syn_vec_index = validate_connector(tid, s_gid, syn);
-  connections_[tid].get(s_gid)[syn_vec_index].connector->register_connection(s, r, p);
+  if (compact_storage_)
+  {
+    validate_store_(tid, syn).register_connection(s_gid, s, r, p);
+    stores_changed_ = true;
+  }
+  else
+  {
+    index syn_vec_index = validate_connector(tid, s_gid, syn);
+    connections_[tid].get(s_gid)[syn_vec_index].connector->register_connection(s, r, p);
+  }
+  add_source_(tid, s_gid);
   num_conn_changed_since_counted_ = true;
 }
 
@@ -654,13 +897,120 @@ bool ConnectionManager::connect(ArrayDatum& conns)
     return true;
 }
 
+void ConnectionManager::add_source_(thread tid, index sgid)
+{
+  // only the vector of thread tid is modified, so that connections
+  // can be created on several threads in parallel; consecutive
+  // connections from one source are recorded once
+  std::vector<index>& sources = new_sources_[tid];
+  if (!sources.empty() && sources.back() == sgid)
+    return;
+
+  sources.push_back(sgid);
+  if (sources.size() >= new_sources_limit_[tid])
+  {
+    std::sort(sources.begin(), sources.end());
+    sources.erase(std::unique(sources.begin(), sources.end()), sources.end());
+    new_sources_limit_[tid] = 2 * sources.size() + 1024;
+  }
+}
+
+void ConnectionManager::update_target_threads_()
+{
+  for (size_t t = 0; t < new_sources_.size(); ++t)
+  {
+    const std::vector<index>& sources = new_sources_[t];
+    const size_t word = t / THREAD_MASK_BITS;
+    const unsigned long bit = 1UL << (t % THREAD_MASK_BITS);
+    for (std::vector<index>::const_iterator s = sources.begin(); s != sources.end(); ++s)
+    {
+      if (target_thread_entries_.size() <= *s)
+        target_thread_entries_.resize(std::max(net_.size(), *s + 1));
+      if (!target_thread_entries_.test(*s))
+      {
+        target_thread_entries_.set(*s, target_thread_masks_.size() / thread_mask_words_);
+        target_thread_masks_.resize(target_thread_masks_.size() + thread_mask_words_, 0UL);
+      }
+      unsigned long& mask = target_thread_masks_[target_thread_entries_.get(*s) * thread_mask_words_ + word];
+      if (!(mask & bit))
+      {
+        mask |= bit;
+        ++num_source_threads_;
+      }
+    }
+    std::vector<index>().swap(new_sources_[t]);
+    new_sources_limit_[t] = 1024;
+  }
+}
+
+void ConnectionManager::get_sources_with_targets(std::vector<uint_t>& sources) const
+{
+  sources.clear();
+  sources.reserve(target_thread_entries_.num_nonempty());
+  for (google::sparsetable<index>::const_nonempty_iterator it = target_thread_entries_.nonempty_begin();
+       it != target_thread_entries_.nonempty_end(); ++it)
+    sources.push_back(target_thread_entries_.get_pos(it));
+}
+
+void ConnectionManager::sort_stores()
+{
+  update_target_threads_();
+
+  if (!stores_changed_)
+    return;
+
+#ifdef _OPENMP
+#pragma omp parallel
+  {
+    thread t = omp_get_thread_num();
+#else
+  for (thread t = 0; t < net_.get_num_threads(); ++t)
+  {
+#endif
+    for (std::vector<ConnectionStore*>::iterator it = stores_[t].begin(); it != stores_[t].end(); ++it)
+      if (*it != 0)
+        (*it)->sort();
+  }
+
+  stores_changed_ = false;
+}
+
 void ConnectionManager::send(thread t, index sgid, Event& e)
 {
+  if (compact_storage_)
+  {
+    const std::vector<ConnectionStore*>& stores = stores_[t];
+    for (size_t syn_id = 0; syn_id < stores.size(); ++syn_id)
+      if (stores[syn_id] != 0)
+        stores[syn_id]->send(sgid, e);
+    return;
+  }
+
   if (sgid < connections_[t].size())
     for (size_t i = 0; i < connections_[t].get(sgid).size(); ++i)
       connections_[t].get(sgid)[i].connector->send(e);
 }
 
+void ConnectionManager::send(thread t, const std::vector<BatchedSpike>& spikes, SpikeEvent& e)
+{
+  if (compact_storage_)
+  {
+    const std::vector<ConnectionStore*>& stores = stores_[t];
+    for (size_t syn_id = 0; syn_id < stores.size(); ++syn_id)
+      if (stores[syn_id] != 0)
+        stores[syn_id]->send(spikes, e);
+    return;
+  }
+
+  for (std::vector<BatchedSpike>::const_iterator sp = spikes.begin(); sp != spikes.end(); ++sp)
+  {
+    e.set_stamp(sp->stamp_);
+    e.set_sender_gid(sp->sgid_);
+    e.set_offset(sp->offset_);
+    send(t, sp->sgid_, e);
+  }
+}
+
 size_t ConnectionManager::get_num_connections() const
 {
   if (num_conn_changed_since_counted_)
@@ -685,10 +1035,19 @@ void ConnectionManager::count_connections() const
 #endif
     std::vector<size_t> num_connections_per_syn_id(prototypes_.size(), 0);
 
-    tVVConnector::const_nonempty_iterator iter;      
-    for (iter = connections_[t].nonempty_begin(); iter != connections_[t].nonempty_end(); ++iter)
-      for (size_t syn_id = 0; syn_id < (*iter).size(); ++syn_id)
-        num_connections_per_syn_id[(*iter)[syn_id].syn_id] += (*iter)[syn_id].connector->get_num_connections();
+    if (compact_storage_)
+    {
+      for (size_t syn_id = 0; syn_id < stores_[t].size(); ++syn_id)
+        if (stores_[t][syn_id] != 0)
+          num_connections_per_syn_id[syn_id] += stores_[t][syn_id]->get_num_connections();
+    }
+    else
+    {
+      tVVConnector::const_nonempty_iterator iter;
+      for (iter = connections_[t].nonempty_begin(); iter != connections_[t].nonempty_end(); ++iter)
+        for (size_t syn_id = 0; syn_id < (*iter).size(); ++syn_id)
+          num_connections_per_syn_id[(*iter)[syn_id].syn_id] += (*iter)[syn_id].connector->get_num_connections();
+    }
 
     for (size_t syn_id = 0; syn_id < prototypes_.size(); ++syn_id)
     {
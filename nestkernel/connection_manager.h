@@ -30,6 +30,7 @@
 #include "model.h"
 #include "dictutils.h"
 #include "connector.h"
+#include "connection_store.h"
 #include "nest_time.h"
 #include "nest_timeconverter.h"
 #include "arraydatum.h"
@@ -58,6 +59,8 @@ class ConnectionManager
   typedef google::sparsetable< tVConnector > tVVConnector;
   typedef std::vector< tVVConnector > tVVVConnector;
 
+  typedef std::vector< std::vector< ConnectionStore* > > tVVConnectionStore;
+
 public:
   ConnectionManager(Network& net);
   ~ConnectionManager();
@@ -92,6 +95,17 @@ public:
    */
   void get_status(DictionaryDatum& d) const;
 
+  /**
+   * Set ConnectionManager specific properties from the root status dictionary.
+   * compact_connection_storage selects between one ConnectionStore per
+   * thread and synapse type (true, the default) and per-source Connector
+   * objects (false). It can only be changed while no synapse prototype is
+   * in use. Synapse types from modules with their own connector class
+   * require per-source storage. Compact storage delivers spikes in a
+   * different order than per-source storage, @see send().
+   */
+  void set_status(const DictionaryDatum& d);
+
   // aka SetDefaults for synapse models
   void set_prototype_status(index syn_id, const DictionaryDatum& d);
   // aka GetDefaults for synapse models
@@ -119,7 +133,7 @@ public:
    * The function then iterates all entries in source and collects the connection IDs to all neurons in target.
    * get_connections will eventually replace find_connections.
    */
-  ArrayDatum get_connections(DictionaryDatum params) const;
+  ArrayDatum get_connections(DictionaryDatum params);
 
   void get_connections(ArrayDatum& connectome, TokenArray const *source, TokenArray const *target, size_t syn_id) const;
 
@@ -174,6 +188,61 @@ public:
 
   void send(thread t, index sgid, Event& e);
 
+  /**
+   * Merge the connections created since the last call into the sorted
+   * representation of the compact stores and into the thread masks of
+   * their sources. This is done once before connections are read or
+   * spikes are delivered, not on every access.
+   */
+  void sort_stores();
+
+  //! Number of threads represented by one word of a thread mask
+  static const size_t THREAD_MASK_BITS = std::numeric_limits<unsigned long>::digits;
+
+  /**
+   * Return the mask of the local threads on which there may be
+   * connections from sgid, or 0 if sgid has no connections on this
+   * process. Thread t is represented by bit t % THREAD_MASK_BITS of word
+   * t / THREAD_MASK_BITS, the mask has get_thread_mask_words() words.
+   * Used to partition incoming spikes by target thread. Connections
+   * created since the last call to sort_stores() are not included.
+   */
+  const unsigned long* get_target_threads(index sgid) const;
+
+  //! Number of words of the masks returned by get_target_threads()
+  size_t get_thread_mask_words() const;
+
+  /**
+   * Store the gids of all sources with connections on this process,
+   * in ascending order.
+   */
+  void get_sources_with_targets(std::vector<uint_t>& sources) const;
+
+  /**
+   * Return the number of pairs of source and thread recorded in the
+   * thread masks. The number changes whenever a source gets its first
+   * connection on a thread, and is used to detect that tables derived
+   * from the thread masks must be rebuilt.
+   */
+  size_t get_num_source_threads() const;
+
+  /**
+   * Deliver all spikes received for a time slice to the targets on thread t.
+   * With compact storage, the spikes are delivered synapse type by synapse
+   * type, each in one call to the corresponding ConnectionStore. Otherwise,
+   * each spike is sent through the Connectors of its source.
+   *
+   * Note that compact storage therefore changes the order of delivery: all
+   * spikes of the slice are delivered via the first synapse type before
+   * any is delivered via the next, while per-source storage delivers all
+   * synapse types for one spike before turning to the next spike. Within
+   * a synapse type the order of the global buffer is kept. Models that
+   * depend on the order in which events arrive, e.g. by summing floating
+   * point inputs from different synapse types into the same buffer, may
+   * thus give results that are not bit-identical to per-source storage.
+   */
+  void send(thread t, const std::vector<BatchedSpike>& spikes, SpikeEvent& e);
+
   /**
    * Resize the structures for the Connector objects if necessary.
    * This function should be called after number of threads, min_delay, max_delay, 
@@ -200,6 +269,45 @@ private:
    * - Third dim: A std::vector for each synapse prototype, holding the Connector objects
    */
   tVVVConnector connections_;
+
+  /**
+   * The compact alternative to connections_, used if compact_storage_ is set.
+   * - First dim: A std::vector for each local thread
+   * - Second dim: A ConnectionStore for each synapse prototype, or 0
+   */
+  tVVConnectionStore stores_;
+
+  bool compact_storage_;  //!< Use stores_ instead of connections_?
+
+  /**
+   * Sources that got connections on each thread since the thread masks
+   * were last updated, possibly repeated. Each thread only modifies its
+   * own vector, so that connections can be created on several threads
+   * in parallel.
+   */
+  std::vector<std::vector<index> > new_sources_;
+  std::vector<size_t> new_sources_limit_;  //!< size of new_sources_[t] at which it is compacted
+
+  /**
+   * Thread masks of the sources with connections on this process. The
+   * mask of source g starts at word
+   * target_thread_masks_[target_thread_entries_.get(g) * thread_mask_words_].
+   * Sources without connections have no entry.
+   */
+  google::sparsetable<index> target_thread_entries_;
+  std::vector<unsigned long> target_thread_masks_;
+  size_t thread_mask_words_;
+  size_t num_source_threads_;  //!< number of bits set in target_thread_masks_
+
+  /**
+   * Record that sgid has connections on thread tid.
+   */
+  void add_source_(thread tid, index sgid);
+
+  /**
+   * Add the sources in new_sources_ to the thread masks.
+   */
+  void update_target_threads_();
   
   mutable size_t num_connections_;              //!< The global counter for the number of synapses
   mutable bool num_conn_changed_since_counted_; //!< Did the number of synapses change since counting?
@@ -210,6 +318,33 @@ private:
   
   index validate_connector(thread tid, index gid, index syn_id);
 
+  /**
+   * Return the ConnectionStore for the given thread and synapse id,
+   * creating it if necessary.
+   * @throws KernelException if the synapse type does not support compact storage.
+   */
+  ConnectionStore& validate_store_(thread tid, index syn_id);
+
+  /**
+   * Return the ConnectionStore for the given thread and synapse id or 0
+   * if it does not exist.
+   */
+  ConnectionStore* get_store_(thread tid, index syn_id) const;
+
+  bool stores_changed_;  //!< Were connections added to stores_ since sort_stores()?
+
+  /**
+   * Variant of get_connections(ArrayDatum&, TokenArray const*, TokenArray const*, size_t)
+   * for compact storage.
+   */
+  void get_connections_compact_(ArrayDatum& connectome, TokenArray const *source, TokenArray const *target, size_t syn_id) const;
+
+  /**
+   * Return the number of bytes used by all Connector or ConnectionStore objects
+   * and by the structures indexing them.
+   */
+  size_t get_num_bytes_() const;
+
   /**
    * Return pointer to protoype for given synapse id.
    * @throws UnknownSynapseType
@@ -254,6 +389,34 @@ bool ConnectionManager::has_user_prototypes() const
   return prototypes_.size() > pristine_prototypes_.size();
 }
 
+inline
+ConnectionStore* ConnectionManager::get_store_(thread tid, index syn_id) const
+{
+  if (static_cast<size_t>(tid) >= stores_.size() || syn_id >= stores_[tid].size())
+    return 0;
+  return stores_[tid][syn_id];
+}
+
+inline
+const unsigned long* ConnectionManager::get_target_threads(index sgid) const
+{
+  if (sgid >= target_thread_entries_.size() || !target_thread_entries_.test(sgid))
+    return 0;
+  return &target_thread_masks_[target_thread_entries_.get(sgid) * thread_mask_words_];
+}
+
+inline
+size_t ConnectionManager::get_thread_mask_words() const
+{
+  return thread_mask_words_;
+}
+
+inline
+size_t ConnectionManager::get_num_source_threads() const
+{
+  return num_source_threads_;
+}
+
 inline
 int ConnectionManager::get_syn_vec_index(thread tid, index gid, index syn_id) const
 {
@@ -0,0 +1,123 @@
+/*
+ *  connection_store.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef CONNECTION_STORE_H
+#define CONNECTION_STORE_H
+
+#include <vector>
+
+#include "node.h"
+#include "event.h"
+#include "exceptions.h"
+#include "spikecounter.h"
+#include "arraydatum.h"
+
+class Dictionary;
+
+namespace nest
+{
+
+class TimeConverter;
+
+/**
+ * Pure abstract base class for the compact connection storage.
+ *
+ * A ConnectionStore holds all connections of one synapse type on one
+ * thread. In contrast to a Connector, which holds the connections of a
+ * single source neuron, the store keeps the connections of all sources
+ * in one contiguous array sorted by source gid, together with a compact
+ * index of the sources that actually have connections. It therefore
+ * avoids the per-source Connector objects and the per-source vectors of
+ * the per-source storage scheme.
+ *
+ * All functions take the gid of the source neuron as first argument and
+ * otherwise mirror the interface of Connector. Ports are numbered per
+ * source in the order in which the connections were created, exactly as
+ * for the per-source storage.
+ *
+ * The store is used by default. Setting the kernel status dictionary
+ * entry compact_connection_storage to false selects Connectors instead.
+ * @see ConnectionManager, Connector
+ */
+class ConnectionStore
+{
+ public:
+  virtual ~ConnectionStore() {}
+  virtual void register_connection(index, Node&, Node&) = 0;
+  virtual void register_connection(index, Node&, Node&, double_t, double_t) = 0;
+  virtual void register_connection(index, Node&, Node&, DictionaryDatum&) = 0;
+  virtual std::vector<long>* find_connections(index source_gid, DictionaryDatum) const = 0;
+
+  /**
+   * Append the connections of source_gid to all targets to conns.
+   */
+  virtual void get_connections(size_t source_gid, size_t thrd, size_t synapse_id, ArrayDatum &conns) const=0;
+
+  /**
+   * Append the connections from source_gid to target_gid to conns.
+   */
+  virtual void get_connections(size_t source_gid, size_t target_gid, size_t thrd, size_t synapse_id, ArrayDatum &conns) const=0;
+
+  /**
+   * Store the gids of all sources with connections in this store, in
+   * ascending order.
+   */
+  virtual void get_sources(std::vector<index>&) const = 0;
+
+  virtual size_t get_num_connections() const =0;
+  virtual size_t get_num_connections(index source_gid) const =0;
+  virtual void get_status(index source_gid, DictionaryDatum & d) const = 0;
+  virtual void set_status(index source_gid, const DictionaryDatum & d) = 0;
+  virtual void get_synapse_status(index source_gid, DictionaryDatum & d, port p) const = 0;
+  virtual void set_synapse_status(index source_gid, const DictionaryDatum & d, port p) = 0;
+
+  /**
+   * Deliver an event emitted by source_gid to all its targets.
+   */
+  virtual void send(index source_gid, Event& e) = 0;
+
+  /**
+   * Deliver a batch of spikes, in the given order, to the targets of
+   * their senders. The sender, stamp and offset of e are set for
+   * every spike.
+   */
+  virtual void send(const std::vector<BatchedSpike>& spikes, SpikeEvent& e) = 0;
+
+  /**
+   * Merge the connections registered since the last call into the
+   * sorted representation. All other functions except register_connection()
+   * require that this has been done.
+   */
+  virtual void sort() = 0;
+
+  virtual void calibrate(const TimeConverter &) = 0;
+  virtual void trigger_update_weight(const std::vector<spikecounter>&, double_t){};
+
+  /**
+   * Return the number of bytes allocated by this store.
+   */
+  virtual size_t get_num_bytes() const = 0;
+};
+
+}
+
+#endif /* #ifndef CONNECTION_STORE_H */
@@ -67,6 +67,11 @@ class Connector
   virtual void send(Event& e) = 0;
   virtual void calibrate(const TimeConverter &) = 0;
   virtual void trigger_update_weight(const std::vector<spikecounter>&, double_t){};
+
+  /**
+   * Return the number of bytes allocated by this connector.
+   */
+  virtual size_t get_num_bytes() const = 0;
 };
  
 
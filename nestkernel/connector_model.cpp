@@ -70,7 +70,7 @@ bool ConnectorModel::check_delay(double_t new_delay)
   // min_delay and the max_delay which have been used during simulation
   if (net_.get_simulated())
   {
-    Time sim_min_delay = Time::step(net_.get_min_delay());
+    Time sim_min_delay = Time::step(net_.get_min_delay() * net_.get_exchange_latency());
     Time sim_max_delay = Time::step(net_.get_max_delay());
     bool bad_min_delay = new_delay < sim_min_delay.get_ms();
     bool bad_max_delay = new_delay > sim_max_delay.get_ms();
@@ -119,7 +119,7 @@ bool ConnectorModel::check_delays(double_t new_delay1, double_t new_delay2)
  
   if (net_.get_simulated())
   {
-    Time sim_min_delay = Time::step(net_.get_min_delay());
+    Time sim_min_delay = Time::step(net_.get_min_delay() * net_.get_exchange_latency());
     Time sim_max_delay = Time::step(net_.get_max_delay());
     bool bad_min_delay = ldelay < sim_min_delay.get_ms();
     bool bad_max_delay = hdelay > sim_max_delay.get_ms();
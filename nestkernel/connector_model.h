@@ -35,6 +35,7 @@
 namespace nest
 {
   class Connector;
+  class ConnectionStore;
 
 /**
  * Defines abstract base class for ConnectorModel.
@@ -55,6 +56,13 @@ class ConnectorModel
   virtual void get_status(DictionaryDatum& d) const = 0;
   virtual void set_status(const DictionaryDatum& d) = 0;
   virtual Connector* get_connector() = 0;
+
+  /**
+   * Return a new store for the connections of this type on one thread,
+   * used if compact connection storage is enabled. Returns 0 if the
+   * connector of this type does not support compact storage.
+   */
+  virtual ConnectionStore* get_connection_store() = 0;
   virtual void calibrate(const TimeConverter &) = 0;
   virtual void reset() = 0;
 
@@ -351,6 +351,24 @@ namespace nest{
   {
     return multiplicity_;
   }
+
+  /**
+   * A spike read from the global spike buffers. The Scheduler collects
+   * all spikes of a time slice as BatchedSpike objects and delivers
+   * them in one call to ConnectionManager::send().
+   */
+  struct BatchedSpike
+  {
+    BatchedSpike(index sgid, const Time& stamp, double_t offset)
+      : sgid_(sgid),
+        stamp_(stamp),
+        offset_(offset)
+    {}
+
+    index sgid_;      //!< gid of the sender
+    Time stamp_;      //!< time stamp of the spike
+    double_t offset_; //!< offset for precise spike times
+  };
   
 
   /**
@@ -487,9 +505,26 @@ namespace nest{
     /** Create empty request for use during simulation. */
     DataLoggingRequest();
 
+    /**
+     * Reduction applied by the data logger to the samples taken during
+     * one reduction window.
+     * - NO_REDUCTION: every sample is sent
+     * - DECIMATE: only the sample at the end of each window is sent
+     * - MINIMUM, MAXIMUM, MEAN: one value per window and recordable
+     */
+    enum Reduction { NO_REDUCTION, DECIMATE, MINIMUM, MAXIMUM, MEAN };
+
     /** Create event for given time stamp and vector of recordables. */
     DataLoggingRequest(const Time&, const std::vector<Name>&);
 
+    /**
+     * Create event for given time stamp and vector of recordables,
+     * requesting the given reduction over windows of the given length.
+     * The window must be a multiple of the recording interval.
+     */
+    DataLoggingRequest(const Time&, const std::vector<Name>&,
+                       Reduction, const Time&);
+
     DataLoggingRequest* clone() const;
 
     void operator()();
@@ -499,12 +534,23 @@ namespace nest{
 
     /** Access to vector of recordables. */
     const std::vector<Name>& record_from() const;
+
+    /** Access to requested reduction. */
+    Reduction get_reduction() const { return reduction_; }
+
+    /** Access to length of reduction window. */
+    const Time& get_reduction_window() const;
     
   private:
     
     //! Interval between two recordings, first is step 1
     Time recording_interval_;
 
+    Reduction reduction_;
+
+    //! Length of reduction window, multiple of recording interval
+    Time reduction_window_;
+
     /**
      * Names of properties to record from.
      * @note This pointer shall be NULL unless the event is sent by a connection routine.
@@ -516,6 +562,8 @@ namespace nest{
   DataLoggingRequest::DataLoggingRequest()
     : Event(), 
       recording_interval_(Time::neg_inf()),
+      reduction_(NO_REDUCTION),
+      reduction_window_(Time::neg_inf()),
       record_from_(0)
   {}
 
@@ -524,6 +572,20 @@ namespace nest{
 					 const std::vector<Name>& recs)
     : Event(), 
       recording_interval_(rec_int),
+      reduction_(NO_REDUCTION),
+      reduction_window_(rec_int),
+      record_from_(&recs)
+  {}
+
+  inline
+  DataLoggingRequest::DataLoggingRequest(const Time& rec_int,
+					 const std::vector<Name>& recs,
+					 Reduction red,
+					 const Time& window)
+    : Event(), 
+      recording_interval_(rec_int),
+      reduction_(red),
+      reduction_window_(window),
       record_from_(&recs)
   {}
 
@@ -543,6 +605,16 @@ namespace nest{
     return recording_interval_;
   }
 
+  inline
+  const Time& DataLoggingRequest::get_reduction_window() const 
+  { 
+    // During simulation, events are created without reduction
+    // information. On these, get_reduction_window() must not be called.
+    assert(reduction_window_.is_finite());
+
+    return reduction_window_;
+  }
+
   inline
   const std::vector<Name>& DataLoggingRequest::record_from() const 
   { 
@@ -561,26 +633,77 @@ namespace nest{
   class DataLoggingReply : public Event
   {
   public:
-      //! Data type data at single recording time
-      typedef std::vector<double_t> DataItem;
-
-      /** Data item with pertaining time stamp.
-       * Items are initialized with time stamp -inf to mark them as invalid.
-       * Data is initialized to <double_t>::max() as a highly implausible value.
-       * Ideally, we should initialized to a NaN, but since the C++-standard does
-       * not require NaN, that would result in unportable code. max() should draw
-       * the users att
+      /**
+       * Data recorded during one time slice, stored by column.
+       *
+       * The container holds up to capacity() records. Each record has a
+       * time stamp and one value per recorded variable. Values are stored
+       * in one contiguous array with one column per variable, so that the
+       * value of variable j in record k is found at j * capacity() + k.
+       * Only the first size() records are valid; clear() invalidates all
+       * records without touching the storage.
        */
-      struct Item {
-      Item(size_t n) : data(n, std::numeric_limits<double_t>::max()),
-                            timestamp(Time::neg_inf()) {}
-	DataItem data;
-	Time     timestamp;
+      class Container {
+      public:
+        Container() : timestamps_(), data_(), n_vars_(0), n_(0) {}
+
+        //! Provide storage for up to n records of n_vars values each
+        void resize(size_t n_vars, size_t n)
+        {
+          n_vars_ = n_vars;
+          n_ = 0;
+          timestamps_.assign(n, Time::neg_inf());
+          data_.assign(n_vars * n, 0.0);
+        }
+
+        //! Number of valid records
+        size_t size() const { return n_; }
+
+        //! Maximum number of records
+        size_t capacity() const { return timestamps_.size(); }
+
+        //! Number of recorded variables
+        size_t num_vars() const { return n_vars_; }
+
+        //! Time stamp of record k
+        const Time& timestamp(size_t k) const
+        {
+          assert(k < n_);
+          return timestamps_[k];
+        }
+
+        //! Value of variable j in record k
+        double_t value(size_t j, size_t k) const
+        {
+          assert(j < n_vars_ && k < n_);
+          return data_[j * timestamps_.size() + k];
+        }
+
+        //! Value of variable j in record k, for writing
+        double_t& value(size_t j, size_t k)
+        {
+          assert(j < n_vars_ && k < n_);
+          return data_[j * timestamps_.size() + k];
+        }
+
+        //! Append record with time stamp t, return its index
+        size_t push_back(const Time& t)
+        {
+          assert(n_ < timestamps_.size());
+          timestamps_[n_] = t;
+          return n_++;
+        }
+
+        //! Invalidate all records
+        void clear() { n_ = 0; }
+
+      private:
+        std::vector<Time>     timestamps_;
+        std::vector<double_t> data_;
+        size_t n_vars_;  //!< number of recorded variables
+        size_t n_;       //!< number of valid records
       };
     
-      //! Container for entries
-      typedef std::vector<Item> Container;
-    
       //! Construct with reference to data and time stamps to transmit
       DataLoggingReply(const Container&);
     
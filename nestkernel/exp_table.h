@@ -0,0 +1,89 @@
+/*
+ *  exp_table.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef EXP_TABLE_H
+#define EXP_TABLE_H
+
+#include <vector>
+#include <cmath>
+#include "nest.h"
+
+namespace nest
+{
+
+  /**
+   * Lookup table for the decay factor exp(dt/tau) of a trace.
+   *
+   * Spike times of synapses are multiples of the resolution h, so the
+   * decay between two spikes is exp(-k h / tau) for a number of steps k.
+   * The table holds these factors for k < size(); the decay over longer
+   * intervals, and over intervals which are not a multiple of h, is
+   * computed with std::exp(). The table must be filled again with set()
+   * when tau or the resolution change, e.g., from calibrate() of the
+   * common properties of a synapse type.
+   */
+  class ExpTable
+  {
+  public:
+    ExpTable() : table_(), tau_(1.0), inv_h_(1.0) {}
+
+    /**
+     * Tabulate exp(-k h / tau) for the steps k that cover n_tau time
+     * constants, but for at most max_size steps.
+     */
+    void set(double_t tau, double_t h, double_t n_tau = 5.0, size_t max_size = 8192)
+    {
+      tau_ = tau;
+      inv_h_ = 1.0 / h;
+      table_.clear();
+      if ( not ( tau > 0 && h > 0 ) )
+        return;  // always use std::exp()
+      const double_t n = std::ceil(n_tau * tau / h) + 1;
+      table_.resize(n < max_size ? static_cast<size_t>(n) : max_size);
+      for ( size_t k = 0 ; k < table_.size() ; ++k )
+        table_[k] = std::exp(-static_cast<double_t>(k) * h / tau);
+    }
+
+    //! Return exp(dt / tau) for dt <= 0, in ms
+    double_t operator()(double_t dt) const
+    {
+      const double_t k = -dt * inv_h_;
+      if ( k > -0.5 && k < table_.size() - 0.5 )
+      {
+        const size_t i = static_cast<size_t>(k + 0.5);
+        if ( std::abs(k - i) < 1e-6 )
+          return table_[i];
+      }
+      return std::exp(dt / tau_);
+    }
+
+    size_t size() const { return table_.size(); }
+
+  private:
+    std::vector<double_t> table_;
+    double_t tau_;
+    double_t inv_h_;  //!< inverse of the resolution
+  };
+
+}
+
+#endif
@@ -0,0 +1,510 @@
+/*
+ *  generic_connection_store.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GENERICCONNECTIONSTORE_H
+#define GENERICCONNECTIONSTORE_H
+
+#include <algorithm>
+#include <vector>
+
+#include "dictutils.h"
+#include "nest_time.h"
+#include "connection_store.h"
+#include "node.h"
+#include "event.h"
+#include "spikecounter.h"
+#include "nest_names.h"
+#include "connectiondatum.h"
+
+namespace nest {
+
+/**
+ * Default implementation of a ConnectionStore for connections of type
+ * ConnectionT. The connections of all sources are kept in a single vector,
+ * sorted by source gid. The connections of source sources_[i] occupy the
+ * range [offsets_[i], offsets_[i+1]) and port p of this source refers to
+ * connections_[offsets_[i] + p]. Sources are found by binary search in
+ * sources_, so the index grows with the number of sources that actually
+ * have connections of this type on this thread and not with the size of
+ * the network.
+ *
+ * New connections are appended unsorted and merged into the sorted part
+ * by sort(), which the ConnectionManager calls once before connections
+ * are read or spikes are delivered. Since the merge is stable, ports
+ * are numbered in the order in which the connections were created.
+ *
+ * ConnectionT:       type of connections to store
+ * CommonPropertiesT: type of common properties object storing parameters which are common to all synapses
+ * ConnectorModelT:   type of ConnectorModel which is the factory of this store
+ *
+ * As for GenericConnector, the dynamics of a connection must be defined
+ * locally, i.e. it must be independent of all other connections.
+ */
+template <typename ConnectionT, typename CommonPropertiesT, typename ConnectorModelT>
+class GenericConnectionStore : public ConnectionStore
+{
+  typedef typename std::vector< ConnectionT >::iterator ConnIter;
+
+ public:
+  /**
+   * Default constructor.
+   * \param cm ConnectorModel, which created this store.
+   */
+  GenericConnectionStore(ConnectorModelT &cm);
+
+  void register_connection(index, Node&, Node&);
+  void register_connection(index, Node&, Node&, double_t, double_t);
+  void register_connection(index, Node&, Node&, DictionaryDatum&);
+
+  std::vector<long>* find_connections(index, DictionaryDatum) const;
+
+  void get_connections(size_t source_gid, size_t thrd, size_t synapse_id, ArrayDatum &conns) const;
+  void get_connections(size_t source_gid, size_t target_gid, size_t thrd, size_t synapse_id, ArrayDatum &conns) const;
+  void get_sources(std::vector<index>&) const;
+
+  size_t get_num_connections() const
+  {
+    return connections_.size();
+  }
+
+  size_t get_num_connections(index) const;
+
+  void get_status(index, DictionaryDatum & d) const;
+  void set_status(index, const DictionaryDatum & d);
+  void get_synapse_status(index, DictionaryDatum & d, port p) const;
+  void set_synapse_status(index, const DictionaryDatum & d, port p);
+
+  void send(index, Event& e);
+  void send(const std::vector<BatchedSpike>&, SpikeEvent& e);
+  void calibrate(const TimeConverter &);
+  void trigger_update_weight(const std::vector<spikecounter>& neuromodulator_spikes, double_t t_trig);
+
+  size_t get_num_bytes() const;
+
+  void sort();
+
+ private:
+  /**
+   * Register a new connection at the sender side.
+   */
+  void register_connection_(index, Node&, Node&, ConnectionT&, port);
+
+  /**
+   * Return the position of source_gid in sources_, or -1 if the
+   * source has no connections in this store.
+   * Requires that there are no pending connections.
+   */
+  long_t find_source_(index source_gid) const;
+
+  /**
+   * Send e to all connections of the source at position s in sources_.
+   * If set_ports is true, the port of e is set to the index of each
+   * connection within the source, which the event hooks of devices need.
+   * Spikes from the global buffers are not seen by event hooks.
+   */
+  void send_(long_t s, Event& e, CommonPropertiesT& cp, bool set_ports);
+
+  /**
+   * Orders positions in pending_sources_ by source gid.
+   */
+  struct PendingLess_
+  {
+    PendingLess_(const std::vector<index>& s) : s_(s) {}
+    bool operator()(size_t a, size_t b) const { return s_[a] < s_[b]; }
+    const std::vector<index>& s_;
+  };
+
+  std::vector<ConnectionT> connections_; //!< sorted connections, followed by pending ones
+  std::vector<index> sources_;           //!< gids of all sources, ascending
+  std::vector<size_t> offsets_;          //!< start of each source in connections_, plus end
+  std::vector<double_t> t_lastspike_;    //!< point in time of last spike of each source
+  std::vector<index> pending_sources_;   //!< sources of the unsorted tail of connections_
+
+  ConnectorModelT &connector_model_;
+  bool registered_; //!< has the store been registered with a heterosynaptic node?
+};
+
+
+template< typename ConnectionT, typename CommonPropertiesT, typename ConnectorModelT >
+GenericConnectionStore< ConnectionT, CommonPropertiesT, ConnectorModelT >::GenericConnectionStore(ConnectorModelT &cm)
+  : connections_(),
+    sources_(),
+    offsets_(1, 0),
+    t_lastspike_(),
+    pending_sources_(),
+    connector_model_(cm),
+    registered_(false)
+{}
+
+template< typename ConnectionT, typename CommonPropertiesT, typename ConnectorModelT >
+void GenericConnectionStore< ConnectionT, CommonPropertiesT, ConnectorModelT >::register_connection(index sgid, Node& s, Node& r)
+{
+  // create a new instance of the default connection
+  ConnectionT cn = ConnectionT( connector_model_.get_default_connection() );
+
+  // tell the connector model, that we used the default delay
+  connector_model_.used_default_delay();
+
+  register_connection_(sgid, s, r, cn, connector_model_.get_receptor_type());
+}
+
+template< typename ConnectionT, typename CommonPropertiesT, typename ConnectorModelT >
+void GenericConnectionStore< ConnectionT, CommonPropertiesT, ConnectorModelT >::register_connection(index sgid, Node& s, Node& r, double_t w, double_t d)
+{
+  // See GenericConnectorBase::register_connection() for the conversion of the delay.
+  if ( !connector_model_.check_delay( Time(Time::step(Time(Time::ms(d)).get_steps())).get_ms() ) )
+      throw BadDelay(d);
+
+  // create a new instance of the default connection
+  ConnectionT cn = ConnectionT( connector_model_.get_default_connection() );
+  cn.set_weight(w);
+  cn.set_delay(d);
+
+  register_connection_(sgid, s, r, cn, connector_model_.get_receptor_type());
+}
+
+template< typename ConnectionT, typename CommonPropertiesT, typename ConnectorModelT >
+void GenericConnectionStore< ConnectionT, CommonPropertiesT, ConnectorModelT >::register_connection(index sgid, Node& s, Node& r, DictionaryDatum& d)
+{
+  // check delay
+  double_t delay = 0.0;
+  if ( updateValue<double_t>(d, names::delay, delay) )
+  {
+    if ( !connector_model_.check_delay( Time(Time::step(Time(Time::ms(delay)).get_steps())).get_ms() ) )
+      throw BadDelay(delay);
+  }
+  else
+    connector_model_.used_default_delay();
+
+  // create a new instance of the default connection
+  ConnectionT cn = ConnectionT( connector_model_.get_default_connection() );
+  cn.set_status(d, connector_model_);
+
+  port receptor_type = connector_model_.get_receptor_type();
+
+#ifdef HAVE_MUSIC
+  // We allow music_channel as alias for receptor_type during connection setup
+  updateValue<long_t>(d, names::music_channel, receptor_type);
+#endif
+  updateValue<long_t>(d, names::receptor_type, receptor_type);
+
+  register_connection_(sgid, s, r, cn, receptor_type);
+}
+
+template< typename ConnectionT, typename CommonPropertiesT, typename ConnectorModelT >
+inline
+void GenericConnectionStore< ConnectionT, CommonPropertiesT, ConnectorModelT >::register_connection_(index sgid, Node& s, Node& r, ConnectionT &cn, port receptor_type)
+{
+  // sources which are not yet in the sorted part have never spiked through this store
+  double_t t_lastspike = 0.0;
+  if ( !sources_.empty() )
+  {
+    std::vector<index>::const_iterator it = std::lower_bound(sources_.begin(), sources_.end(), sgid);
+    if ( it != sources_.end() && *it == sgid )
+      t_lastspike = t_lastspike_[it - sources_.begin()];
+  }
+
+  cn.check_connection(s, r, receptor_type, t_lastspike);
+  Node* n = connector_model_.get_registering_node(); //if the connection is a heterosynaptic one, it gets the node which contributes to heterosynaptic plasticity
+
+  connections_.push_back(cn);
+  pending_sources_.push_back(sgid);
+
+  if ( n != 0 && !registered_ )
+  {
+    n->register_connector(*this); //register store in heterosynapse
+    registered_ = true;
+  }
+}
+
+template< typename ConnectionT, typename CommonPropertiesT, typename ConnectorModelT >
+void GenericConnectionStore< ConnectionT, CommonPropertiesT, ConnectorModelT >::sort()
+{
+  if ( pending_sources_.empty() )
+    return;
+
+  const size_t n_sorted = connections_.size() - pending_sources_.size();
+
+  // stable ordering of the pending connections by source keeps the ports in creation order
+  std::vector<size_t> perm(pending_sources_.size());
+  for ( size_t i = 0; i < perm.size(); ++i )
+    perm[i] = i;
+  std::stable_sort(perm.begin(), perm.end(), PendingLess_(pending_sources_));
+
+  std::vector<ConnectionT> connections;
+  connections.reserve(connections_.size());
+  std::vector<index> sources;
+  std::vector<size_t> offsets;
+  std::vector<double_t> t_lastspike;
+
+  // merge sorted part and pending connections source by source,
+  // existing connections of a source precede the new ones
+  size_t s = 0;
+  size_t p = 0;
+  while ( s < sources_.size() || p < perm.size() )
+  {
+    index sgid;
+    if ( p == perm.size() || ( s < sources_.size() && sources_[s] <= pending_sources_[perm[p]] ) )
+      sgid = sources_[s];
+    else
+      sgid = pending_sources_[perm[p]];
+
+    sources.push_back(sgid);
+    offsets.push_back(connections.size());
+
+    if ( s < sources_.size() && sources_[s] == sgid )
+    {
+      connections.insert(connections.end(),
+                         connections_.begin() + offsets_[s],
+                         connections_.begin() + offsets_[s + 1]);
+      t_lastspike.push_back(t_lastspike_[s]);
+      ++s;
+    }
+    else
+      t_lastspike.push_back(0.0);
+
+    for ( ; p < perm.size() && pending_sources_[perm[p]] == sgid; ++p )
+      connections.push_back(connections_[n_sorted + perm[p]]);
+  }
+  offsets.push_back(connections.size());
+  assert(n_sorted == offsets_.back());
+
+  connections_.swap(connections);
+  sources_.swap(sources);
+  offsets_.swap(offsets);
+  t_lastspike_.swap(t_lastspike);
+
+  // release the memory of the staging area
+  std::vector<index>().swap(pending_sources_);
+}
+
+template< typename ConnectionT, typename CommonPropertiesT, typename ConnectorModelT >
+inline
+long_t GenericConnectionStore< ConnectionT, CommonPropertiesT, ConnectorModelT >::find_source_(index sgid) const
+{
+  std::vector<index>::const_iterator it = std::lower_bound(sources_.begin(), sources_.end(), sgid);
+  if ( it == sources_.end() || *it != sgid )
+    return -1;
+  return it - sources_.begin();
+}
+
+template< typename ConnectionT, typename CommonPropertiesT, typename ConnectorModelT >
+std::vector<long>* GenericConnectionStore< ConnectionT, CommonPropertiesT, ConnectorModelT >::find_connections(index sgid, DictionaryDatum params) const
+{
+  long postgid = -1;
+  bool use_postgid = updateValue<long>(params, names::target, postgid);
+
+  std::vector<long>* p  = new std::vector<long>;
+
+  assert( pending_sources_.empty() );
+  const long_t s = find_source_(sgid);
+  if ( s < 0 )
+    return p;
+
+  for ( size_t i = offsets_[s]; i < offsets_[s + 1]; ++i )
+    if ( !use_postgid || connections_[i].get_target()->get_gid() == static_cast<index>(postgid) )
+      p->push_back(i - offsets_[s]);
+  return p;
+}
+
+template< typename ConnectionT, typename CommonPropertiesT, typename ConnectorModelT >
+void GenericConnectionStore< ConnectionT, CommonPropertiesT, ConnectorModelT >::get_connections(size_t source_gid, size_t thrd, size_t synapse_id, ArrayDatum &conns) const
+{
+  assert( pending_sources_.empty() );
+  const long_t s = find_source_(source_gid);
+  if ( s < 0 )
+    return;
+
+  for ( size_t i = offsets_[s]; i < offsets_[s + 1]; ++i )
+    conns.push_back(new ConnectionDatum(ConnectionID(source_gid, connections_[i].get_target()->get_gid(), thrd, synapse_id, i - offsets_[s])));
+}
+
+template< typename ConnectionT, typename CommonPropertiesT, typename ConnectorModelT >
+void GenericConnectionStore< ConnectionT, CommonPropertiesT, ConnectorModelT >::get_connections(size_t source_gid, size_t target_gid, size_t thrd, size_t synapse_id, ArrayDatum &conns) const
+{
+  assert( pending_sources_.empty() );
+  const long_t s = find_source_(source_gid);
+  if ( s < 0 )
+    return;
+
+  for ( size_t i = offsets_[s]; i < offsets_[s + 1]; ++i )
+    if ( connections_[i].get_target()->get_gid() == target_gid )
+      conns.push_back(new ConnectionDatum(ConnectionID(source_gid, target_gid, thrd, synapse_id, i - offsets_[s])));
+}
+
+template< typename ConnectionT, typename CommonPropertiesT, typename ConnectorModelT >
+void GenericConnectionStore< ConnectionT, CommonPropertiesT, ConnectorModelT >::get_sources(std::vector<index>& sources) const
+{
+  assert( pending_sources_.empty() );
+  sources = sources_;
+}
+
+template< typename ConnectionT, typename CommonPropertiesT, typename ConnectorModelT >
+size_t GenericConnectionStore< ConnectionT, CommonPropertiesT, ConnectorModelT >::get_num_connections(index sgid) const
+{
+  assert( pending_sources_.empty() );
+  const long_t s = find_source_(sgid);
+  if ( s < 0 )
+    return 0;
+  return offsets_[s + 1] - offsets_[s];
+}
+
+template< typename ConnectionT, typename CommonPropertiesT, typename ConnectorModelT >
+void GenericConnectionStore< ConnectionT, CommonPropertiesT, ConnectorModelT >::get_status(index sgid, DictionaryDatum & d) const
+{
+  // Initializes empty arrays in the dictionary
+  connector_model_.get_default_connection().initialize_property_arrays(d);
+
+  assert( pending_sources_.empty() );
+  const long_t s = find_source_(sgid);
+  if ( s < 0 )
+    return;
+
+  for ( size_t i = offsets_[s]; i < offsets_[s + 1]; ++i )
+    connections_[i].append_properties(d);
+}
+
+template< typename ConnectionT, typename CommonPropertiesT, typename ConnectorModelT >
+void GenericConnectionStore< ConnectionT, CommonPropertiesT, ConnectorModelT >::set_status(index sgid, const DictionaryDatum & d)
+{
+  assert( pending_sources_.empty() );
+  const long_t s = find_source_(sgid);
+  const size_t n = s < 0 ? 0 : offsets_[s + 1] - offsets_[s];
+
+  // all contained arrays must be of length n, see GenericConnectorBase::set_status()
+  TokenMap::iterator iter;
+  for (iter = d->begin(); iter != d->end(); ++iter)
+  {
+    ArrayDatum* ad = dynamic_cast<ArrayDatum*>((iter->second).datum());
+    if (ad != 0)
+      if (ad->size() != n)
+        throw DimensionMismatch(n, ad->size());
+  }
+
+  if ( s < 0 )
+    return;
+
+  for ( size_t i = 0; i < n; ++i )
+    connections_[offsets_[s] + i].set_status(d, i, connector_model_);
+}
+
+template< typename ConnectionT, typename CommonPropertiesT, typename ConnectorModelT >
+void GenericConnectionStore< ConnectionT, CommonPropertiesT, ConnectorModelT >::get_synapse_status(index sgid, DictionaryDatum & d, port p) const
+{
+  assert( pending_sources_.empty() );
+  const long_t s = find_source_(sgid);
+  assert (s >= 0 && p >= 0 && static_cast<size_t>(p) < offsets_[s + 1] - offsets_[s]);
+  connections_[offsets_[s] + p].get_status(d);
+}
+
+template< typename ConnectionT, typename CommonPropertiesT, typename ConnectorModelT >
+void GenericConnectionStore< ConnectionT, CommonPropertiesT, ConnectorModelT >::set_synapse_status(index sgid, const DictionaryDatum & d, port p)
+{
+  assert( pending_sources_.empty() );
+  const long_t s = find_source_(sgid);
+  assert (s >= 0 && p >= 0 && static_cast<size_t>(p) < offsets_[s + 1] - offsets_[s]);
+  connections_[offsets_[s] + p].set_status(d, connector_model_);
+}
+
+template< typename ConnectionT, typename CommonPropertiesT, typename ConnectorModelT >
+inline
+void GenericConnectionStore< ConnectionT, CommonPropertiesT, ConnectorModelT >::send_(long_t s, Event& e, CommonPropertiesT& cp, bool set_ports)
+{
+  const ConnIter end = connections_.begin() + offsets_[s + 1];
+  if ( set_ports )
+  {
+    size_t i = 0;
+    for ( ConnIter conn_it = connections_.begin() + offsets_[s]; conn_it != end; ++conn_it, ++i )
+    {
+      e.set_port(i);
+      conn_it->send(e, t_lastspike_[s], cp);
+    }
+  }
+  else
+    for ( ConnIter conn_it = connections_.begin() + offsets_[s]; conn_it != end; ++conn_it )
+      conn_it->send(e, t_lastspike_[s], cp);
+
+  t_lastspike_[s] = e.get_stamp().get_ms();
+}
+
+template< typename ConnectionT, typename CommonPropertiesT, typename ConnectorModelT >
+void GenericConnectionStore< ConnectionT, CommonPropertiesT, ConnectorModelT >::send(index sgid, Event& e)
+{
+  assert( pending_sources_.empty() );
+  const long_t s = find_source_(sgid);
+  if ( s < 0 )
+    return;
+
+  send_(s, e, connector_model_.get_common_properties(), true);
+}
+
+template< typename ConnectionT, typename CommonPropertiesT, typename ConnectorModelT >
+void GenericConnectionStore< ConnectionT, CommonPropertiesT, ConnectorModelT >::send(const std::vector<BatchedSpike>& spikes, SpikeEvent& e)
+{
+  assert( pending_sources_.empty() );
+  if ( sources_.empty() )
+    return;
+
+  // the loop is specific to ConnectionT, so the connections are called
+  // without virtual dispatch
+  CommonPropertiesT &cp = connector_model_.get_common_properties();
+  for ( std::vector<BatchedSpike>::const_iterator sp = spikes.begin(); sp != spikes.end(); ++sp )
+  {
+    const long_t s = find_source_(sp->sgid_);
+    if ( s < 0 )
+      continue;
+
+    e.set_stamp(sp->stamp_);
+    e.set_sender_gid(sp->sgid_);
+    e.set_offset(sp->offset_);
+    send_(s, e, cp, false);
+  }
+}
+
+template< typename ConnectionT, typename CommonPropertiesT, typename ConnectorModelT >
+void GenericConnectionStore< ConnectionT, CommonPropertiesT, ConnectorModelT >::calibrate(const TimeConverter &tc)
+{
+  for (ConnIter it = connections_.begin(); it < connections_.end(); ++it)
+    it->calibrate(tc);
+}
+
+template< typename ConnectionT, typename CommonPropertiesT, typename ConnectorModelT >
+void GenericConnectionStore< ConnectionT, CommonPropertiesT, ConnectorModelT >::trigger_update_weight(const std::vector<spikecounter>& neuromodulator_spikes, double_t t_trig)
+{
+  for (ConnIter it = connections_.begin(); it < connections_.end(); ++it)
+    it->trigger_update_weight(neuromodulator_spikes, t_trig, connector_model_.get_common_properties());
+}
+
+template< typename ConnectionT, typename CommonPropertiesT, typename ConnectorModelT >
+size_t GenericConnectionStore< ConnectionT, CommonPropertiesT, ConnectorModelT >::get_num_bytes() const
+{
+  return sizeof(*this)
+    + connections_.capacity() * sizeof(ConnectionT)
+    + sources_.capacity() * sizeof(index)
+    + offsets_.capacity() * sizeof(size_t)
+    + t_lastspike_.capacity() * sizeof(double_t)
+    + pending_sources_.capacity() * sizeof(index);
+}
+
+} // namespace
+
+#endif
@@ -175,6 +175,11 @@ class GenericConnectorBase : public Connector
    */
   void trigger_update_weight(const std::vector<spikecounter>& neuromodulator_spikes, double_t t_trig);
 
+  size_t get_num_bytes() const
+  {
+    return sizeof(*this) + connections_.capacity() * sizeof(ConnectionT);
+  }
+
  protected:
   std::vector<ConnectionT> connections_;
   ConnectorModelT &connector_model_;
@@ -423,6 +428,16 @@ class GenericConnector : public GenericConnectorBase< ConnectionT,
     {}
 };
 
+/**
+ * The connections of GenericConnector are independent of each other, so they
+ * can equally be kept in the compact GenericConnectionStore.
+ */
+template <typename ConnectionT, typename CommonPropertiesT>
+struct supports_connection_store< GenericConnector<ConnectionT, CommonPropertiesT> >
+{
+  static const bool value = true;
+};
+
 
 /////////////////////////////////////////////////////////////////////////////////
 // Convenient versions of template functions for registering new synapse types //
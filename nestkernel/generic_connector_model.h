@@ -40,10 +40,23 @@
 #include "network.h"
 #include "connector_model.h"
 #include "common_synapse_properties.h"
+#include "generic_connection_store.h"
 
 namespace nest
 {
 
+/**
+ * Trait telling whether the connections of a Connector of type ConnectorT
+ * may be kept in a GenericConnectionStore instead. This requires that the
+ * dynamics of each connection are defined locally. It is specialized for
+ * GenericConnector in generic_connector.h.
+ */
+template< typename ConnectorT >
+struct supports_connection_store
+{
+  static const bool value = false;
+};
+
 /**
  * Template base class for ConnectorModels.
  * An actual ConnectorModel for a specific connector of type ConnectorT is obtained by deriving from the 
@@ -72,6 +85,9 @@ class GenericConnectorModelBase : public ConnectorModel
   /** see ConnectorModel::get_connector() */
   ConnectorT* get_connector();
 
+  /** see ConnectorModel::get_connection_store() */
+  ConnectionStore* get_connection_store();
+
   /** see ConnectorModel::reset() */ 
   void reset();
    
@@ -284,6 +300,16 @@ ConnectorT * GenericConnectorModelBase< ConnectionT, CommonPropertiesT, Connecto
   return new ConnectorT(*this);
 }
 
+template< typename ConnectionT, typename CommonPropertiesT, typename ConnectorT >
+ConnectionStore * GenericConnectorModelBase< ConnectionT, CommonPropertiesT, ConnectorT >::get_connection_store()
+{
+  if ( !supports_connection_store<ConnectorT>::value )
+    return 0;
+
+  num_connectors_++;
+  return new GenericConnectionStore<ConnectionT, CommonPropertiesT, GenericConnectorModelBase>(*this);
+}
+
 template< typename ConnectionT, typename CommonPropertiesT, typename ConnectorT >
 void GenericConnectorModelBase< ConnectionT, CommonPropertiesT, ConnectorT >::calibrate(const TimeConverter &tc)
 {
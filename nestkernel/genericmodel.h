@@ -74,6 +74,16 @@ namespace nest
      */
     port check_connection(Connection&, port);
 
+    /**
+     * Forward to the static function update_population() of the node
+     * class, which is Node::update_population() unless the class hides
+     * it with a population update of its own.
+     */
+    void update_population(std::vector<Node*>::const_iterator first,
+                           std::vector<Node*>::const_iterator last,
+                           std::vector<double_t>& buffer,
+                           Time const &, const long_t, const long_t);
+
     Node const & get_prototype() const;
 
     void set_model_id(int);
@@ -167,6 +177,15 @@ namespace nest
     return proto_.is_off_grid();
   }
 
+  template <typename ElementT>
+  void GenericModel<ElementT>::update_population(std::vector<Node*>::const_iterator first,
+                                                 std::vector<Node*>::const_iterator last,
+                                                 std::vector<double_t>& buffer,
+                                                 Time const & origin, const long_t from, const long_t to)
+  {
+    ElementT::update_population(first, last, buffer, origin, from, to);
+  }
+
   template <typename ElementT>
   inline
   port GenericModel<ElementT>::check_connection(Connection& c, port receptor)
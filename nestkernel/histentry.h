@@ -49,6 +49,33 @@ namespace nest {
                                 // once read by all neurons which need it)
   };
 
+// iterator over the circular spike history of an Archiving_Node
+  class history_iterator
+  {
+    public:
+      history_iterator() : buf_(0), mask_(0), i_(0) {}
+
+      // buf has mask+1 entries, i is the running number of the entry
+      history_iterator(histentry* buf, size_t mask, size_t i) :
+        buf_(buf), mask_(mask), i_(i) {}
+
+      histentry& operator*() const { return buf_[i_ & mask_]; }
+      histentry* operator->() const { return buf_ + (i_ & mask_); }
+
+      history_iterator& operator++() { ++i_; return *this; }
+      history_iterator& operator--() { --i_; return *this; }
+      history_iterator operator++(int) { history_iterator tmp(*this); ++i_; return tmp; }
+      history_iterator operator--(int) { history_iterator tmp(*this); --i_; return tmp; }
+
+      bool operator==(const history_iterator& it) const { return i_ == it.i_; }
+      bool operator!=(const history_iterator& it) const { return i_ != it.i_; }
+
+    private:
+      histentry* buf_;  // storage of the history
+      size_t mask_;     // capacity of buf_ minus one, capacity is a power of two
+      size_t i_;        // running number of the entry
+  };
+
 }
 
 #endif
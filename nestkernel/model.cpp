@@ -109,6 +109,12 @@ namespace nest
 
     (*d)["available"]= Token(tmp);
 
+    // only models whose nodes can share their parameters report them
+    size_t block_size;
+    if (get_prototype().get_shared_parameters(block_size) != 0)
+      (*d)["shared_instances"]=
+        static_cast<long>(Node::network()->get_num_shared_instances(get_prototype().get_model_id()));
+
     (*d)["model"]=LiteralDatum(get_name());
     return d;
   }
@@ -148,6 +148,17 @@ namespace nest
 
     virtual port check_connection(Connection&, port)=0;
 
+    /**
+     * Update the nodes in [first, last), which all belong to this
+     * model and to the same thread.
+     * @see Node::update_population()
+     */
+    virtual
+    void update_population(std::vector<Node*>::const_iterator first,
+                           std::vector<Node*>::const_iterator last,
+                           std::vector<double_t>& buffer,
+                           Time const &, const long_t, const long_t)=0;
+
     /**
      * Return the size of the prototype.
      */
@@ -259,6 +259,7 @@ namespace nest
     const Name precision("precision");
     const Name scientific("scientific");
     const Name binary("binary");
+    const Name format("format");
     const Name fbuffer_size("fbuffer_size");
     const Name flush_records("flush_records");
     const Name close_after_simulate("close_after_simulate");
@@ -267,6 +268,9 @@ namespace nest
     const Name filename("filename");
     const Name filenames("filenames");
     const Name record_from("record_from");
+    const Name reduction("reduction");
+    const Name reduction_window("reduction_window");
+    const Name population_mean("population_mean");
 
     const Name senders("senders");
     const Name times("times");
@@ -279,6 +279,7 @@ namespace nest
     extern const Name precision;
     extern const Name scientific;
     extern const Name binary;
+    extern const Name format;
     extern const Name fbuffer_size;
     extern const Name flush_records;
     extern const Name close_after_simulate;
@@ -287,6 +288,9 @@ namespace nest
     extern const Name filename;
     extern const Name filenames;
     extern const Name record_from;
+    extern const Name reduction;
+    extern const Name reduction_window;
+    extern const Name population_mean;
 
     extern const Name senders;
     extern const Name times;
@@ -1309,6 +1309,9 @@ namespace nest
      Note that MemoryInfo only gives you information about the memory requirements of
      the static model data inside of NEST. It does not tell anything about the memory
      situation on your computer. 
+     The column Shared gives the memory saved on this process by local nodes that
+     share their parameters with other nodes of the same model instead of holding
+     their own copy. Currently, this applies to iaf_neuron and iaf_cond_alpha.
      Synopsis:
      MemoryInfo -> -
      Availability: NEST
@@ -43,6 +43,7 @@
 #include "communicator_impl.h"
 
 #include <cmath>
+#include <map>
 #include <set>
 #ifdef _OPENMP
 #include <omp.h>
@@ -60,6 +61,10 @@ Network::Network(SLIInterpreter &i)
   data_path_(),
   data_prefix_(),
   overwrite_files_(false),
+  async_io_(false),
+  async_writer_(),
+  aggregate_files_(false),
+  recording_container_(),
   dict_miss_is_error_(true)
 {
   Node::net_ = this;
@@ -224,6 +229,9 @@ void Network::clear_models_(bool called_from_destructor)
 void Network::reset()
 {
   destruct_nodes_();
+
+  // all devices have appended their output
+  recording_container_.close();
   clear_models_();
 
   // We free all Node memory and set the number of threads.
@@ -246,6 +254,8 @@ void Network::reset_kernel()
   data_path_ = "";
   data_prefix_ = "";
   overwrite_files_ = false;
+  async_io_ = false;
+  aggregate_files_ = false;
   dict_miss_is_error_ = true;
 
   reset();
@@ -602,12 +612,34 @@ void Network::memory_info()
 
   std::sort(idx.begin(), idx.end(), ModelComp(models_));
 
-  std::string sep("--------------------------------------------------");
+  // memory saved by nodes sharing their parameters: each node would
+  // otherwise hold its own copy of the parameter block
+  std::vector<std::set<const void*> > shared_blocks(models_.size());
+  std::vector<size_t> shared_nodes(models_.size(), 0);
+  std::vector<size_t> block_size(models_.size(), 0);
+  for (index gid = 1; gid < size(); ++gid)
+  {
+    if (!is_local_gid(gid) || nodes_[gid] == 0)
+      continue;
+    const Node* node = get_node(gid);
+    const int m = node->get_model_id();
+    if (m < 0)
+      continue;
+    const void* block = node->get_shared_parameters(block_size[m]);
+    if (block != 0)
+    {
+      shared_blocks[m].insert(block);
+      ++shared_nodes[m];
+    }
+  }
+
+  std::string sep("-----------------------------------------------------------------");
 
   std::cout << sep << std::endl;
   std::cout << std::setw(25) << "Name"
       << std::setw(13) << "Capacity"
       << std::setw(13) << "Available"
+      << std::setw(13) << "Shared"
       << std::endl;
   std::cout << sep << std::endl;
 
@@ -618,6 +650,7 @@ void Network::memory_info()
       std::cout << std::setw(25) << mod->get_name()
       << std::setw(13) << mod->mem_capacity() * mod->get_element_size()
       << std::setw(13) << mod->mem_available() * mod->get_element_size()
+      << std::setw(13) << (shared_nodes[idx[i]] - shared_blocks[idx[i]].size()) * block_size[idx[i]]
       << std::endl;
   }
 
@@ -625,6 +658,38 @@ void Network::memory_info()
   std::cout.unsetf(std::ios::left);
 }
 
+size_t Network::get_num_shared_instances(index model_id)
+{
+  // number of users of each parameter block; the prototype counts as one
+  std::map<const void*, size_t> users;
+  size_t block_size;
+  const void* proto_block = models_[model_id]->get_prototype().get_shared_parameters(block_size);
+  if (proto_block != 0)
+    users[proto_block] = 1;
+
+  std::vector<const void*> blocks;
+  for (index gid = 1; gid < size(); ++gid)
+  {
+    if (!is_local_gid(gid) || nodes_[gid] == 0)
+      continue;
+    const Node* node = get_node(gid);
+    if (node->get_model_id() != static_cast<int>(model_id))
+      continue;
+    const void* block = node->get_shared_parameters(block_size);
+    if (block != 0)
+    {
+      ++users[block];
+      blocks.push_back(block);
+    }
+  }
+
+  size_t n = 0;
+  for (std::vector<const void*>::const_iterator b = blocks.begin(); b != blocks.end(); ++b)
+    if (users[*b] > 1)
+      ++n;
+  return n;
+}
+
 void Network::print(index p, int depth)
 {
   Subnet *target = dynamic_cast<Subnet*>(get_node(p));
@@ -670,6 +735,7 @@ void Network::set_status(index gid, const DictionaryDatum& d)
      We proceed as follows:
      - clear access flags
      - set scheduler properties; this must be first, anyways
+     - set connection manager properties
      - set data_path, data_prefix, overwrite_files
      - at this point, all non-compound property flags are marked accessed
      - loop over all per-thread compounds
@@ -682,8 +748,11 @@ void Network::set_status(index gid, const DictionaryDatum& d)
    */   
   d->clear_access_flags();
   scheduler_.set_status(d); // careful, this may invalidate all node pointers!
+  connection_manager_.set_status(d);
   set_data_path_prefix_(d);
   updateValue<bool>(d, "overwrite_files", overwrite_files_);
+  updateValue<bool>(d, "async_io", async_io_);
+  updateValue<bool>(d, "aggregate_files", aggregate_files_);
   updateValue<bool>(d, "dict_miss_is_error", dict_miss_is_error_);
 
   std::string tmp;
@@ -781,6 +850,8 @@ DictionaryDatum Network::get_status(index idx)
     (*d)["data_path"] = data_path_;
     (*d)["data_prefix"] = data_prefix_;
     (*d)["overwrite_files"] = overwrite_files_;
+    (*d)["async_io"] = async_io_;
+    (*d)["aggregate_files"] = aggregate_files_;
     (*d)["dict_miss_is_error"] = dict_miss_is_error_;
   }
 
@@ -1847,6 +1918,7 @@ index Network::copy_model(index old_id, std::string new_name)
   Model* new_model = get_model(old_id)->clone(new_name);
   models_.push_back(new_model);
   int new_id = models_.size() - 1;
+  new_model->set_model_id(new_id);
   modeldict_->insert(new_name, new_id);
   int proxy_model_id = get_model_id("proxynode");
   assert(proxy_model_id > 0);
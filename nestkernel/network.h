@@ -34,6 +34,8 @@
 #include "connection_manager.h"
 #include "event.h"
 #include "modelrangemanager.h"
+#include "async_writer.h"
+#include "recording_container.h"
 #include "compose.hpp"
 #include "dictdatum.h"
 #include <ostream>
@@ -97,7 +99,11 @@ Description:
 Parameters:
   The following parameters can be set in the status dictionary.
 
+  aggregate_files          booltype    - Whether recording devices of each MPI process write into one container file with an index instead of one file per device and thread
+  async_io                 booltype    - Whether recording devices write their files from a background thread during Simulate
   communicate_allgather    booltype    - Whether to use MPI_Allgather for communication (otherwise use CPEX)
+  communicate_alltoallv    booltype    - Whether to send spikes only to processes with targets, using MPI_Alltoallv (implies the packed format, set before the first simulation)
+  compress_spikes          booltype    - Whether to exchange spikes in a packed format with adaptive buffer size (always uses MPI_Allgather, set before the first simulation)
   data_path                stringtype  - A path, where all data is written to (default is the current directory)
   data_prefix              stringtype  - A common prefix for all data files
   dict_miss_is_error       booltype    - Whether missed dictionary entries are treated as errors
@@ -109,7 +115,9 @@ Parameters:
   num_connections          integertype - The number of connections in the network
   num_processes            integertype - The number of MPI processes
   off_grid_spiking         booltype    - Whether to transmit precise spike times in MPI communicatio
+  overlap_communication    booltype    - Whether to exchange spikes while the next half of the min_delay interval is updated (implies the packed format, cannot be combined with communicate_alltoallv, set before the first simulation, see Remarks)
   overwrite_files          booltype    - Whether to overwrite existing data files
+  population_update        booltype    - Whether to update runs of neurons of the same model at once, vectorized for iaf_psc_alpha, iaf_psc_delta, iaf_psc_exp and, with GSL, for iaf_cond_alpha, iaf_cond_exp, iaf_cond_exp_sfa_rr, iaf_cond_alpha_mc, hh_psc_alpha, hh_cond_exp_traub and ht_neuron (not for aeif_cond_alpha and aeif_cond_exp)
   print_time               booltype    - Whether to print progress information during the simulation
   resolution               doubletype  - The resolution of the simulation (in ms)
   rng_buffsize             integertype - The buffer size of the random number generators
@@ -120,6 +128,17 @@ Parameters:
   to_do                    integertype - The number of steps yet to be simulated
   T_max                    doubletype  - The largest representable time value
   T_min                    doubletype  - The smallest representable time value
+
+Remarks:
+  With overlap_communication, the spikes of a time slice are delivered
+  at the beginning of the slice after next instead of the next slice.
+  To keep spikes from arriving late, a time slice is then only half as
+  long as the min_delay of the network (rounded down to whole steps).
+  This doubles the number of spike exchanges per simulated time, and
+  each of them can only be hidden behind the update of half the
+  min_delay interval. The reported min_delay is not changed. If min_delay
+  is a single step, the exchange does not overlap.
+
 SeeAlso: Simulate, Node
 */
   
@@ -411,6 +430,14 @@ SeeAlso: Simulate, Node
 
     void memory_info();
 
+    /**
+     * Return the number of local nodes of model model_id whose parameter
+     * block is shared with other nodes of the model or with its
+     * prototype.
+     * @see Node::get_shared_parameters()
+     */
+    size_t get_num_shared_instances(index model_id);
+
     void print(index, int);
 
     /**
@@ -447,6 +474,13 @@ SeeAlso: Simulate, Node
      * Return maximal connection delay.
      */
     delay get_max_delay() const;
+
+    /**
+     * Return the number of slices between the emission and the
+     * delivery of a spike.
+     * @see Scheduler::get_exchange_latency()
+     */
+    delay get_exchange_latency() const;
  
     /**
      * Get the time at the beginning of the current time slice.
@@ -598,6 +632,26 @@ SeeAlso: Simulate, Node
      * @return true if existing data files should be overwritten by devices. Default: false.
      */
     bool overwrite_files() const;
+
+    /**
+     * Indicate if recording devices shall write files through the AsyncWriter.
+     */
+    bool async_io() const;
+
+    /**
+     * Return the background writer for file output of recording devices.
+     */
+    AsyncWriter& get_async_writer();
+
+    /**
+     * Indicate if recording devices shall write into the RecordingContainer.
+     */
+    bool aggregate_files() const;
+
+    /**
+     * Return the container file for the output of recording devices.
+     */
+    RecordingContainer& get_recording_container();
     
     /**
      * return current communication style.
@@ -800,6 +854,10 @@ SeeAlso: Simulate, Node
     std::string data_path_;        //!< Path for all files written by devices 
     std::string data_prefix_;      //!< Prefix for all files written by devices
     bool        overwrite_files_;  //!< If true, overwrite existing data files. 
+    bool        async_io_;         //!< If true, devices write files through async_writer_
+    AsyncWriter async_writer_;     //!< Background writer for file output
+    bool        aggregate_files_;  //!< If true, devices write into recording_container_
+    RecordingContainer recording_container_; //!< Container file for the output of all devices
 
     /**
      * The list of clean models. The first component of the pair is a
@@ -1074,6 +1132,12 @@ SeeAlso: Simulate, Node
   {
     return scheduler_.get_max_delay();
   }
+
+  inline
+  delay Network::get_exchange_latency() const
+  {
+    return scheduler_.get_exchange_latency();
+  }
   
   template <class EventT>
   inline
@@ -1214,6 +1278,30 @@ SeeAlso: Simulate, Node
     return overwrite_files_;
   }
 
+  inline
+  bool Network::async_io() const
+  {
+    return async_io_;
+  }
+
+  inline
+  AsyncWriter& Network::get_async_writer()
+  {
+    return async_writer_;
+  }
+
+  inline
+  bool Network::aggregate_files() const
+  {
+    return aggregate_files_;
+  }
+
+  inline
+  RecordingContainer& Network::get_recording_container()
+  {
+    return recording_container_;
+  }
+
   inline
   bool Network::get_off_grid_communication() const
   {
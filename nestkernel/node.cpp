@@ -81,6 +81,15 @@ namespace nest {
     init_buffers_();
     stat_.set(buffers_initialized);
   }
+
+  void Node::update_population(std::vector<Node*>::const_iterator first,
+                               std::vector<Node*>::const_iterator last,
+                               std::vector<double_t>&,
+                               Time const & origin, const long_t from, const long_t to)
+  {
+    for ( ; first != last ; ++first )
+      (*first)->update(origin, from, to);
+  }
   
   std::string Node::get_name() const
   {
@@ -292,8 +301,8 @@ namespace nest {
   }
 
   void nest::Node::get_history(double_t, double_t,
-			       std::deque<histentry>::iterator*,
-			       std::deque<histentry>::iterator*)
+			       history_iterator*,
+			       history_iterator*)
   {
     throw UnexpectedEvent();
   }
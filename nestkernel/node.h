@@ -49,6 +49,7 @@ namespace nest {
   class Archiving_Node;
   class histentry;
   class Connector;
+  class ConnectionStore;
   class Connection;
 
   /**
@@ -192,8 +193,20 @@ namespace nest {
      */
     std::string get_name() const;
 
+    /**
+     * Return the address of the parameter block which the node may share
+     * with other nodes of its model, or 0 if the node holds its parameters
+     * itself. size is set to the size of the block in bytes.
+     * @see Network::memory_info()
+     */
+    virtual
+    const void* get_shared_parameters(size_t&) const { return 0; }
+
     virtual 
       void register_connector(nest::Connector&) {}
+
+    virtual
+      void register_connector(nest::ConnectionStore&) {}
      
     /**
      * Return global Network ID.
@@ -376,6 +389,27 @@ namespace nest {
     virtual 
     void update(Time const &, const long_t, const long_t)=0;
 
+    /**
+     * Bring the nodes in [first, last) from state $t$ to $t+n*dt$, as
+     * update() does for a single node.
+     *
+     * All nodes belong to the same model and thread. buffer is scratch
+     * memory of the thread, whose contents need not be preserved. The
+     * scheduler uses this function for runs of nodes of the same model
+     * if the kernel property population_update is set. This
+     * implementation updates the nodes one after the other. Models can
+     * hide it to update all nodes of the run at once, e.g., with the
+     * state in structure-of-arrays form. They must emit the spikes of
+     * each step in the order of the nodes.
+     *
+     * @see GenericModel::update_population()
+     */
+    static
+    void update_population(std::vector<Node*>::const_iterator first,
+                           std::vector<Node*>::const_iterator last,
+                           std::vector<double_t>& buffer,
+                           Time const &, const long_t, const long_t);
+
 
     /**
      * @defgroup status_interface Configuration interface.
@@ -614,8 +648,8 @@ namespace nest {
      */
      virtual
      void get_history(double_t t1, double_t t2, 
-                   std::deque<histentry>::iterator* start,
-  		   std::deque<histentry>::iterator* finish);
+                   history_iterator* start,
+  		   history_iterator* finish);
 
     /**
      * Modify Event object parameters during event delivery.
@@ -0,0 +1,243 @@
+/*
+ *  population_rkf45.cpp
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "population_rkf45.h"
+
+#include <cmath>
+#include <cfloat>
+#include <cassert>
+
+namespace
+{
+  // Runge-Kutta-Fehlberg coefficients, as in GSL's rkf45.c
+  const double ah[] = { 1.0/4.0, 3.0/8.0, 12.0/13.0, 1.0, 1.0/2.0 };
+  const double b3[] = { 3.0/32.0, 9.0/32.0 };
+  const double b4[] = { 1932.0/2197.0, -7200.0/2197.0, 7296.0/2197.0 };
+  const double b5[] = { 8341.0/4104.0, -32832.0/4104.0, 29440.0/4104.0, -845.0/4104.0 };
+  const double b6[] = { -6080.0/20520.0, 41040.0/20520.0, -28352.0/20520.0, 9295.0/20520.0, -5643.0/20520.0 };
+
+  const double c1 = 902880.0/7618050.0;
+  const double c3 = 3953664.0/7618050.0;
+  const double c4 = 3855735.0/7618050.0;
+  const double c5 = -1371249.0/7618050.0;
+  const double c6 = 277020.0/7618050.0;
+
+  // error coefficients
+  const double ec[] = { 0.0, 1.0/360.0, 0.0, -128.0/4275.0, -2197.0/75240.0, 1.0/50.0, 2.0/55.0 };
+
+  const double order = 5.0;
+}
+
+nest::PopulationRKF45::PopulationRKF45(std::vector<double_t>& buffer, size_t n, size_t dim, double_t eps_abs)
+  : n_(n),
+    dim_(dim),
+    eps_abs_(eps_abs),
+    params_(n, 0),
+    failed_(0)
+{
+  const size_t m = n * dim;
+  buffer.resize(6 * n + 11 * m);
+
+  double_t* p = n > 0 ? &buffer[0] : 0;
+  t_ = p;      p += n;
+  h_ = p;      p += n;
+  h0_ = p;     p += n;
+  active_ = p; p += n;
+  fresh_ = p;  p += n;
+  final_ = p;  p += n;
+
+  y_ = p;      p += m;
+  y0_ = p;     p += m;
+  hv_ = p;     p += m;
+  ytmp_ = p;   p += m;
+  yerr_ = p;   p += m;
+  k1_ = p;     p += m;
+  k2_ = p;     p += m;
+  k3_ = p;     p += m;
+  k4_ = p;     p += m;
+  k5_ = p;     p += m;
+  k6_ = p;
+}
+
+void nest::PopulationRKF45::set_system(size_t i, const double_t* y, double_t h, void* params)
+{
+  assert(i < n_);
+  for ( size_t j = 0 ; j < dim_ ; ++j )
+    y_[i * dim_ + j] = y[j];
+  h_[i] = h;
+  params_[i] = params;
+}
+
+bool nest::PopulationRKF45::evaluate_(Dynamics f, double_t c, const double_t* y, double_t* k, int& status)
+{
+  for ( size_t i = 0 ; i < n_ ; ++i )
+    if ( active_[i] != 0.0 )
+    {
+      status = f(t_[i] + c * h0_[i], y + i * dim_, k + i * dim_, params_[i]);
+      if ( status != 0 )
+      {
+        failed_ = i;
+        return false;
+      }
+    }
+  return true;
+}
+
+int nest::PopulationRKF45::integrate(Dynamics f, double_t t1)
+{
+  const size_t m = n_ * dim_;
+  int status = 0;
+
+  size_t n_active = 0;
+  for ( size_t i = 0 ; i < n_ ; ++i )
+  {
+    t_[i] = 0.0;
+    active_[i] = 0.0 < t1 ? 1.0 : 0.0;
+    fresh_[i] = 1.0;
+    n_active += active_[i] != 0.0;
+  }
+
+  while ( n_active > 0 )
+  {
+    // at the beginning of a step, save the state and compute the
+    // derivative there, it is reused if the step has to be repeated
+    for ( size_t i = 0 ; i < n_ ; ++i )
+      if ( active_[i] != 0.0 && fresh_[i] != 0.0 )
+      {
+        for ( size_t j = i * dim_ ; j < (i + 1) * dim_ ; ++j )
+          y0_[j] = y_[j];
+        h0_[i] = h_[i];
+        status = f(t_[i], y_ + i * dim_, k1_ + i * dim_, params_[i]);
+        if ( status != 0 )
+        {
+          failed_ = i;
+          return status;
+        }
+      }
+
+    // the last step ends exactly at t1
+    for ( size_t i = 0 ; i < n_ ; ++i )
+    {
+      const double_t dt = t1 - t_[i];
+      final_[i] = h0_[i] > dt ? 1.0 : 0.0;
+      h0_[i] = h0_[i] > dt ? dt : h0_[i];
+      for ( size_t j = i * dim_ ; j < (i + 1) * dim_ ; ++j )
+        hv_[j] = active_[i] != 0.0 ? h0_[i] : 0.0;
+    }
+
+    // stages, with the operations in the same order as in GSL
+    for ( size_t j = 0 ; j < m ; ++j )
+      ytmp_[j] = y_[j] + ah[0] * hv_[j] * k1_[j];
+    if ( !evaluate_(f, ah[0], ytmp_, k2_, status) )
+      return status;
+
+    for ( size_t j = 0 ; j < m ; ++j )
+      ytmp_[j] = y_[j] + hv_[j] * (b3[0] * k1_[j] + b3[1] * k2_[j]);
+    if ( !evaluate_(f, ah[1], ytmp_, k3_, status) )
+      return status;
+
+    for ( size_t j = 0 ; j < m ; ++j )
+      ytmp_[j] = y_[j] + hv_[j] * (b4[0] * k1_[j] + b4[1] * k2_[j] + b4[2] * k3_[j]);
+    if ( !evaluate_(f, ah[2], ytmp_, k4_, status) )
+      return status;
+
+    for ( size_t j = 0 ; j < m ; ++j )
+      ytmp_[j] = y_[j] + hv_[j] * (b5[0] * k1_[j] + b5[1] * k2_[j] + b5[2] * k3_[j] + b5[3] * k4_[j]);
+    if ( !evaluate_(f, ah[3], ytmp_, k5_, status) )
+      return status;
+
+    for ( size_t j = 0 ; j < m ; ++j )
+      ytmp_[j] = y_[j] + hv_[j] * (b6[0] * k1_[j] + b6[1] * k2_[j] + b6[2] * k3_[j] + b6[3] * k4_[j] + b6[4] * k5_[j]);
+    if ( !evaluate_(f, ah[4], ytmp_, k6_, status) )
+      return status;
+
+    // new state and error estimate; inactive systems keep their state
+    for ( size_t j = 0 ; j < m ; ++j )
+    {
+      const double_t d = c1 * k1_[j] + c3 * k3_[j] + c4 * k4_[j] + c5 * k5_[j] + c6 * k6_[j];
+      y_[j] = hv_[j] != 0.0 ? y_[j] + hv_[j] * d : y_[j];
+      yerr_[j] = hv_[j] * (ec[1] * k1_[j] + ec[3] * k3_[j] + ec[4] * k4_[j] + ec[5] * k5_[j] + ec[6] * k6_[j]);
+    }
+
+    // step size control as in gsl_odeiv_control_hadjust() and
+    // gsl_odeiv_evolve_apply()
+    for ( size_t i = 0 ; i < n_ ; ++i )
+    {
+      if ( active_[i] == 0.0 )
+        continue;
+
+      double_t rmax = DBL_MIN;
+      for ( size_t j = i * dim_ ; j < (i + 1) * dim_ ; ++j )
+      {
+        const double_t r = std::fabs(yerr_[j]) / std::fabs(eps_abs_);
+        rmax = r > rmax ? r : rmax;
+      }
+
+      const double_t h_old = h0_[i];
+      double_t h_new = h_old;
+      bool decrease = false;
+      if ( rmax > 1.1 )
+      {
+        double_t r = 0.9 / std::pow(rmax, 1.0 / order);
+        if ( r < 0.2 )
+          r = 0.2;
+        h_new = r * h_old;
+        decrease = true;
+      }
+      else if ( rmax < 0.5 )
+      {
+        double_t r = 0.9 / std::pow(rmax, 1.0 / (order + 1.0));
+        if ( r > 5.0 )
+          r = 5.0;
+        if ( r < 1.0 )
+          r = 1.0;
+        h_new = r * h_old;
+      }
+
+      const double_t t_new = final_[i] != 0.0 ? t1 : t_[i] + h_old;
+      if ( decrease )
+      {
+        if ( std::fabs(h_new) < std::fabs(h_old) && t_new + h_new != t_new )
+        {
+          // repeat the step with the smaller step size
+          for ( size_t j = i * dim_ ; j < (i + 1) * dim_ ; ++j )
+            y_[j] = y0_[j];
+          h0_[i] = h_new;
+          fresh_[i] = 0.0;
+          continue;
+        }
+        h_new = h_old;
+      }
+
+      t_[i] = t_new;
+      h_[i] = h_new;
+      fresh_[i] = 1.0;
+      if ( !(t_new < t1) )
+      {
+        active_[i] = 0.0;
+        --n_active;
+      }
+    }
+  }
+
+  return 0;
+}
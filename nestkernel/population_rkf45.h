@@ -0,0 +1,128 @@
+/*
+ *  population_rkf45.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef POPULATION_RKF45_H
+#define POPULATION_RKF45_H
+
+#include <vector>
+#include <cstddef>
+#include "nest.h"
+
+namespace nest
+{
+
+  /**
+   * Embedded Runge-Kutta-Fehlberg (4, 5) integrator for a population of
+   * ODE systems of equal dimension.
+   *
+   * The integrator advances each system over an interval with the same
+   * scheme as gsl_odeiv_evolve_apply() with gsl_odeiv_step_rkf45 and
+   * gsl_odeiv_control_y_new(eps_abs, 0.0), i.e., with an adaptive step
+   * size of its own for each system. All systems take their steps in
+   * lockstep, so that the stage sums are computed for the whole
+   * population in loops the compiler can vectorize. The right-hand sides
+   * are evaluated one system at a time by the dynamics function of the
+   * model, which has the signature required by GSL.
+   *
+   * The state vectors are stored one after the other in scratch memory
+   * provided by the caller, e.g., the buffer passed to
+   * Node::update_population(). The integrator does not allocate memory
+   * for each system. The buffer must not be resized while the
+   * integrator is in use.
+   *
+   * @note The derivative at the end of a step, which GSL computes for
+   *       the step size control, is not needed for eps_rel = 0 and is
+   *       therefore not evaluated.
+   */
+  class PopulationRKF45
+  {
+  public:
+    //! Dynamics function as used for gsl_odeiv_system
+    typedef int (*Dynamics)(double, const double*, double*, void*);
+
+    /**
+     * Lay out the integrator for n systems of dimension dim in buffer.
+     * @param eps_abs absolute error bound of the step size control
+     */
+    PopulationRKF45(std::vector<double_t>& buffer, size_t n, size_t dim, double_t eps_abs);
+
+    /**
+     * Set state, step size and parameter pointer of system i.
+     */
+    void set_system(size_t i, const double_t* y, double_t h, void* params);
+
+    //! Return the state vector of system i
+    double_t* y(size_t i) { return y_ + i * dim_; }
+
+    //! Return the current integration step size of system i
+    double_t h(size_t i) const { return h_[i]; }
+
+    /**
+     * Integrate all systems from 0 to t1.
+     * @return 0 on success, otherwise the non-zero status returned by
+     *         the dynamics function; failed() then gives the system.
+     */
+    int integrate(Dynamics f, double_t t1);
+
+    //! Return the system for which integrate() failed
+    size_t failed() const { return failed_; }
+
+  private:
+    /**
+     * Evaluate f for all active systems at time t + c * h.
+     * @return false if an evaluation failed.
+     */
+    bool evaluate_(Dynamics f, double_t c, const double_t* y, double_t* k, int& status);
+
+    size_t n_;       //!< number of systems
+    size_t dim_;     //!< dimension of each system
+    double_t eps_abs_;
+
+    std::vector<void*> params_;  //!< parameter pointer of each system
+
+    // arrays of n_ entries in the buffer
+    double_t* t_;      //!< time at the beginning of the current step
+    double_t* h_;      //!< step size of each system
+    double_t* h0_;     //!< size of the current step
+    double_t* active_; //!< 1.0 for systems that have not yet reached t1
+    double_t* fresh_;  //!< 1.0 if the current step is not a retry
+    double_t* final_;  //!< 1.0 if the current step ends at t1
+
+    // arrays of n_ * dim_ entries in the buffer
+    double_t* y_;
+    double_t* y0_;     //!< state at the beginning of the current step
+    double_t* hv_;     //!< current step size for each element, 0 for inactive systems
+    double_t* ytmp_;
+    double_t* yerr_;
+    double_t* k1_;
+    double_t* k2_;
+    double_t* k3_;
+    double_t* k4_;
+    double_t* k5_;
+    double_t* k6_;
+
+    size_t failed_;
+  };
+
+}
+
+#endif
@@ -0,0 +1,286 @@
+/*
+ *  recording_container.cpp
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "recording_container.h"
+
+#include <cassert>
+
+/* ----------------------------------------------------------------
+ * Container
+ * ---------------------------------------------------------------- */
+
+nest::RecordingContainer::Lane_::Lane_()
+  : data_(),
+    segments_()
+{
+#ifdef HAVE_ASYNC_WRITER
+  pthread_mutex_init(&mutex_, NULL);
+#endif
+}
+
+nest::RecordingContainer::Lane_::~Lane_()
+{
+#ifdef HAVE_ASYNC_WRITER
+  pthread_mutex_destroy(&mutex_);
+#endif
+}
+
+nest::RecordingContainer::RecordingContainer()
+  : data_(),
+    index_(),
+    basename_(),
+    offset_(0),
+    lanes_()
+{
+#ifdef HAVE_ASYNC_WRITER
+  pthread_mutex_init(&mutex_, NULL);
+#endif
+}
+
+nest::RecordingContainer::~RecordingContainer()
+{
+  close();
+#ifdef HAVE_ASYNC_WRITER
+  pthread_mutex_destroy(&mutex_);
+#endif
+}
+
+bool nest::RecordingContainer::open(const std::string& basename, bool overwrite, thread n_threads)
+{
+#ifdef HAVE_ASYNC_WRITER
+  pthread_mutex_lock(&mutex_);
+#endif
+
+  bool ok = data_.is_open();
+  if ( !ok )
+  {
+    const std::string dataname = basename + ".dat";
+    const std::string indexname = basename + ".idx";
+
+    std::ifstream test(dataname.c_str());
+    if ( overwrite || !test.good() )
+    {
+      data_.open(dataname.c_str(), std::ios::out | std::ios::binary);
+      index_.open(indexname.c_str());
+      index_ << "# gid vp offset bytes filename\n";
+    }
+    test.close();
+
+    ok = data_.good() && index_.good();
+    if ( ok )
+    {
+      basename_ = basename;
+      offset_ = 0;
+
+      // devices of other threads can only append once they have opened
+      // the container, too, so the lanes are complete by then
+      assert(lanes_.empty());
+      for ( thread t = 0; t < n_threads; ++t )
+        lanes_.push_back(new Lane_());
+    }
+    else
+    {
+      data_.close();
+      index_.close();
+    }
+  }
+
+#ifdef HAVE_ASYNC_WRITER
+  pthread_mutex_unlock(&mutex_);
+#endif
+  return ok;
+}
+
+void nest::RecordingContainer::close()
+{
+  clear_lanes_();
+
+  if ( data_.is_open() )
+    data_.close();
+  if ( index_.is_open() )
+    index_.close();
+  basename_.clear();
+  offset_ = 0;
+}
+
+void nest::RecordingContainer::clear_lanes_()
+{
+  for ( size_t t = 0; t < lanes_.size(); ++t )
+  {
+    write_lane_(*lanes_[t]);
+    delete lanes_[t];
+  }
+  lanes_.clear();
+}
+
+std::string nest::RecordingContainer::get_filename() const
+{
+  return data_.is_open() ? basename_ + ".dat" : std::string();
+}
+
+bool nest::RecordingContainer::append(thread t, index gid, thread vp, const std::string& filename,
+                                      const char* data, size_t n)
+{
+  assert(static_cast<size_t>(t) < lanes_.size());
+  Lane_& lane = *lanes_[t];
+
+#ifdef HAVE_ASYNC_WRITER
+  pthread_mutex_lock(&lane.mutex_);
+#endif
+
+  lane.data_.insert(lane.data_.end(), data, data + n);
+  const Segment_ segment = { gid, vp, n, filename };
+  lane.segments_.push_back(segment);
+
+  bool ok = true;
+  if ( lane.data_.size() >= AsyncWriter::chunk_size )
+    ok = write_lane_(lane);
+
+#ifdef HAVE_ASYNC_WRITER
+  pthread_mutex_unlock(&lane.mutex_);
+#endif
+  return ok;
+}
+
+bool nest::RecordingContainer::flush(thread t)
+{
+  assert(static_cast<size_t>(t) < lanes_.size());
+  Lane_& lane = *lanes_[t];
+
+#ifdef HAVE_ASYNC_WRITER
+  pthread_mutex_lock(&lane.mutex_);
+#endif
+
+  bool ok = write_lane_(lane);
+
+#ifdef HAVE_ASYNC_WRITER
+  pthread_mutex_lock(&mutex_);
+#endif
+
+  data_.flush();
+  index_.flush();
+  ok = ok && data_.good() && index_.good();
+
+#ifdef HAVE_ASYNC_WRITER
+  pthread_mutex_unlock(&mutex_);
+  pthread_mutex_unlock(&lane.mutex_);
+#endif
+  return ok;
+}
+
+bool nest::RecordingContainer::write_lane_(Lane_& lane)
+{
+  if ( lane.segments_.empty() )
+    return true;
+
+#ifdef HAVE_ASYNC_WRITER
+  pthread_mutex_lock(&mutex_);
+#endif
+
+  data_.write(&lane.data_[0], lane.data_.size());
+  for ( std::vector<Segment_>::const_iterator s = lane.segments_.begin(); s != lane.segments_.end(); ++s )
+  {
+    index_ << s->gid_ << ' ' << s->vp_ << ' ' << offset_ << ' ' << s->bytes_ << ' ' << s->filename_ << '\n';
+    offset_ += s->bytes_;
+  }
+  const bool ok = data_.good() && index_.good();
+
+#ifdef HAVE_ASYNC_WRITER
+  pthread_mutex_unlock(&mutex_);
+#endif
+
+  lane.data_.clear();
+  lane.segments_.clear();
+  return ok;
+}
+
+/* ----------------------------------------------------------------
+ * Stream buffer
+ * ---------------------------------------------------------------- */
+
+nest::ContainerStreamBuffer::ContainerStreamBuffer()
+  : std::streambuf(),
+    container_(0),
+    gid_(0),
+    vp_(0),
+    t_(0),
+    filename_(),
+    buffer_()
+{}
+
+nest::ContainerStreamBuffer::~ContainerStreamBuffer()
+{
+  close();
+}
+
+void nest::ContainerStreamBuffer::open(RecordingContainer& container, index gid, thread vp,
+                                       thread t, const std::string& filename)
+{
+  close();
+
+  container_ = &container;
+  gid_ = gid;
+  vp_ = vp;
+  t_ = t;
+  filename_ = filename;
+  buffer_.resize(AsyncWriter::chunk_size);
+  setp(&buffer_[0], &buffer_[0] + buffer_.size());
+}
+
+void nest::ContainerStreamBuffer::close()
+{
+  if ( container_ == 0 )
+    return;
+
+  hand_over_();
+  container_ = 0;
+  setp(0, 0);
+}
+
+nest::ContainerStreamBuffer::int_type nest::ContainerStreamBuffer::overflow(int_type c)
+{
+  if ( container_ == 0 || !hand_over_() )
+    return traits_type::eof();
+
+  if ( !traits_type::eq_int_type(c, traits_type::eof()) )
+    return sputc(traits_type::to_char_type(c));
+  return traits_type::not_eof(c);
+}
+
+int nest::ContainerStreamBuffer::sync()
+{
+  if ( container_ == 0 )
+    return 0;
+
+  const bool ok = hand_over_() && container_->flush(t_);
+  return ok ? 0 : -1;
+}
+
+bool nest::ContainerStreamBuffer::hand_over_()
+{
+  const size_t n = pptr() - pbase();
+  if ( n == 0 )
+    return true;
+
+  setp(&buffer_[0], &buffer_[0] + buffer_.size());
+  return container_->append(t_, gid_, vp_, filename_, &buffer_[0], n);
+}
@@ -0,0 +1,206 @@
+/*
+ *  recording_container.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef RECORDING_CONTAINER_H
+#define RECORDING_CONTAINER_H
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <streambuf>
+#include "nest.h"
+#include "async_writer.h"
+
+namespace nest
+{
+
+  /**
+   * Container file for the file output of all recording devices of one
+   * MPI process.
+   *
+   * With the kernel property aggregate_files, recording devices do not
+   * open a file of their own. Instead, they append the data they would
+   * have written to their file, in segments, to a single data file per
+   * process. For each segment, a line
+   *   gid vp offset bytes filename
+   * is appended to an index file, where offset and bytes give the
+   * position of the segment in the data file and filename the name of
+   * the file the device would have written. Concatenating all segments
+   * with the same filename in the order of the index reproduces that
+   * file. The data file has the extension dat, the index the extension
+   * idx.
+   *
+   * The container is opened when the first device needs it and closed
+   * when the nodes are deleted, e.g., by ResetKernel. All functions are
+   * thread-safe.
+   *
+   * Segments are first collected in a lane per simulation thread, which
+   * is locked only by the devices of that thread. A lane is written to
+   * the files, under the lock of the container, once it holds at least
+   * AsyncWriter::chunk_size bytes, when it is flushed, and when the
+   * container is closed. Since all output of a device goes through the
+   * lane of its thread, the order of its segments is kept.
+   *
+   * @see ContainerStreamBuffer, RecordingDevice
+   */
+  class RecordingContainer
+  {
+  public:
+    RecordingContainer();
+    ~RecordingContainer();
+
+    /**
+     * Open the container with the given base name and one lane for each
+     * of n_threads simulation threads, unless it is open.
+     * @return false if the files cannot be opened, or if they exist and
+     *         overwrite is false.
+     */
+    bool open(const std::string& basename, bool overwrite, thread n_threads);
+
+    /**
+     * Write all lanes and close the container.
+     */
+    void close();
+
+    /**
+     * Return the name of the data file, empty if not open.
+     */
+    std::string get_filename() const;
+
+    /**
+     * Append a segment of output of device gid on virtual process vp to
+     * the lane of simulation thread t.
+     * @return false if an I/O error occurred.
+     */
+    bool append(thread t, index gid, thread vp, const std::string& filename, const char* data, size_t n);
+
+    /**
+     * Write the lane of simulation thread t and flush data and index file.
+     * @return false if an I/O error occurred.
+     */
+    bool flush(thread t);
+
+  private:
+    RecordingContainer(const RecordingContainer&);            //!< not implemented
+    RecordingContainer& operator=(const RecordingContainer&); //!< not implemented
+
+    /**
+     * Entry of the index for a segment still held by a lane.
+     */
+    struct Segment_
+    {
+      index       gid_;
+      thread      vp_;
+      size_t      bytes_;
+      std::string filename_;
+    };
+
+    /**
+     * Segments of one simulation thread not yet written to the files.
+     */
+    struct Lane_
+    {
+      std::vector<char>     data_;      //!< data of all segments, in order
+      std::vector<Segment_> segments_;
+
+#ifdef HAVE_ASYNC_WRITER
+      // devices append from their simulation thread and from the writer thread
+      pthread_mutex_t mutex_;
+#endif
+
+      Lane_();
+      ~Lane_();
+    };
+
+    /**
+     * Write the segments of lane to the files and clear it. The caller
+     * must hold the lock of the lane.
+     * @return false if an I/O error occurred.
+     */
+    bool write_lane_(Lane_& lane);
+
+    /**
+     * Write the segments of all lanes and delete the lanes.
+     */
+    void clear_lanes_();
+
+    std::ofstream data_;     //!< the data file
+    std::ofstream index_;    //!< the index file
+    std::string   basename_; //!< base name of the open files
+    size_t        offset_;   //!< size of the data file
+    std::vector<Lane_*> lanes_; //!< one lane per simulation thread
+
+#ifdef HAVE_ASYNC_WRITER
+    // lanes of different threads are written to the files concurrently
+    mutable pthread_mutex_t mutex_;
+#endif
+  };
+
+  /**
+   * Stream buffer appending the output of one recording device to the
+   * RecordingContainer.
+   *
+   * The output is collected in a buffer of its own, which is appended as
+   * one segment when it is full or the stream is flushed. Flushing also
+   * flushes the container.
+   */
+  class ContainerStreamBuffer : public std::streambuf
+  {
+  public:
+    ContainerStreamBuffer();
+    ~ContainerStreamBuffer();
+
+    /**
+     * Append output of device gid on virtual process vp and simulation
+     * thread t, which would otherwise be written to filename, to container.
+     */
+    void open(RecordingContainer& container, index gid, thread vp, thread t,
+              const std::string& filename);
+
+    /**
+     * Append all output and detach from the container.
+     */
+    void close();
+
+    bool is_open() const { return container_ != 0; }
+
+  protected:
+    int_type overflow(int_type c);
+    int sync();
+
+  private:
+    ContainerStreamBuffer(const ContainerStreamBuffer&);            //!< not implemented
+    ContainerStreamBuffer& operator=(const ContainerStreamBuffer&); //!< not implemented
+
+    bool hand_over_();
+
+    RecordingContainer* container_;
+    index               gid_;
+    thread              vp_;
+    thread              t_;
+    std::string         filename_;
+    std::vector<char>   buffer_;
+  };
+
+}
+
+#endif
@@ -55,6 +55,7 @@ nest::RecordingDevice::Parameters_::Parameters_(const std::string& file_ext,
     precision_(3),
     scientific_(false),
     binary_(false),
+    format_("gdf"),
     fbuffer_size_(BUFSIZ), // default buffer size as defined in <cstdio>
     label_(),
     file_ext_(file_ext),
@@ -65,6 +66,24 @@ nest::RecordingDevice::Parameters_::Parameters_(const std::string& file_ext,
     close_on_reset_(true)
 {}
 
+nest::RecordingDevice::Buffers_::Buffers_()
+  : fs_(),
+    cbuf_(),
+    seg_(0),
+    abuf_(),
+    out_(0),
+    binary_(false),
+    col_sender_(false),
+    col_step_(false),
+    col_offset_(false),
+    col_weight_(false),
+    n_records_(0),
+    senders_(),
+    steps_(),
+    offsets_(),
+    weights_()
+{}
+
 nest::RecordingDevice::State_::State_()
   : events_(0),
     event_senders_(),
@@ -111,6 +130,8 @@ void nest::RecordingDevice::Parameters_::get(const RecordingDevice& rd,
   (*d)[names::scientific] = scientific_;
 
   (*d)[names::binary] = binary_;
+  if ( rd.mode_ != RecordingDevice::MULTIMETER )
+    (*d)[names::format] = LiteralDatum(format_);
   (*d)[names::fbuffer_size] = fbuffer_size_;
 
   (*d)[names::close_after_simulate] = close_after_simulate_;
@@ -142,6 +163,15 @@ void nest::RecordingDevice::Parameters_::set(const RecordingDevice& rd,
 
   updateValue<bool>(d, names::binary, binary_);
 
+  std::string format;
+  if ( rd.mode_ != RecordingDevice::MULTIMETER
+       && updateValue<std::string>(d, names::format, format) )
+  {
+    if ( format != "gdf" && format != "gdfb" )
+      throw BadProperty("/format must be /gdf or /gdfb.");
+    format_ = format;
+  }
+
   long fbuffer_size;
   if (updateValue<long>(d, names::fbuffer_size, fbuffer_size))
   {  
@@ -310,6 +340,15 @@ nest::RecordingDevice::RecordingDevice(const Node& n, Mode mode, const std::stri
  {}
 
 
+ nest::RecordingDevice::~RecordingDevice()
+ {
+   if ( is_open_() )
+   {
+     write_binary_block_();
+     B_.out_.flush();
+   }
+ }
+
  /* ----------------------------------------------------------------
   * Device initialization functions
   * ---------------------------------------------------------------- */
@@ -333,9 +372,9 @@ nest::RecordingDevice::RecordingDevice(const Node& n, Mode mode, const std::stri
    Device::init_buffers();
 
    // we only close files here, opening is left to calibrate()
-   if ( P_.close_on_reset_ && B_.fs_.is_open() )
+   if ( P_.close_on_reset_ && is_open_() )
    {
-     B_.fs_.close();
+     close_stream_();
      P_.filename_.clear();  // filename_ only visible while file open
    }
 
@@ -350,7 +389,7 @@ nest::RecordingDevice::RecordingDevice(const Node& n, Mode mode, const std::stri
      // do we need to (re-)open the file
      bool newfile = false;
 
-     if ( !B_.fs_.is_open() )
+     if ( !is_open_() )
      {
        newfile = true;   // no file from before
        P_.filename_ = build_filename_();
@@ -363,19 +402,40 @@ nest::RecordingDevice::RecordingDevice(const Node& n, Mode mode, const std::stri
          std::string msg = String::compose("Closing file '%1', opening file '%2'", P_.filename_, newname);
          Node::network()->message(SLIInterpreter::M_INFO, "RecordingDevice::calibrate()", msg);
 
-         B_.fs_.close(); // close old file
+         close_stream_(); // close old file
          P_.filename_ = newname;
          newfile = true;
        }
      }
 
-     if ( newfile )
+     if ( newfile && Node::network()->aggregate_files() )
      {
-       assert(!B_.fs_.is_open());
+       assert(!is_open_());
+
+       RecordingContainer& container = Node::network()->get_recording_container();
+       const std::string name = build_container_name_();
+       if ( !container.open(name, Node::network()->overwrite_files(), Node::network()->get_num_threads()) )
+       {
+         std::string msg = String::compose("Cannot open the recording container '%1.dat'. It may exist "
+                                           "already, in which case it will not be overwritten. Please "
+                                           "change data_path or data_prefix, or set /overwrite_files "
+                                           "to true in the root node.", name);
+         Node::network()->message(SLIInterpreter::M_ERROR, "RecordingDevice::calibrate()", msg);
+         P_.filename_.clear();
+         throw IOError();
+       }
+
+       B_.cbuf_.open(container, node_.get_gid(), node_.get_vp(), node_.get_thread(), P_.filename_);
+       B_.seg_.rdbuf(&B_.cbuf_);
+       P_.fbuffer_size_old_ = P_.fbuffer_size_;  // the container has its own buffer
+     }
+     else if ( newfile )
+     {
+       assert(!is_open_());
 
        if ( Node::network()->overwrite_files() )
        {
-         if ( P_.binary_ )
+         if ( P_.binary_ || P_.format_ == "gdfb" )
            B_.fs_.open(P_.filename_.c_str(), std::ios::out | std::ios::binary);
          else
            B_.fs_.open(P_.filename_.c_str());
@@ -396,7 +456,7 @@ nest::RecordingDevice::RecordingDevice(const Node& n, Mode mode, const std::stri
            test.close();
 
          // file does not exist, so we can open
-         if ( P_.binary_ )
+         if ( P_.binary_ || P_.format_ == "gdfb" )
            B_.fs_.open(P_.filename_.c_str(), std::ios::out | std::ios::binary);
          else
            B_.fs_.open(P_.filename_.c_str());
@@ -416,28 +476,46 @@ nest::RecordingDevice::RecordingDevice(const Node& n, Mode mode, const std::stri
        }
      }
 
-     if ( !B_.fs_.good() )
+     if ( !target_().good() )
      {
        std::string msg = String::compose("I/O error while opening file '%1'",P_.filename_);
        Node::network()->message(SLIInterpreter::M_ERROR, "RecordingDevice::calibrate()", msg);
                               
        if ( B_.fs_.is_open() )
          B_.fs_.close();
+       B_.cbuf_.close();
        P_.filename_.clear();
        throw IOError();
      }
 
+     if ( newfile )
+     {
+       // with async_io, the output is collected in chunks and written by
+       // the writer thread; the mode is fixed while the file is open
+       if ( Node::network()->async_io() )
+       {
+         B_.abuf_.open(Node::network()->get_async_writer(), node_.get_thread(), target_());
+         B_.out_.rdbuf(&B_.abuf_);
+       }
+       else
+         B_.out_.rdbuf(target_().rdbuf());
+
+       B_.binary_ = P_.format_ == "gdfb";
+       if ( B_.binary_ )
+         write_binary_header_();
+     }
+
      /* Set formatting
         Formatting is not applied to std::cout for screen output,
         since different devices may have different settings and
         this would lead to a mess.
       */
      if ( P_.scientific_ )
-       B_.fs_ << std::scientific;
+       B_.out_ << std::scientific;
      else
-       B_.fs_ << std::fixed;
+       B_.out_ << std::fixed;
 
-     B_.fs_ << std::setprecision(P_.precision_);
+     B_.out_ << std::setprecision(P_.precision_);
 
      if (P_.fbuffer_size_ != P_.fbuffer_size_old_)
      {
@@ -453,18 +531,23 @@ nest::RecordingDevice::RecordingDevice(const Node& n, Mode mode, const std::stri
 
  void nest::RecordingDevice::finalize()
  {
-   if ( B_.fs_.is_open() )
+   if ( is_open_() )
    {
      if ( P_.close_after_simulate_ )
      {
-       B_.fs_.close();
+       close_stream_();
        return;
      }
 
      if ( P_.flush_after_simulate_ )
-       B_.fs_.flush();
+     {
+       write_binary_block_();
+       B_.out_.flush();
+       B_.abuf_.wait();
+       target_().flush();
+     }
 
-     if ( !B_.fs_.good() )
+     if ( !target_().good() || !B_.out_.good() )
      {
        std::string msg = String::compose("I/O error while opening file '%1'",P_.filename_);
        Node::network()->message(SLIInterpreter::M_ERROR, "RecordingDevice::finalize()", msg);
@@ -495,9 +578,9 @@ void nest::RecordingDevice::set_status(const DictionaryDatum &d)
   P_ = ptmp;
   S_ = stmp;
 
-  if ( !P_.to_file_ && B_.fs_.is_open() )
+  if ( !P_.to_file_ && is_open_() )
   {
-    B_.fs_.close();
+    close_stream_();
     P_.filename_.clear();
   }
 
@@ -508,13 +591,18 @@ void nest::RecordingDevice::set_status(const DictionaryDatum &d)
 
 void nest::RecordingDevice::record_event(const Event& event, bool endrecord)
 {
-  ++S_.events_;
-  const index  sender = event.get_sender_gid();
-  const Time   stamp  = event.get_stamp();
-  const double offset = event.get_offset();
-  const double weight = event.get_weight();
+  record_(event.get_sender_gid(), event.get_stamp(), event.get_offset(), event.get_weight(), endrecord);
+}
 
-  //std::cout << "recording device sender: " << sender << std::endl;
+void nest::RecordingDevice::record_spike(index sender, const Time& stamp, double offset, double weight)
+{
+  record_(sender, stamp, offset, weight, true);
+}
+
+void nest::RecordingDevice::record_(index sender, const Time& stamp, double offset, double weight,
+                                    bool endrecord)
+{
+  ++S_.events_;
 
   if ( P_.to_screen_ )
   {
@@ -525,16 +613,18 @@ void nest::RecordingDevice::record_event(const Event& event, bool endrecord)
       std::cout << '\n';
   }
 
-  if ( P_.to_file_ )
+  if ( P_.to_file_ && B_.binary_ )
+    store_binary_(sender, stamp, offset, weight);
+  else if ( P_.to_file_ )
   {
-    print_id_(B_.fs_, sender);
-    print_time_(B_.fs_, stamp, offset);
-    print_weight_(B_.fs_, weight);
+    print_id_(B_.out_, sender);
+    print_time_(B_.out_, stamp, offset);
+    print_weight_(B_.out_, weight);
     if ( endrecord )
     {
-      B_.fs_ << '\n';
+      B_.out_ << '\n';
       if ( P_.flush_records_ )
-        B_.fs_.flush();
+        B_.out_.flush();
     }
   }
 
@@ -597,6 +687,124 @@ void nest::RecordingDevice::store_data_(index sender, const Time& t, double offs
     S_.event_weights_.push_back(weight);
 }
 
+void nest::RecordingDevice::store_binary_(index sender, const Time& t, double offs, double weight)
+{
+  if ( B_.col_sender_ )
+    B_.senders_.push_back(sender);
+  if ( B_.col_step_ )
+    B_.steps_.push_back(t.get_steps());
+  if ( B_.col_offset_ )
+    B_.offsets_.push_back(offs);
+  if ( B_.col_weight_ )
+    B_.weights_.push_back(weight);
+
+  if ( ++B_.n_records_ == Buffers_::block_records_ || P_.flush_records_ )
+  {
+    write_binary_block_();
+    if ( P_.flush_records_ )
+      B_.out_.flush();
+  }
+}
+
+void nest::RecordingDevice::write_binary_header_()
+{
+  B_.col_sender_ = P_.withgid_;
+  B_.col_step_   = P_.withtime_;
+  B_.col_offset_ = P_.withtime_ && P_.precise_times_;
+  B_.col_weight_ = P_.withweight_;
+
+  std::vector<std::string> names;
+  std::vector<uint32_t> types;
+  if ( B_.col_sender_ ) { names.push_back("sender"); types.push_back(0); }
+  if ( B_.col_step_ )   { names.push_back("step");   types.push_back(0); }
+  if ( B_.col_offset_ ) { names.push_back("offset"); types.push_back(1); }
+  if ( B_.col_weight_ ) { names.push_back("weight"); types.push_back(1); }
+
+  const uint32_t head[4] = { 0x01020304, 1, static_cast<uint32_t>(names.size()),
+                             static_cast<uint32_t>(Buffers_::block_records_) };
+  const double resolution = Time::get_resolution().get_ms();
+
+  B_.out_.write("NESTGDFB", 8);
+  B_.out_.write(reinterpret_cast<const char*>(head), sizeof(head));
+  B_.out_.write(reinterpret_cast<const char*>(&resolution), sizeof(resolution));
+  for ( size_t c = 0 ; c < names.size() ; ++c )
+  {
+    char name[16] = { 0 };
+    names[c].copy(name, sizeof(name) - 1);
+    const uint32_t type[2] = { types[c], 0 };
+    B_.out_.write(name, sizeof(name));
+    B_.out_.write(reinterpret_cast<const char*>(type), sizeof(type));
+  }
+
+  // reserve full blocks once, so that recording does not allocate
+  B_.n_records_ = 0;
+  B_.senders_.clear();
+  B_.steps_.clear();
+  B_.offsets_.clear();
+  B_.weights_.clear();
+  if ( B_.col_sender_ )
+    B_.senders_.reserve(Buffers_::block_records_);
+  if ( B_.col_step_ )
+    B_.steps_.reserve(Buffers_::block_records_);
+  if ( B_.col_offset_ )
+    B_.offsets_.reserve(Buffers_::block_records_);
+  if ( B_.col_weight_ )
+    B_.weights_.reserve(Buffers_::block_records_);
+}
+
+void nest::RecordingDevice::write_binary_block_()
+{
+  if ( !B_.binary_ || B_.n_records_ == 0 )
+    return;
+
+  const uint64_t n = B_.n_records_;
+  B_.out_.write(reinterpret_cast<const char*>(&n), sizeof(n));
+  if ( B_.col_sender_ )
+    B_.out_.write(reinterpret_cast<const char*>(&B_.senders_[0]), n * sizeof(int64_t));
+  if ( B_.col_step_ )
+    B_.out_.write(reinterpret_cast<const char*>(&B_.steps_[0]), n * sizeof(int64_t));
+  if ( B_.col_offset_ )
+    B_.out_.write(reinterpret_cast<const char*>(&B_.offsets_[0]), n * sizeof(double));
+  if ( B_.col_weight_ )
+    B_.out_.write(reinterpret_cast<const char*>(&B_.weights_[0]), n * sizeof(double));
+
+  // clear() keeps the reserved memory for the next block
+  B_.n_records_ = 0;
+  B_.senders_.clear();
+  B_.steps_.clear();
+  B_.offsets_.clear();
+  B_.weights_.clear();
+}
+
+void nest::RecordingDevice::close_stream_()
+{
+  write_binary_block_();
+  B_.out_.flush();
+  B_.abuf_.close();
+  B_.out_.rdbuf(0);
+  if ( B_.fs_.is_open() )
+    B_.fs_.close();
+  else
+  {
+    B_.seg_.flush();
+    B_.cbuf_.close();
+    B_.seg_.rdbuf(0);
+  }
+  B_.binary_ = false;
+}
+
+bool nest::RecordingDevice::is_open_() const
+{
+  return B_.fs_.is_open() || B_.cbuf_.is_open();
+}
+
+std::ostream& nest::RecordingDevice::target_()
+{
+  if ( B_.cbuf_.is_open() )
+    return B_.seg_;
+  return B_.fs_;
+}
+
 const std::string nest::RecordingDevice::build_filename_() const
 {
   // number of digits in number of virtual processes
@@ -620,6 +828,20 @@ const std::string nest::RecordingDevice::build_filename_() const
   return basename.str() + '.' + P_.file_ext_;
 }
 
+const std::string nest::RecordingDevice::build_container_name_()
+{
+  // number of digits in number of processes
+  const int rankdigits = static_cast<int>(std::floor(std::log10(static_cast<float>(Communicator::get_num_processes()))) + 1);
+
+  std::ostringstream basename;
+  const std::string& path = Node::network()->get_data_path();
+  if ( !path.empty() )
+    basename << path << '/';
+  basename << Node::network()->get_data_prefix() << "recordings"
+           << "-" << std::setfill('0') << std::setw(rankdigits) << Communicator::get_rank();
+  return basename.str();
+}
+
 void nest::RecordingDevice::State_::clear_events()
 {
   events_ = 0;
@@ -28,9 +28,12 @@
 #include "dictutils.h"
 #include "lockptr.h"
 #include "device.h"
+#include "async_writer.h"
+#include "recording_container.h"
 
 #include <vector>
 #include <fstream>
+#include <stdint.h>
 
 namespace nest {
 
@@ -76,6 +79,14 @@ namespace nest {
     - The device will not open an existing file, since that would erase the existing
       data in the file. If you want existing files to be overwritten automatically,
       you must set /overwrite_files in the root node.
+    - If /async_io is set in the root node, files opened afterwards are written by
+      a background thread during Simulate. With /flush_after_simulate, all output
+      has been written when Simulate returns.
+    - If /aggregate_files is set in the root node, devices opening a file afterwards
+      append their output to a container file per MPI process instead,
+        data_path/data_prefix"recordings"-rank.dat,
+      with an index in a file ending in .idx. /filenames then gives the names of
+      the files the device would have written, which are listed in the index.
 
     Parameters:
     The following parameters are shared with all devices:
@@ -152,6 +163,9 @@ namespace nest {
     /precision     - number of digits to use in output of doubles to file (default: 3)
     /binary        - if set to true, data is written in binary mode to files instead of ASCII.
                      This setting affects file output only, not screen output (default: false)
+    /format        - file format of spike and spin detectors: /gdf writes text as set by the
+                     parameters above, /gdfb writes a columnar binary block format, see below.
+                     This setting affects file output only (default: /gdf).
     /fbuffer_size  - the size of the buffer to use for writing to files. The default size is
                      determined by the implementation of the C++ standard library. To obtain an
                      unbuffered file stream, use a buffer size of 0.
@@ -166,6 +180,32 @@ namespace nest {
                      /precise_times and /withtime are true). All data stored in memory
                      is erased when /n_events is set to 0. 
                                           
+    Binary block file format:
+    Spike and spin detectors with /format /gdfb buffer their records and write
+    them in blocks of up to 16384 records. All values are in the native byte
+    order of the writing machine and all blocks start at multiples of 8 bytes,
+    so that files can be memory mapped. A file starts with a header
+      char[8]   magic string NESTGDFB
+      uint32    byte order mark 0x01020304
+      uint32    format version, currently 1
+      uint32    number of columns c
+      uint32    maximal number of records per block
+      double    simulation resolution in ms
+    followed by c column descriptions
+      char[16]  column name, padded with NUL
+      uint32    column type, 0 for int64, 1 for double
+      uint32    reserved, 0
+    Each block consists of
+      uint64    number of records n
+    followed by the n values of each column, one column after the other.
+    The columns, in this order, are sender (int64, if /withgid is true), step
+    (int64, if /withtime is true), offset (double, if /withtime and
+    /precise_times are true) and weight (double, if /withweight is true).
+    The spike time in ms is (step - offset) * resolution; /time_in_steps,
+    /precision, /scientific and /binary do not apply. The columns are fixed
+    when the file is opened. With /flush_records true, every record is written as a
+    block of its own.
+
     SeeAlso: Device, StimulatingDevice
   */
 
@@ -237,7 +277,11 @@ namespace nest {
      * @param Prototype member to copy
      */
     RecordingDevice(const Node&, const RecordingDevice&);
-    virtual ~RecordingDevice() {}
+
+    /**
+     * Write pending output before the file is closed.
+     */
+    virtual ~RecordingDevice();
 
     using Device::init_parameters;
     void init_parameters(const RecordingDevice&);
@@ -274,6 +318,15 @@ namespace nest {
      * @param endrecord pass false if more data is to come on same line
      */
     void record_event(const Event&, bool endrecord = true);
+
+    /**
+     * Record a spike from the given sender.
+     *
+     * This is equivalent to record_event() for a SpikeEvent with the
+     * given properties. It allows devices to buffer spikes without
+     * keeping copies of the events.
+     */
+    void record_spike(index sender, const Time& stamp, double offset, double weight);
     
     /**
      * Print single item of type ValueT.
@@ -349,10 +402,47 @@ namespace nest {
      */ 
     void print_weight_(std::ostream&, double);
 
+    /**
+     * Record common information for one event.
+     * @see record_event()
+     */
+    void record_(index sender, const Time& stamp, double offset, double weight, bool endrecord);
+
     /**
      * Store data in internal structure.
      */  
     void store_data_(index, const Time&, double, double);
+
+    /**
+     * Append a record to the current block of binary output.
+     * The block is written to file when it is full.
+     */
+    void store_binary_(index, const Time&, double, double);
+
+    /**
+     * Write the header of a binary file and prepare the block buffers.
+     */
+    void write_binary_header_();
+
+    /**
+     * Write the current block of binary output to file, if it is not empty.
+     */
+    void write_binary_block_();
+
+    /**
+     * Write any pending output and close the file.
+     */
+    void close_stream_();
+
+    /**
+     * Indicate if output goes to a file or to the RecordingContainer.
+     */
+    bool is_open_() const;
+
+    /**
+     * Return the stream writing to the file or the RecordingContainer.
+     */
+    std::ostream& target_();
     
     /**
      * Clear data in internal structure, and call clear_data_hook().
@@ -371,11 +461,37 @@ namespace nest {
      *       any data member.
      */
     const std::string build_filename_() const;
+
+    /**
+     * Build the base name of the RecordingContainer of this process.
+     */
+    static const std::string build_container_name_();
  
     // ------------------------------------------------------------------
     
     struct Buffers_ {
       std::ofstream fs_; //!< the file to write the recorded data to
+      ContainerStreamBuffer cbuf_; //!< appends output to the RecordingContainer instead
+      std::ostream seg_; //!< stream on cbuf_
+      AsyncStreamBuffer abuf_; //!< collects output for the AsyncWriter
+      std::ostream out_; //!< all output goes here, to abuf_ or the target
+
+      //! Maximal number of records in a block of binary output
+      static const size_t block_records_ = 16384;
+
+      bool binary_;      //!< true if the open file uses the binary block format
+      bool col_sender_;  //!< true if the open file has a sender column
+      bool col_step_;    //!< true if the open file has a step column
+      bool col_offset_;  //!< true if the open file has an offset column
+      bool col_weight_;  //!< true if the open file has a weight column
+
+      size_t               n_records_;  //!< number of records in current block
+      std::vector<int64_t> senders_;    //!< sender column of current block
+      std::vector<int64_t> steps_;      //!< step column of current block
+      std::vector<double>  offsets_;    //!< offset column of current block
+      std::vector<double>  weights_;    //!< weight column of current block
+
+      Buffers_();
     };
 
     // ------------------------------------------------------------------
@@ -395,6 +511,7 @@ namespace nest {
       bool scientific_;    //!< use scientific format if true, else fixed
 
       bool binary_;            //!< true if to write files in binary mode instead of ASCII   
+      std::string format_;     //!< file format of spike and spin detectors, gdf or gdfb
       long fbuffer_size_;      //!< the buffer size to use when writing to file
       long fbuffer_size_old_;  //!< the buffer size to use when writing to file (old)
 
@@ -485,9 +602,9 @@ void RecordingDevice::print_value(const ValueT& value, bool endrecord)
 
   if ( P_.to_file_ )
   {
-    B_.fs_ << value << '\t';
+    B_.out_ << value << '\t';
     if ( endrecord )
-      B_.fs_ << '\n';
+      B_.out_ << '\n';
   }
 }
 
@@ -43,6 +43,9 @@
 #endif
 
 #include <climits>
+#include <limits>
+#include <cstring>
+#include <algorithm>
 #include "network.h"
 #include "exceptions.h"
 #include "scheduler.h"
@@ -67,6 +70,7 @@ extern int SLIsignalflag;
 
 std::vector<nest::delay> nest::Scheduler::moduli_;
 std::vector<nest::delay> nest::Scheduler::slice_moduli_;
+std::vector<std::vector<size_t> > nest::Scheduler::sort_buffers_;
 
 nest::delay nest::Scheduler::max_delay_ = 1;
 nest::delay nest::Scheduler::min_delay_ = 1;
@@ -92,8 +96,17 @@ nest::Scheduler::Scheduler(Network &net)
           terminate_(false),
 	  is_prepared_(false),
           off_grid_spiking_(false),
+          compress_spikes_(false),
+          packed_exchange_(false),
+          offgrid_exchange_(false),
+          overlap_communication_(false),
+          exchange_in_flight_(false),
+          exchange_latency_(1),
           print_time_(false),
-          rng_()
+          population_update_(false),
+          rng_(),
+          register_capacity_(1),
+          offgrid_registers_(false)
 {
   init_();
 }
@@ -114,6 +127,7 @@ void nest::Scheduler::reset()
   slice_ = 0;
   from_step_ = 0;
   to_step_ = 0;   // consistent with to_do_ = 0
+  finish_exchange_();
   finalize_();
   init_();
 }
@@ -129,7 +143,16 @@ void nest::Scheduler::init_()
 
   simulated_ = false;
   is_prepared_=false;
+
+  // force a rebuild of the target rank table
+  target_ranks_num_source_threads_ = std::numeric_limits<size_t>::max();
+  target_ranks_network_size_ = 0;
+  target_rank_sources_.clear();
+  target_rank_offsets_.clear();
+  target_ranks_.clear();
+
   min_delay_ = max_delay_ = 0;
+  exchange_latency_ = 1;
   update_ref_ = true;
 
 #ifdef HAVE_PTHREADS
@@ -148,6 +171,16 @@ void nest::Scheduler::init_()
 	       "Error initializing condition variable ready_");
     throw PthreadException(status);
   }
+
+  status = pthread_cond_init(&partitioned_, NULL);
+  if(status != 0)
+  {
+    net_.message(SLIInterpreter::M_ERROR, "Scheduler::reset",
+	       "Error initializing condition variable partitioned_");
+    throw PthreadException(status);
+  }
+  partition_counter_ = 0;
+  partition_generation_ = 0;
 #else
 #ifndef _OPENMP
   if (n_threads_ > 1)
@@ -188,6 +221,14 @@ void nest::Scheduler::finalize_()
 	       "Error in destruction of condition variable ready_");
     throw PthreadException(status);
   }
+
+  status = pthread_cond_destroy(&partitioned_);
+  if(status != 0)
+  {
+    net_.message(SLIInterpreter::M_ERROR, "Scheduler::reset",
+	       "Error in destruction of condition variable partitioned_");
+    throw PthreadException(status);
+  }
 #endif
 
   // clear the buffers
@@ -277,6 +318,12 @@ void nest::Scheduler::configure_spike_buffers_()
 {
   assert(min_delay_ != 0);
 
+  // spikes still in flight are discarded with all others
+  finish_exchange_();
+
+  register_fill_.clear();
+  register_fill_.resize(n_threads_, std::vector<size_t>(min_delay_, 0));
+
   spike_register_.clear();
   // the following line does not compile with gcc <= 3.3.5
   spike_register_.resize(n_threads_, std::vector<std::vector<uint_t> >(min_delay_));
@@ -291,23 +338,43 @@ void nest::Scheduler::configure_spike_buffers_()
       for (size_t k = 0; k < offgrid_spike_register_[j].size(); ++k)
       	offgrid_spike_register_[j][k].clear();
 
+  spike_batch_.clear();
+  spike_batch_.resize(n_threads_);
+  spike_lanes_.clear();
+  spike_lanes_.resize(n_threads_, std::vector<std::vector<BatchedSpike> >(n_threads_));
+
   //send_buffer must be >= 2 as the 'overflow' signal takes up 2 spaces.
   int send_buffer_size = n_threads_ * min_delay_ > 2 ? n_threads_ * min_delay_ : 2;
+  // packed buffers are measured in bytes and start with a header; the
+  // Communicator adapts their size to the actual spike load
+  if (compress_spikes_ || overlap_communication_ || Communicator::get_use_Alltoallv())
+    send_buffer_size += Communicator::PACKED_HEADER_SIZE;
   int recv_buffer_size = send_buffer_size * Communicator::get_num_processes();
   Communicator::set_buffer_sizes(send_buffer_size, recv_buffer_size);
 
+  // the buffers are swapped with new ones, since clear() would keep the
+  // memory of segments that were enlarged during earlier simulations
   // DEC cxx required 0U literal, HEP 2007-03-26
-  local_grid_spikes_.clear();
-  local_grid_spikes_.resize(send_buffer_size, 0U);
-  local_offgrid_spikes_.clear();
-  local_offgrid_spikes_.resize(send_buffer_size, OffGridSpike(0,0.0));
-  global_grid_spikes_.clear();
-  global_grid_spikes_.resize(recv_buffer_size, 0U);
-  global_offgrid_spikes_.clear();
-  global_offgrid_spikes_.resize(recv_buffer_size, OffGridSpike(0,0.0));
+  std::vector<uint_t>(send_buffer_size, 0U).swap(local_grid_spikes_);
+  std::vector<OffGridSpike>(send_buffer_size, OffGridSpike(0,0.0)).swap(local_offgrid_spikes_);
+  std::vector<uint_t>(recv_buffer_size, 0U).swap(global_grid_spikes_);
+  std::vector<OffGridSpike>(recv_buffer_size, OffGridSpike(0,0.0)).swap(global_offgrid_spikes_);
+  std::vector<unsigned char>().swap(local_packed_spikes_);
+  std::vector<unsigned char>().swap(global_packed_spikes_);
+  std::vector<unsigned char>().swap(pending_packed_spikes_);
+  std::vector<std::pair<uint_t, double_t> >().swap(lag_spikes_);
+  packed_exchange_ = compress_spikes_ || overlap_communication_ || Communicator::get_use_Alltoallv();
+  offgrid_exchange_ = off_grid_spiking_;
+  send_counts_.clear();
+  send_counts_.resize(Communicator::get_num_processes(), 0);
+  recv_counts_.clear();
+  recv_counts_.resize(Communicator::get_num_processes(), 0);
 
   displacements_.clear();
   displacements_.resize(Communicator::get_num_processes(), 0);
+
+  // the registers are laid out to fill the default send buffer exactly
+  clear_spike_registers_(packed_exchange_ ? 1 : send_buffer_size / (n_threads_ * min_delay_));
 }
 
 void nest::Scheduler::clear_nodes_vec_()
@@ -400,6 +467,16 @@ void nest::Scheduler::prepare_simulation()
   // this call sets the member variables
   compute_delay_extrema_(min_delay_, max_delay_);
 
+  // If the spike exchange overlaps with the update, the spikes of a
+  // slice are only delivered at the beginning of the slice after next,
+  // so each slice may only be half as long as the minimal delay.
+  exchange_latency_ = 1;
+  if (overlap_communication_ && min_delay_ >= 2)
+  {
+    exchange_latency_ = 2;
+    min_delay_ /= 2;
+  }
+
   // Check for synchronicity of global rngs over processes
   if(Communicator::get_num_processes() > 1)
     if (!Communicator::grng_synchrony(grng_->ulrand(100000)))
@@ -484,6 +561,13 @@ void nest::Scheduler::resume()
 
   simulating_ = true;
 
+  net_.connection_manager_.sort_stores();
+  update_target_ranks_();
+
+  // recording devices hand their file output to the writer thread
+  if (net_.async_io())
+    net_.async_writer_.start(n_threads_);
+
   if (n_threads_ == 1)
     serial_update();
   else
@@ -511,6 +595,9 @@ void nest::Scheduler::resume()
   simulating_ = false;
   finalize_nodes();
 
+  // write the chunks of devices that do not flush after Simulate
+  net_.async_writer_.stop();
+
   if (print_time_)
     std::cout << std::endl;
 
@@ -543,8 +630,6 @@ void nest::Scheduler::resume()
  */
 void nest::Scheduler::serial_update()
 {
-  std::vector<Node*>::iterator i;
-
   do
   {
     if (print_time_)
@@ -565,8 +650,7 @@ void nest::Scheduler::serial_update()
 #endif
     }
 
-    for (i = nodes_vec_[0].begin(); i != nodes_vec_[0].end(); ++i)
-      update_(*i);
+    update_nodes_(0);
 
     if ( static_cast<ulong_t>(to_step_) == min_delay_ ) // gather only at end of slice
       gather_events_();
@@ -631,8 +715,7 @@ void nest::Scheduler::threaded_update_openmp()
 #endif
 	}
 
-      for (std::vector<Node*>::iterator i = nodes_vec_[t].begin(); i != nodes_vec_[t].end(); ++i)
-	update_(*i);
+      update_nodes_(t);
 
       // parallel section ends, wait until all threads are done -> synchronize
 #pragma omp barrier
@@ -748,9 +831,7 @@ void nest::Scheduler::threaded_update(thread t)
 #endif
     }
 
-    vector<Node*>::iterator i;
-    for(i = nodes_vec_[t].begin(); i != nodes_vec_[t].end(); ++i)
-      update_(*i);
+    update_nodes_(t);
 
     ready_mutex_.lock();
 
@@ -825,6 +906,39 @@ void nest::Scheduler::threaded_update(thread)
 }
 #endif
 
+void nest::Scheduler::update_nodes_(thread t)
+{
+  const std::vector<Node*>& nodes = nodes_vec_[t];
+  if ( !population_update_ )
+  {
+    for (std::vector<Node*>::const_iterator i = nodes.begin(); i != nodes.end(); ++i)
+      update_(*i);
+    return;
+  }
+
+  // update each run of nodes of the same model at once
+  std::vector<Node*>::const_iterator first = nodes.begin();
+  while (first != nodes.end())
+  {
+    const int model_id = (*first)->get_model_id();
+    std::vector<Node*>::const_iterator last = first + 1;
+    while (last != nodes.end() && (*last)->get_model_id() == model_id)
+      ++last;
+
+    if (last - first == 1 || model_id < 0)
+      for (std::vector<Node*>::const_iterator i = first; i != last; ++i)
+        update_(*i);
+    else
+    {
+      net_.get_model(model_id)->update_population(first, last, population_buffers_[t],
+                                                  clock_, from_step_, to_step_);
+      for (std::vector<Node*>::const_iterator i = first; i != last; ++i)
+        (*i)->flip(Node::updated);
+    }
+    first = last;
+  }
+}
+
 void nest::Scheduler::prepare_nodes()
 {
   assert(initialized_);
@@ -840,6 +954,10 @@ void nest::Scheduler::prepare_nodes()
      in case nodes have been added or deleted between Simulate calls.
    */
   clear_nodes_vec_();
+  population_buffers_.resize(n_threads_);
+  sort_buffers_.resize(n_threads_);
+  for (index t = 0; t < n_threads_; ++t)
+    sort_buffers_[t].resize(2 * min_delay_ + 1);
 
 #ifdef _OPENMP
 #pragma omp parallel
@@ -1077,12 +1195,57 @@ void nest::Scheduler::set_status(DictionaryDatum const &d)
   }
 
   updateValue<bool>(d, "off_grid_spiking", off_grid_spiking_);
+  bool compress;
+  if (updateValue<bool>(d, "compress_spikes", compress) && compress != compress_spikes_)
+  {
+    if (simulated_)
+    {
+      net_.message(SLIInterpreter::M_ERROR, "Scheduler::set_status",
+                   "Cannot change compress_spikes after the simulation has started.");
+      throw KernelException();
+    }
+    compress_spikes_ = compress;
+  }
+
+  // the overlapping exchange always uses MPI_Allgather, so it cannot be
+  // combined with the sparse exchange
+  bool overlap = overlap_communication_;
+  bool comm_alltoallv = Communicator::get_use_Alltoallv();
+  updateValue<bool>(d, "overlap_communication", overlap);
+  updateValue<bool>(d, "communicate_alltoallv", comm_alltoallv);
+  if (overlap && comm_alltoallv)
+    throw BadProperty("overlap_communication cannot be combined with communicate_alltoallv.");
+
+  if (updateValue<bool>(d, "overlap_communication", overlap) && overlap != overlap_communication_)
+  {
+    if (simulated_)
+    {
+      net_.message(SLIInterpreter::M_ERROR, "Scheduler::set_status",
+                   "Cannot change overlap_communication after the simulation has started.");
+      throw KernelException();
+    }
+    overlap_communication_ = overlap;
+  }
+
+  updateValue<bool>(d, "population_update", population_update_);
 
   bool comm_allgather;
   bool commstyle_updated = updateValue<bool>(d, "communicate_allgather", comm_allgather);
   if (commstyle_updated)
       Communicator::set_use_Allgather(comm_allgather);
 
+  if (updateValue<bool>(d, "communicate_alltoallv", comm_alltoallv)
+      && comm_alltoallv != Communicator::get_use_Alltoallv())
+  {
+    if (simulated_)
+    {
+      net_.message(SLIInterpreter::M_ERROR, "Scheduler::set_status",
+                   "Cannot change communicate_alltoallv after the simulation has started.");
+      throw KernelException();
+    }
+    Communicator::set_use_Alltoallv(comm_alltoallv);
+  }
+
   // set RNGs --- MUST come after n_threads_ is updated
   if (d->known("rngs"))
   {
@@ -1248,7 +1411,11 @@ void nest::Scheduler::get_status(DictionaryDatum &d) const
   (*d)["rng_seeds"] = Token(rng_seeds_);
   def<long>(d, "grng_seed", grng_seed_);
   def<bool>(d, "off_grid_spiking", off_grid_spiking_);
+  def<bool>(d, "compress_spikes", compress_spikes_);
+  def<bool>(d, "overlap_communication", overlap_communication_);
+  def<bool>(d, "population_update", population_update_);
   def<bool>(d, "communicate_allgather", Communicator::get_use_Allgather());
+  def<bool>(d, "communicate_alltoallv", Communicator::get_use_Alltoallv());
 }
 
 void nest::Scheduler::create_rngs_(const bool ctor_call)
@@ -1345,218 +1512,514 @@ void nest::Scheduler::create_grng_(const bool ctor_call)
 }
 
 
-void nest::Scheduler::collocate_buffers_()
+void nest::Scheduler::clear_spike_registers_(size_t capacity)
 {
-  //count number of spikes in registers
-  int num_spikes = 0;
-  int num_grid_spikes = 0;
-  int num_offgrid_spikes = 0;
-
-  std::vector<std::vector<std::vector<uint_t> > >::iterator i;
-  std::vector<std::vector<uint_t> >::iterator j;
-  for (i = spike_register_.begin(); i != spike_register_.end(); ++i)
-    for (j = i->begin(); j != i->end(); ++j)
-      num_grid_spikes += j->size();
-
-  std::vector<std::vector<std::vector<OffGridSpike> > >::iterator it;
-  std::vector<std::vector<OffGridSpike> >::iterator jt;
-  for (it = offgrid_spike_register_.begin(); it != offgrid_spike_register_.end(); ++it)
-    for (jt = it->begin(); jt != it->end(); ++jt)
-      num_offgrid_spikes += jt->size();
-
-  num_spikes = num_grid_spikes + num_offgrid_spikes;
-  if (!off_grid_spiking_)  //on grid spiking
-  {
-    // make sure buffers are correctly sized and empty
-    std::vector<uint_t> tmp(global_grid_spikes_.size(), 0);
-    global_grid_spikes_.swap(tmp);
-
-    if (global_grid_spikes_.size() != static_cast<uint_t>(Communicator::get_recv_buffer_size()))
-      global_grid_spikes_.resize(Communicator::get_recv_buffer_size(), 0);
-
-    std::vector<uint_t> tmp2(local_grid_spikes_.size(), 0);
-    local_grid_spikes_.swap(tmp2);
-
-    if (num_spikes + (n_threads_ * min_delay_) > static_cast<uint_t>(Communicator::get_send_buffer_size()))
-      local_grid_spikes_.resize((num_spikes + (min_delay_ * n_threads_)),0);
-    else if (local_grid_spikes_.size() < static_cast<uint_t>(Communicator::get_send_buffer_size()))
-      local_grid_spikes_.resize(Communicator::get_send_buffer_size(), 0);
-
-
-    // collocate the entries of spike_registers into local_grid_spikes__
-    std::vector<uint_t>::iterator pos = local_grid_spikes_.begin();
-    if (num_offgrid_spikes == 0)
-      for (i = spike_register_.begin(); i != spike_register_.end(); ++i)
-        for (j = i->begin(); j != i->end(); ++j)
-        {
-          pos = std::copy(j->begin(), j->end(), pos);
-          *pos = comm_marker_;
-          ++pos;
-        }
-    else
+  register_capacity_ = std::max(capacity, static_cast<size_t>(1));
+  offgrid_registers_ = off_grid_spiking_;
+
+  // entries beyond the fill of each segment are never read, so the
+  // buffer is not cleared
+  const size_t size = register_capacity_ * n_threads_ * min_delay_;
+  if (offgrid_registers_)
+    local_offgrid_spikes_.resize(size, OffGridSpike(comm_marker_, 0.0));
+  else
+    local_grid_spikes_.resize(size, comm_marker_);
+
+  for (index t = 0; t < n_threads_; ++t)
+    for (delay lag = 0; lag < min_delay_; ++lag)
     {
-      std::vector<OffGridSpike>::iterator n;
-      it = offgrid_spike_register_.begin();
-      for (i = spike_register_.begin(); i != spike_register_.end(); ++i)
-      {
-        jt = it->begin();
-        for (j = i->begin(); j != i->end(); ++j)
-        {
-          pos = std::copy(j->begin(), j->end(), pos);
-          for (n = jt->begin() ; n != jt->end() ; ++n )
-          {
-            *pos = n->get_gid();
-            ++pos;
-          }
-          *pos = comm_marker_;
-          ++pos;
-          ++jt;
-        }
-        ++it;
-      }
-      for (it = offgrid_spike_register_.begin(); it != offgrid_spike_register_.end(); ++it)
-        for (jt = it->begin(); jt != it->end(); ++jt)
-	  jt->clear();
+      register_fill_[t][lag] = 0;
+      spike_register_[t][lag].clear();
+      offgrid_spike_register_[t][lag].clear();
     }
+}
 
-    // remove old spikes from the spike_register_
-    for (i = spike_register_.begin(); i != spike_register_.end(); ++i)
-      for (j = i->begin(); j != i->end(); ++j)
-        j->clear();
-  }
-  else  //off_grid_spiking
+size_t nest::Scheduler::get_register_capacity_() const
+{
+  size_t needed = 1;
+  for (index t = 0; t < n_threads_; ++t)
+    for (delay lag = 0; lag < min_delay_; ++lag)
+      needed = std::max(needed, register_fill_[t][lag] + spike_register_[t][lag].size()
+                                + offgrid_spike_register_[t][lag].size() + 1);
+
+  // overflowing segments are enlarged with 50% headroom
+  return needed > register_capacity_ ? needed + needed / 2 : register_capacity_;
+}
+
+template <typename SpikeT>
+void nest::Scheduler::complete_send_buffer_(std::vector<SpikeT>& buffer,
+                                            std::vector<std::vector<std::vector<SpikeT> > >& overflow,
+                                            const SpikeT& marker)
+{
+  const size_t capacity = get_register_capacity_();
+  if (capacity > register_capacity_)
   {
-    // make sure buffers are correctly sized and empty
-    std::vector<OffGridSpike> tmp(global_offgrid_spikes_.size(), OffGridSpike(0,0.0));
-    global_offgrid_spikes_.swap(tmp);
+    std::vector<SpikeT> enlarged(capacity * n_threads_ * min_delay_, marker);
+    for (index t = 0; t < n_threads_; ++t)
+      for (delay lag = 0; lag < min_delay_; ++lag)
+      {
+        typename std::vector<SpikeT>::iterator seg = buffer.begin() + (t * min_delay_ + lag) * register_capacity_;
+        typename std::vector<SpikeT>::iterator pos = enlarged.begin() + (t * min_delay_ + lag) * capacity;
+        pos = std::copy(seg, seg + register_fill_[t][lag], pos);
+        std::copy(overflow[t][lag].begin(), overflow[t][lag].end(), pos);
+        register_fill_[t][lag] += overflow[t][lag].size();
+        overflow[t][lag].clear();
+      }
+    buffer.swap(enlarged);
+    register_capacity_ = capacity;
+  }
 
-    if (global_offgrid_spikes_.size() != static_cast<uint_t>(Communicator::get_recv_buffer_size()))
-      global_offgrid_spikes_.resize(Communicator::get_recv_buffer_size(), OffGridSpike(0,0.0));
+  for (index t = 0; t < n_threads_; ++t)
+    for (delay lag = 0; lag < min_delay_; ++lag)
+      buffer[(t * min_delay_ + lag) * register_capacity_ + register_fill_[t][lag]] = marker;
+}
 
-    std::vector<OffGridSpike> tmp2(local_offgrid_spikes_.size(),  OffGridSpike(0,0.0));
-    local_offgrid_spikes_.swap(tmp2);
+void nest::Scheduler::deliver_events_(thread t)
+{
+  // deliver only at beginning of time slice
+  if ( from_step_ > 0 )
+    return;
 
-    if (num_spikes + (n_threads_ * min_delay_) > static_cast<uint_t>(Communicator::get_send_buffer_size()))
-      local_offgrid_spikes_.resize((num_spikes + (min_delay_ * n_threads_)), OffGridSpike(0,0.0));
-    else if (local_offgrid_spikes_.size() < static_cast<uint_t>(Communicator::get_send_buffer_size()))
-      local_offgrid_spikes_.resize(Communicator::get_send_buffer_size(),  OffGridSpike(0,0.0));
+  // the spikes received at the end of the previous slice, or of the
+  // slice before with overlapping communication, are delivered now;
+  // each thread sorts its share of the global buffers by target thread
+  partition_spikes_(t, clock_ - Time::step((exchange_latency_ - 1) * min_delay_));
+  if (n_threads_ > 1)
+    wait_for_partition_();
+  collect_batch_(t);
 
-    // collocate the entries of spike_registers into local_offgrid_spikes__
-    std::vector<OffGridSpike>::iterator pos = local_offgrid_spikes_.begin();
-    if (num_grid_spikes == 0)
-      for (it = offgrid_spike_register_.begin(); it != offgrid_spike_register_.end(); ++it)
-        for (jt = it->begin(); jt != it->end(); ++jt)
-        {
-          pos = std::copy(jt->begin(), jt->end(), pos);
-          pos->set_gid(comm_marker_);
-          ++pos;
-        }
-    else
+  // tell all local nodes about spikes on remote machines.
+  SpikeEvent se;
+  net_.connection_manager_.send(t, spike_batch_[t], se);
+}
+
+void nest::Scheduler::partition_spikes_(thread t, const Time& clock)
+{
+  for (size_t d = 0; d < spike_lanes_[t].size(); ++d)
+    spike_lanes_[t][d].clear();
+
+  // thread t reads the streams of a contiguous range of processes
+  const int num_processes = Communicator::get_num_processes();
+  if (packed_exchange_)
+  {
+    // see pack_spikes_() for the format
+    const int first = t * num_processes / n_threads_;
+    const int last = (t + 1) * num_processes / n_threads_;
+    for (int pid = first; pid < last; ++pid)
+      if (recv_counts_[pid] > 0)
+        unpack_spikes_(t, &global_packed_spikes_[displacements_[pid]], clock);
+    return;
+  }
+
+  // thread t reads the segments of a contiguous range of virtual
+  // processes; each process sends one segment per thread and lag, whose
+  // size follows from the size of its block
+  const size_t num_vps = Communicator::get_num_virtual_processes();
+  const size_t num_segments = n_threads_ * min_delay_;
+  const size_t size = offgrid_exchange_ ? global_offgrid_spikes_.size() : global_grid_spikes_.size();
+  const size_t first = t * num_vps / n_threads_;
+  const size_t last = (t + 1) * num_vps / n_threads_;
+  for (size_t vp = first; vp < last; ++vp)
+  {
+    const int pid = get_process_id(vp);
+    const size_t end = pid + 1 < num_processes ? displacements_[pid + 1] : size;
+    const size_t capacity = (end - displacements_[pid]) / num_segments;
+    for (delay lag = 0; lag < min_delay_; ++lag)
     {
-      std::vector<uint_t>::iterator n;
-      i = spike_register_.begin();
-      for (it = offgrid_spike_register_.begin(); it != offgrid_spike_register_.end(); ++it)
+      const Time stamp = clock - Time::step(min_delay_ - 1 - lag);
+      for (size_t i = displacements_[pid] + (vp_to_thread(vp) * min_delay_ + lag) * capacity; ; ++i)
       {
-        j = i->begin();
-        for (jt = it->begin(); jt != it->end(); ++jt)
+        index nid;
+        double_t offset = 0.0;
+        if (offgrid_exchange_)
         {
-          pos = std::copy(jt->begin(), jt->end(), pos);
-          for (n = j->begin() ; n != j->end() ; ++n )
-          {
-            *pos = OffGridSpike(*n,0);
-            ++pos;
-          }
-          pos->set_gid(comm_marker_);
-          ++pos;
-          ++j;
+          nid = global_offgrid_spikes_[i].get_gid();
+          offset = global_offgrid_spikes_[i].get_offset();
         }
-        ++i;
+        else
+          nid = global_grid_spikes_[i];
+
+        if (nid == comm_marker_)
+          break;
+        add_to_lanes_(t, BatchedSpike(nid, stamp, offset));
       }
-      for (i = spike_register_.begin(); i != spike_register_.end(); ++i)
-        for (j = i->begin(); j != i->end(); ++j)
-          j->clear();
     }
+  }
+}
+
+void nest::Scheduler::add_to_lanes_(thread t, const BatchedSpike& spike)
+{
+  const ConnectionManager& cm = net_.connection_manager_;
+  const unsigned long* mask = cm.get_target_threads(spike.sgid_);
+  if (mask == 0)
+    return;
 
-    //empty offgrid_spike_register_
-    for (it = offgrid_spike_register_.begin(); it != offgrid_spike_register_.end(); ++it)
-      for (jt = it->begin(); jt != it->end(); ++jt)
-        jt->clear();
+  for (size_t w = 0; w < cm.get_thread_mask_words(); ++w)
+  {
+    thread target = w * ConnectionManager::THREAD_MASK_BITS;
+    for (unsigned long m = mask[w]; m != 0; m >>= 1, ++target)
+      if (m & 1UL)
+        spike_lanes_[t][target].push_back(spike);
   }
 }
 
-void nest::Scheduler::deliver_events_(thread t)
+void nest::Scheduler::collect_batch_(thread t)
 {
-  // deliver only at beginning of time slice
-  if ( from_step_ > 0 )
+  std::vector<BatchedSpike>& batch = spike_batch_[t];
+  if (n_threads_ == 1)
+  {
+    batch.swap(spike_lanes_[0][0]);
     return;
+  }
 
-  size_t n_markers = 0;
-  SpikeEvent se;
+  // the lanes of lower threads hold earlier parts of the global buffers
+  batch.clear();
+  for (index s = 0; s < n_threads_; ++s)
+    batch.insert(batch.end(), spike_lanes_[s][t].begin(), spike_lanes_[s][t].end());
+}
 
-  std::vector<int> pos(displacements_);
+void nest::Scheduler::wait_for_partition_()
+{
+#ifdef HAVE_PTHREADS
+  ready_mutex_.lock();
+  const index generation = partition_generation_;
+  if (++partition_counter_ == n_threads_)
+  {
+    partition_counter_ = 0;
+    ++partition_generation_;
+    pthread_cond_broadcast(&partitioned_);
+  }
+  else
+    while (generation == partition_generation_)
+      pthread_cond_wait(&partitioned_, &ready_mutex_);
+  ready_mutex_.unlock();
+#else
+#pragma omp barrier
+#endif
+}
 
-  if (!off_grid_spiking_) //on_grid_spiking
+void nest::Scheduler::pack_value_(std::vector<unsigned char>& buffer, index v)
+{
+  while (v >= 0x80)
   {
-    for (size_t vp = 0; vp < (size_t)Communicator::get_num_virtual_processes(); ++vp)
+    buffer.push_back(static_cast<unsigned char>(v | 0x80));
+    v >>= 7;
+  }
+  buffer.push_back(static_cast<unsigned char>(v));
+}
+
+void nest::Scheduler::pack_spike_(std::vector<unsigned char>& buffer, index delta, double_t offset)
+{
+  // entries are shifted by one, so that they never equal comm_marker_
+  const index entry = delta << 2;
+  const float f = static_cast<float>(offset);
+  if (offset == 0.0)
+    pack_value_(buffer, entry + 1);
+  else if (static_cast<double_t>(f) == offset)
+  {
+    pack_value_(buffer, (entry | 1) + 1);
+    const unsigned char* b = reinterpret_cast<const unsigned char*>(&f);
+    buffer.insert(buffer.end(), b, b + sizeof(float));
+  }
+  else
+  {
+    pack_value_(buffer, (entry | 2) + 1);
+    const unsigned char* b = reinterpret_cast<const unsigned char*>(&offset);
+    buffer.insert(buffer.end(), b, b + sizeof(double_t));
+  }
+}
+
+const unsigned char* nest::Scheduler::unpack_spikes_(thread t, const unsigned char* pos, const Time& clock)
+{
+  for (int lag = min_delay_ - 1; lag >= 0; --lag)
+  {
+    const Time stamp = clock - Time::step(lag);
+    index nid = 0;
+    while (true)
     {
-      size_t pid = get_process_id(vp);
-      int lag = min_delay_ - 1;
-      while(n_markers < min_delay_)
+      index v = 0;
+      for (int shift = 0; ; shift += 7)
       {
-        index nid = global_grid_spikes_[pos[pid]];
-        if (nid != comm_marker_)
-        {
-          // tell all local nodes about spikes on remote machines.
-          se.set_stamp(clock_ - Time::step(lag));
-          se.set_sender_gid(nid);
-          net_.connection_manager_.send(t, nid, se);
-        }
-        else
-        {
-          ++n_markers;
-          --lag;
-        }
-        ++pos[pid];
+        v |= static_cast<index>(*pos & 0x7f) << shift;
+        if (!(*pos++ & 0x80))
+          break;
       }
-      n_markers = 0;
+      if (v == comm_marker_)
+        break;
+
+      --v;
+      nid += v >> 2;
+      double_t offset = 0.0;
+      if ((v & 3) == 1)
+      {
+        float f;
+        std::memcpy(&f, pos, sizeof(float));
+        pos += sizeof(float);
+        offset = f;
+      }
+      else if ((v & 3) == 2)
+      {
+        std::memcpy(&offset, pos, sizeof(double_t));
+        pos += sizeof(double_t);
+      }
+      add_to_lanes_(t, BatchedSpike(nid, stamp, offset));
     }
   }
-  else //off grid spiking
+  return pos;
+}
+
+void nest::Scheduler::collect_lag_spikes_(delay lag)
+{
+  lag_spikes_.clear();
+  for (index t = 0; t < n_threads_; ++t)
+  {
+    const size_t begin = (t * min_delay_ + lag) * register_capacity_;
+    const size_t end = begin + register_fill_[t][lag];
+    if (offgrid_registers_)
+    {
+      for (size_t i = begin; i < end; ++i)
+        lag_spikes_.push_back(std::make_pair(local_offgrid_spikes_[i].get_gid(),
+                                             off_grid_spiking_ ? local_offgrid_spikes_[i].get_offset() : 0.0));
+      const std::vector<OffGridSpike>& offgrid = offgrid_spike_register_[t][lag];
+      for (std::vector<OffGridSpike>::const_iterator n = offgrid.begin(); n != offgrid.end(); ++n)
+        lag_spikes_.push_back(std::make_pair(n->get_gid(), off_grid_spiking_ ? n->get_offset() : 0.0));
+    }
+    else
+    {
+      for (size_t i = begin; i < end; ++i)
+        lag_spikes_.push_back(std::make_pair(local_grid_spikes_[i], 0.0));
+      const std::vector<uint_t>& grid = spike_register_[t][lag];
+      for (std::vector<uint_t>::const_iterator n = grid.begin(); n != grid.end(); ++n)
+        lag_spikes_.push_back(std::make_pair(*n, 0.0));
+    }
+  }
+
+  std::sort(lag_spikes_.begin(), lag_spikes_.end());
+}
+
+void nest::Scheduler::pack_spikes_()
+{
+  // the header is filled in by the Communicator
+  local_packed_spikes_.resize(Communicator::PACKED_HEADER_SIZE);
+
+  for (delay lag = 0; lag < min_delay_; ++lag)
+  {
+    collect_lag_spikes_(lag);
+
+    uint_t last = 0;
+    for (std::vector<std::pair<uint_t, double_t> >::const_iterator n = lag_spikes_.begin();
+         n != lag_spikes_.end(); ++n)
+    {
+      pack_spike_(local_packed_spikes_, n->first - last, n->second);
+      last = n->first;
+    }
+    pack_value_(local_packed_spikes_, comm_marker_);
+  }
+}
+
+void nest::Scheduler::pack_sparse_spikes_()
+{
+  const size_t num_processes = Communicator::get_num_processes();
+  rank_spikes_.resize(num_processes);
+  for (size_t pid = 0; pid < num_processes; ++pid)
+    rank_spikes_[pid].clear();
+
+  std::vector<uint_t> last(num_processes);
+  for (delay lag = 0; lag < min_delay_; ++lag)
   {
-    for (size_t vp = 0; vp < (size_t)Communicator::get_num_virtual_processes(); ++vp)
+    collect_lag_spikes_(lag);
+
+    std::fill(last.begin(), last.end(), 0);
+    // both lag_spikes_ and the sources are sorted by gid
+    const std::vector<uint_t>& sources = target_rank_sources_;
+    std::vector<uint_t>::const_iterator src = sources.begin();
+    for (std::vector<std::pair<uint_t, double_t> >::const_iterator n = lag_spikes_.begin();
+         n != lag_spikes_.end(); ++n)
     {
-      size_t pid = get_process_id(vp);
-      int lag = min_delay_ - 1;
-      while(n_markers < min_delay_)
+      src = std::lower_bound(src, sources.end(), n->first);
+      if (src == sources.end())
+        break;
+      if (*src != n->first)
+        continue;
+
+      const size_t i = src - sources.begin();
+      for (size_t r = target_rank_offsets_[i]; r < target_rank_offsets_[i + 1]; ++r)
       {
-        index nid = global_offgrid_spikes_[pos[pid]].get_gid();
-        if (nid != comm_marker_)
-        {
-          // tell all local nodes about spikes on remote machines.
-          se.set_stamp(clock_ - Time::step(lag));
-          se.set_sender_gid(nid);
-          se.set_offset(global_offgrid_spikes_[pos[pid]].get_offset());
-          net_.connection_manager_.send(t, nid, se);
-        }
-        else
-        {
-          ++n_markers;
-          --lag;
-        }
-        ++pos[pid];
+        const uint_t pid = target_ranks_[r];
+        pack_spike_(rank_spikes_[pid], n->first - last[pid], n->second);
+        last[pid] = n->first;
       }
-      n_markers = 0;
     }
+
+    for (size_t pid = 0; pid < num_processes; ++pid)
+      pack_value_(rank_spikes_[pid], comm_marker_);
+  }
+
+  // processes that receive no spikes at all are left out of the exchange
+  local_packed_spikes_.clear();
+  for (size_t pid = 0; pid < num_processes; ++pid)
+  {
+    if (rank_spikes_[pid].size() > min_delay_)
+    {
+      send_counts_[pid] = rank_spikes_[pid].size();
+      local_packed_spikes_.insert(local_packed_spikes_.end(), rank_spikes_[pid].begin(), rank_spikes_[pid].end());
+    }
+    else
+      send_counts_[pid] = 0;
   }
 }
 
+void nest::Scheduler::update_target_ranks_()
+{
+  const int num_processes = Communicator::get_num_processes();
+  if (!Communicator::get_use_Alltoallv() || num_processes == 1)
+    return;
+
+  // all processes must rebuild the table if connections or nodes were
+  // added on any of them
+  const ConnectionManager& cm = net_.connection_manager_;
+  const bool changed = cm.get_num_source_threads() != target_ranks_num_source_threads_
+                       || net_.size() != target_ranks_network_size_;
+  std::vector<int_t> any_changed(num_processes, 0);
+  any_changed[Communicator::get_rank()] = changed;
+  Communicator::communicate(any_changed);
+  if (std::find(any_changed.begin(), any_changed.end(), 1) == any_changed.end())
+    return;
+
+  target_ranks_num_source_threads_ = cm.get_num_source_threads();
+  target_ranks_network_size_ = net_.size();
+
+  // tell the process of each source that it has targets here, assuming
+  // that the source lives on its default virtual process
+  std::vector<uint_t> sources;
+  cm.get_sources_with_targets(sources);
+  std::vector<std::vector<uint_t> > sources_by_rank(num_processes);
+  for (std::vector<uint_t>::const_iterator s = sources.begin(); s != sources.end(); ++s)
+    sources_by_rank[get_process_id(suggest_vp(*s))].push_back(*s);
+
+  std::vector<uint_t> send_buffer;
+  std::vector<int> send_counts(num_processes);
+  for (int pid = 0; pid < num_processes; ++pid)
+  {
+    send_counts[pid] = sources_by_rank[pid].size();
+    send_buffer.insert(send_buffer.end(), sources_by_rank[pid].begin(), sources_by_rank[pid].end());
+  }
+
+  std::vector<uint_t> recv_buffer;
+  std::vector<int> displacements(num_processes);
+  std::vector<int> recv_counts(num_processes);
+  Communicator::communicate_Alltoallv(send_buffer, send_counts, recv_buffer, displacements, recv_counts);
+
+  std::vector<std::pair<uint_t, uint_t> > source_ranks;
+  for (int pid = 0; pid < num_processes; ++pid)
+    for (int k = displacements[pid]; k < displacements[pid] + recv_counts[pid]; ++k)
+      if (net_.is_local_gid(recv_buffer[k]))
+        source_ranks.push_back(std::make_pair(recv_buffer[k], pid));
+
+  // nodes in subnets with children_on_same_vp do not live on their
+  // default virtual process, so their spikes go to all processes
+  for (index gid = 1; gid < net_.size(); ++gid)
+  {
+    if (!net_.is_local_gid(gid) || net_.nodes_[gid] == 0
+        || (*net_.nodes_[gid]).num_thread_siblings_() > 0)
+      continue;
+    const Node* node = net_.nodes_[gid];
+    if (node->has_proxies() && node->get_vp() != suggest_vp(gid))
+      for (int pid = 0; pid < num_processes; ++pid)
+        source_ranks.push_back(std::make_pair(gid, pid));
+  }
+
+  std::sort(source_ranks.begin(), source_ranks.end());
+  source_ranks.erase(std::unique(source_ranks.begin(), source_ranks.end()), source_ranks.end());
+
+  target_rank_sources_.clear();
+  target_rank_offsets_.clear();
+  target_ranks_.clear();
+  for (size_t k = 0; k < source_ranks.size(); ++k)
+  {
+    if (k == 0 || source_ranks[k].first != source_ranks[k - 1].first)
+    {
+      target_rank_sources_.push_back(source_ranks[k].first);
+      target_rank_offsets_.push_back(k);
+    }
+    target_ranks_.push_back(source_ranks[k].second);
+  }
+  target_rank_offsets_.push_back(target_ranks_.size());
+}
+
 void nest::Scheduler::gather_events_()
 {
-  collocate_buffers_();
-  if (off_grid_spiking_)
-    Communicator::communicate(local_offgrid_spikes_, global_offgrid_spikes_, displacements_);
+  if (exchange_latency_ == 2)
+  {
+    gather_events_overlapping_();
+    return;
+  }
+
+  if (Communicator::get_use_Alltoallv() && Communicator::get_num_processes() > 1)
+  {
+    pack_sparse_spikes_();
+    clear_spike_registers_(get_register_capacity_());
+    Communicator::communicate_Alltoallv(local_packed_spikes_, send_counts_, global_packed_spikes_,
+                                        displacements_, recv_counts_);
+    packed_exchange_ = true;
+  }
+  else if (compress_spikes_ || overlap_communication_ || Communicator::get_use_Alltoallv())
+  {
+    pack_spikes_();
+    clear_spike_registers_(get_register_capacity_());
+    Communicator::communicate_packed(local_packed_spikes_, global_packed_spikes_, displacements_, recv_counts_);
+    packed_exchange_ = true;
+  }
+  else
+  {
+    // the registers are sent as they are, only the markers are missing
+    if (offgrid_registers_)
+    {
+      complete_send_buffer_(local_offgrid_spikes_, offgrid_spike_register_, OffGridSpike(comm_marker_, 0.0));
+      global_offgrid_spikes_.resize(Communicator::get_recv_buffer_size(), OffGridSpike(comm_marker_, 0.0));
+      Communicator::communicate(local_offgrid_spikes_, global_offgrid_spikes_, displacements_);
+    }
+    else
+    {
+      complete_send_buffer_(local_grid_spikes_, spike_register_, comm_marker_);
+      global_grid_spikes_.resize(Communicator::get_recv_buffer_size(), comm_marker_);
+      Communicator::communicate(local_grid_spikes_, global_grid_spikes_, displacements_);
+    }
+    packed_exchange_ = false;
+    offgrid_exchange_ = offgrid_registers_;
+
+    // the segments grow with the blocks of the largest process
+    clear_spike_registers_(Communicator::get_send_buffer_size() / (n_threads_ * min_delay_));
+  }
+}
+
+void nest::Scheduler::gather_events_overlapping_()
+{
+  // the spikes of the previous slice have arrived while the current
+  // slice was updated, they are delivered at the beginning of the next
+  // slice
+  finish_exchange_();
+  packed_exchange_ = true;
+
+  // non-blocking collectives cannot depend on each other, so the packed
+  // blocks are exchanged even if the sparse exchange was requested
+  pack_spikes_();
+  clear_spike_registers_(get_register_capacity_());
+  Communicator::start_packed(local_packed_spikes_, pending_packed_spikes_);
+  exchange_in_flight_ = true;
+}
+
+void nest::Scheduler::finish_exchange_()
+{
+  if (exchange_in_flight_)
+  {
+    Communicator::finish_packed(local_packed_spikes_, pending_packed_spikes_,
+                                displacements_, recv_counts_);
+    global_packed_spikes_.swap(pending_packed_spikes_);
+    exchange_in_flight_ = false;
+  }
   else
-    Communicator::communicate(local_grid_spikes_, global_grid_spikes_, displacements_);
+    std::fill(recv_counts_.begin(), recv_counts_.end(), 0);
 }
 
 void nest::Scheduler::advance_time_()
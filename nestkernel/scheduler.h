@@ -127,7 +127,7 @@ namespace nest
      * Add global id of event sender to the spike_register. 
      * An event sent through this method will remain in the queue until
      * the network time has advanced by min_delay_ steps. After this period
-     * the buffers are collocated and sent to the partner machines.
+     * the buffers are sent to the partner machines.
 
      * Old documentation from network.h:
      * Place an event in the global event queue.
@@ -147,7 +147,7 @@ namespace nest
      * Store event offset with global id.
      * An event sent through this method will remain in the queue until
      * the network time has advanced by min_delay_ steps. After this period
-     * the buffers are collocated and sent to the partner machines.
+     * the buffers are sent to the partner machines.
 
      * Old documentation from network.h:
      * Place an event in the global event queue.
@@ -301,6 +301,14 @@ namespace nest
     static
     delay get_slice_modulo(delay d);
 
+    /**
+     * Return scratch memory of thread t for sorting the spikes of a slice
+     * by time step. It holds 2*min_delay+1 elements.
+     * @see SliceRingBuffer
+     */
+    static
+    vector<size_t>& get_sort_buffer(thread t);
+
     /**
      * Return minimal connection delay.
      */
@@ -313,6 +321,14 @@ namespace nest
     static
     delay get_max_delay();
 
+    /**
+     * Return the number of slices from the slice in which a spike is
+     * emitted to the slice at whose beginning it is delivered. This is
+     * 1, or 2 if the spike exchange overlaps with the update, in which
+     * case the slices are half as long as the minimal delay.
+     */
+    delay get_exchange_latency() const;
+
     /**
      * Get slice number. Increased by one for each slice. Can be used
      * to choose alternating buffers.
@@ -337,6 +353,14 @@ namespace nest
     void finalize_();
     
     void update_(Node*);
+
+    /**
+     * Update all nodes of thread t. If population_update_ is set, each
+     * run of nodes of the same model in nodes_vec_[t] is updated by
+     * Model::update_population().
+     */
+    void update_nodes_(thread t);
+
     void advance_time_();
 
     void print_progress_();
@@ -387,10 +411,14 @@ namespace nest
 #ifdef HAVE_PTHREADS
     pthread_cond_t   ready_;
     pthread_cond_t   done_;
+    pthread_cond_t   partitioned_;          //!< Signals the end of partition_spikes_().
+    index            partition_counter_;    //!< Threads done with partition_spikes_().
+    index            partition_generation_; //!< Number of completed partitions.
 #endif
 
     vector<Thread>   threads_;
     vector<vector<Node*> > nodes_vec_;   //!< Nodelists for unfrozen nodes
+    vector<vector<double_t> > population_buffers_; //!< Scratch memory of each thread for population updates
     
     Network  &net_;         //!< Reference to network object.
     Time     clock_;        //!< Network clock, updated once per slice
@@ -409,7 +437,14 @@ namespace nest
     bool is_prepared_;      //!< true if prepare_simulation was executed
     bool simulated_;        //!< indicates whether the network has already been simulated for some time
     bool off_grid_spiking_; //!< indicates whether spikes are not constrained to the grid 
+    bool compress_spikes_;  //!< indicates whether spikes are exchanged in the packed format
+    bool packed_exchange_;  //!< indicates whether the global spike buffer holds packed spikes
+    bool offgrid_exchange_; //!< indicates whether global_offgrid_spikes_ holds the spikes
+    bool overlap_communication_; //!< indicates whether the spike exchange should overlap with the update
+    bool exchange_in_flight_; //!< indicates whether pending_packed_spikes_ is being received
+    delay exchange_latency_; //!< see get_exchange_latency()
     bool print_time_;       //!< Indicates whether time should be printed during simulations (or not)
+    bool population_update_; //!< indicates whether runs of nodes of the same model are updated at once
 
     std::vector<long_t> rng_seeds_;  //!< The seeds of the local RNGs. These do not neccessarily describe the state of the RNGs.
     long_t grng_seed_;   //!< The seed of the global RNG, not neccessarily describing the state of the GRNG.
@@ -444,6 +479,9 @@ namespace nest
     static 
     vector<delay> slice_moduli_;
 
+    static
+    vector<vector<size_t> > sort_buffers_; //!< Scratch memory of each thread for sorting spikes by step
+
     /**
      * Vector of random number generators for threads.
      * There must be PRECISELY one rng per thread.
@@ -455,9 +493,22 @@ namespace nest
      */
     librandom::RngPtr grng_;
 
+    /**
+     * Spike registers. Each thread writes the gids of its spikes
+     * directly into its own segments of local_grid_spikes_, or of
+     * local_offgrid_spikes_ if offgrid_registers_ is set. There is one
+     * segment of register_capacity_ entries per thread and lag, segment
+     * (t, lag) starting at entry (t * min_delay_ + lag) * register_capacity_.
+     * The last entry of each segment is reserved for comm_marker_.
+     * register_fill_[t][lag] is the number of spikes in segment (t, lag).
+     */
+    std::vector<std::vector<size_t> > register_fill_;
+    size_t register_capacity_;
+    bool offgrid_registers_;
+
     /** 
-     * Register for gids of neurons that spiked. This is a 3-dim
-     * structure.
+     * Overflow register for gids of neurons that spiked, if their
+     * segment of the send buffer is full. This is a 3-dim structure.
      * - First dim: Each thread has its own vector to write to.
      * - Second dim: A vector for each slice of the min_delay interval
      * - Third dim: The gids.
@@ -465,7 +516,7 @@ namespace nest
     std::vector<std::vector<std::vector<uint_t> > > spike_register_;
 
     /** 
-     * Register for off-grid spikes.
+     * Overflow register for off-grid spikes.
      * This is a 3-dim structure.
      * - First dim: Each thread has its own vector to write to.
      * - Second dim: A vector for each slice of the min_delay interval
@@ -474,10 +525,28 @@ namespace nest
     std::vector<std::vector<std::vector<OffGridSpike> > > 
       offgrid_spike_register_;
 
+    /**
+     * Spikes read from the global spike buffers, to be delivered
+     * to the local targets in one batch per thread.
+     * - First dim: Each thread has its own batch.
+     * - Second dim: The spikes with targets on the thread, in the
+     *   order of the global buffer.
+     */
+    std::vector<std::vector<BatchedSpike> > spike_batch_;
+
+    /**
+     * Spikes read from the global spike buffers by each thread, sorted
+     * by the threads on which their senders have targets.
+     * - First dim: The thread that read the spikes.
+     * - Second dim: The thread to deliver the spikes to.
+     * - Third dim: The spikes, in the order of the global buffer.
+     */
+    std::vector<std::vector<std::vector<BatchedSpike> > > spike_lanes_;
+
     /**
      * Buffer containing the gids of local neurons that spiked in the 
-     * last min_delay_ interval. The single slices are separated by a
-     * marker value. 
+     * last min_delay_ interval, in one segment per thread and slice,
+     * each terminated by a marker value, see register_fill_.
      */
     std::vector<uint_t> local_grid_spikes_;
 
@@ -490,8 +559,8 @@ namespace nest
 
     /**
      * Buffer containing the gids and offsets for local neurons that
-     * fired off-grid spikes in the last min_delay_ interval. The 
-     * single slices are separated by a marker value. 
+     * fired off-grid spikes in the last min_delay_ interval, laid out
+     * as local_grid_spikes_.
      */
      std::vector<OffGridSpike> local_offgrid_spikes_;
 
@@ -507,6 +576,59 @@ namespace nest
      * each process within the global_(off)grid_spikes_ buffer.
      */
      std::vector<int> displacements_;
+
+    /**
+     * Buffer containing the packed spikes of local neurons in the last
+     * min_delay_ interval, see pack_spikes_().
+     */
+    std::vector<unsigned char> local_packed_spikes_;
+
+    /**
+     * Buffer containing the packed spikes of all neurons in the last
+     * min_delay_ interval.
+     */
+    std::vector<unsigned char> global_packed_spikes_;
+
+    /**
+     * Buffer receiving the packed spikes of all neurons while the next
+     * slice is updated, if the spike exchange overlaps with the update.
+     */
+    std::vector<unsigned char> pending_packed_spikes_;
+
+    /**
+     * Scratch buffer for the gids and offsets of the spikes of one lag,
+     * used by pack_spikes_().
+     */
+    std::vector<std::pair<uint_t, double_t> > lag_spikes_;
+
+    /**
+     * Scratch buffers for the packed spikes for each process, used by
+     * pack_sparse_spikes_().
+     */
+    std::vector<std::vector<unsigned char> > rank_spikes_;
+
+    /**
+     * Number of elements sent to and received from each process in
+     * the packed and sparse spike exchange.
+     */
+    std::vector<int> send_counts_;
+    std::vector<int> recv_counts_;
+
+    /**
+     * Target rank table for the sparse spike exchange: the processes
+     * holding targets of the local source target_rank_sources_[i] are
+     * target_ranks_[target_rank_offsets_[i]] up to, but not including,
+     * target_ranks_[target_rank_offsets_[i+1]]. The sources are sorted.
+     */
+    std::vector<uint_t> target_rank_sources_;
+    std::vector<size_t> target_rank_offsets_;
+    std::vector<uint_t> target_ranks_;
+
+    //! Values of ConnectionManager::get_num_source_threads() and the
+    //! network size when the target rank table was built.
+    size_t target_ranks_num_source_threads_;
+    size_t target_ranks_network_size_;
+
           
 
     /**
@@ -533,11 +655,103 @@ namespace nest
     void clear_nodes_vec_();
 
     /**
-     * Rearrange the spike_register into a 2-dim structure. This is
-     * done by collecting the spikes from all threads in each slice of
-     * the min_delay_ interval.
+     * Store a spike in the register of thread t for the given lag.
+     */
+    void register_spike_(thread t, long_t lag, uint_t gid, double_t offset);
+
+    /**
+     * Lay out the spike registers for the next slice with segments of
+     * the given capacity and clear them.
+     */
+    void clear_spike_registers_(size_t capacity);
+
+    /**
+     * Return the segment capacity needed to store the spikes in the
+     * registers without overflow, with some headroom, or the current
+     * capacity, if it is large enough.
      */
-    void collocate_buffers_();
+    size_t get_register_capacity_() const;
+
+    /**
+     * Terminate the segments of the spike registers in buffer with
+     * marker, so that buffer can be sent to the other processes. If
+     * spikes went to the overflow registers, buffer is first laid out
+     * again with larger segments.
+     */
+    template <typename SpikeT>
+    void complete_send_buffer_(std::vector<SpikeT>& buffer,
+                               std::vector<std::vector<std::vector<SpikeT> > >& overflow,
+                               const SpikeT& marker);
+
+    /**
+     * Pack the spike registers into local_packed_spikes_ and clear them.
+     *
+     * For each lag, the spikes of all threads are sorted by gid and
+     * stored as differences to the previous gid, using a variable number
+     * of bytes. The two lowest bits of each entry tell whether the spike
+     * has no offset, an offset that is exactly representable as float,
+     * or a double offset, which then follows the entry. A zero byte
+     * (comm_marker_) terminates each lag. Offsets are only transmitted if
+     * off_grid_spiking_ is set.
+     */
+    void pack_spikes_();
+
+    /**
+     * Pack the spike registers into one stream per process, in the
+     * format of pack_spikes_(), and clear them. Each spike is only
+     * packed into the streams of the processes in its entry in the
+     * target rank table. The streams are stored one after the other in
+     * local_packed_spikes_, streams without spikes are left out.
+     */
+    void pack_sparse_spikes_();
+
+    /**
+     * Move the spikes of the given lag from the spike registers of all
+     * threads to lag_spikes_ and sort them by gid.
+     */
+    void collect_lag_spikes_(delay lag);
+
+    /**
+     * Append the spike with the given gid difference and offset to buffer.
+     */
+    void pack_spike_(std::vector<unsigned char>& buffer, index delta, double_t offset);
+
+    /**
+     * Append v to buffer, seven bits per byte, with the highest bit set
+     * on all but the last byte.
+     */
+    void pack_value_(std::vector<unsigned char>& buffer, index v);
+
+    /**
+     * Add the spikes of one packed stream starting at pos to the lanes
+     * of thread t and return the end of the stream.
+     */
+    const unsigned char* unpack_spikes_(thread t, const unsigned char* pos, const Time& clock);
+
+    /**
+     * Rebuild the target rank table for the sparse spike exchange if
+     * connections or nodes were added on any process since it was last
+     * built. Each process sends the gids of the sources with targets on
+     * it to the processes of these sources.
+     */
+    void update_target_ranks_();
+
+    /**
+     * Append the spike read by thread t to the lanes of all threads on
+     * which its sender has targets.
+     */
+    void add_to_lanes_(thread t, const BatchedSpike& spike);
+
+    /**
+     * Wait until all threads have finished partition_spikes_().
+     */
+    void wait_for_partition_();
+
+    /**
+     * Collect the spikes for thread t from the lanes of all threads
+     * in its batch.
+     */
+    void collect_batch_(thread t);
 
     /**
      * Collocate buffers and exchange events with other MPI processes.
@@ -545,8 +759,33 @@ namespace nest
     void gather_events_();
 
     /**
-     * Read all event buffers for thread t and send the corresponding
-     * Events to the Nodes that are targeted.
+     * Exchange events with other MPI processes while the next slice is
+     * updated. At the end of each slice, the exchange started at the end
+     * of the previous slice is completed, its spikes are delivered at
+     * the beginning of the next slice, and the exchange of the spikes of
+     * the current slice is started.
+     */
+    void gather_events_overlapping_();
+
+    /**
+     * Complete the overlapping exchange still in flight, if any, and
+     * store the spikes received in global_packed_spikes_.
+     */
+    void finish_exchange_();
+
+    /**
+     * Read the share of thread t of the global spike buffers and sort
+     * its spikes into the lanes of the threads on which their senders
+     * have targets. Each thread calls this for itself in deliver_events_(),
+     * so that the buffers are read once in total. The time stamps are
+     * relative to the given clock, which is the start of the slice in
+     * which the spikes are delivered.
+     */
+    void partition_spikes_(thread t, const Time& clock);
+
+    /**
+     * Send the spikes in the batch of thread t to the Nodes that are
+     * targeted.
      *
      * @note It is a crucial property of deliver_events_() that events
      * are delivered ordered by non-decreasing time stamps. BUT: this 
@@ -710,21 +949,41 @@ namespace nest
     nodes_vec_[n->get_thread()].push_back(n);
   }
 
+  inline
+  void Scheduler::register_spike_(thread t, long_t lag, uint_t gid, double_t offset)
+  {
+    size_t& fill = register_fill_[t][lag];
+    if (fill + 1 < register_capacity_)
+    {
+      const size_t pos = (t * min_delay_ + lag) * register_capacity_ + fill;
+      if (offgrid_registers_)
+        local_offgrid_spikes_[pos] = OffGridSpike(gid, offset);
+      else
+        local_grid_spikes_[pos] = gid;
+      ++fill;
+    }
+    else if (offgrid_registers_)
+      offgrid_spike_register_[t][lag].push_back(OffGridSpike(gid, offset));
+    else
+      spike_register_[t][lag].push_back(gid);
+  }
+
   inline
   void Scheduler::send_remote(thread t, SpikeEvent& e, const long_t lag)
   {
     // Put the spike in a buffer for the remote machines
+    const uint_t gid = e.get_sender().get_gid();
     for (int_t i = 0; i < e.get_multiplicity(); ++i)
-      spike_register_[t][lag].push_back(e.get_sender().get_gid());
+      register_spike_(t, lag, gid, 0.0);
   }
 
   inline
   void Scheduler::send_offgrid_remote(thread t, SpikeEvent& e, const long_t lag)
   {
     // Put the spike in a buffer for the remote machines
-    OffGridSpike ogs(e.get_sender().get_gid(), e.get_offset());
+    const uint_t gid = e.get_sender().get_gid();
     for (int_t i = 0; i < e.get_multiplicity(); ++i)
-      offgrid_spike_register_[t][lag].push_back(ogs);
+      register_spike_(t, lag, gid, e.get_offset());
   }
 
   inline
@@ -747,6 +1006,13 @@ namespace nest
     return slice_moduli_[d];
   }
 
+  inline
+  vector<size_t>& Scheduler::get_sort_buffer(thread t)
+  {
+    assert(static_cast<size_t>(t) < sort_buffers_.size());
+    return sort_buffers_[t];
+  }
+
   inline
   delay Scheduler::get_min_delay()
   {
@@ -759,6 +1025,12 @@ namespace nest
     return max_delay_;
   }
 
+  inline
+  delay Scheduler::get_exchange_latency() const
+  {
+    return exchange_latency_;
+  }
+
   inline
   size_t Scheduler::get_slice() const
   {
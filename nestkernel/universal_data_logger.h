@@ -47,6 +47,13 @@ namespace nest {
    * DataLoggingRequests should then be forwarded to the logger using
    * handle().
    *
+   * Data is buffered by column, one contiguous array per recordable and
+   * time slice. If the multimeter requests a reduction, the logger keeps
+   * only one record per reduction window: the last sample (decimation),
+   * or the minimum, maximum or mean of all samples taken in the window.
+   * Windows end at multiples of the window length and may extend over
+   * several time slices.
+   *
    * @note A reference to the host node is stored in the logger, for
    *       access to the state and sending events. This requires a constructor
    *       and a copy constructor for the HostNode::Buffers_, creating new
@@ -131,6 +138,9 @@ namespace nest {
       */
      void record_data(long_t);
 
+     //! Return true if any recording device is connected to the node
+     bool has_loggers() const { return !data_loggers_.empty(); }
+
      //! Erase all existing data
      void reset();
 
@@ -166,20 +176,27 @@ namespace nest {
        long_t rec_int_steps_;      //!< interval in steps
        long_t next_rec_step_;      //!< next time step at which to record
 
+       DataLoggingRequest::Reduction reduction_; //!< reduction of samples per window
+       Time   reduction_window_;   //!< length of reduction window
+       long_t win_steps_;          //!< reduction window in steps
+
+       /**
+        * Running reduction of the samples in the current window, one
+        * entry per recorded variable. Windows may span several slices.
+        */
+       std::vector<double_t> acc_;
+       long_t n_acc_;              //!< number of samples in current window
+
        /** Vector of pointers to member functions for data access. */
        std::vector<typename RecordablesMap<HostNode>::DataAccessFct> node_access_;
 
        /**
         * Buffer for data.
-        * The first dimension has size two, to provide for alternate
-        * writing/reading using a toggle. The second dimension has
-        * one entry per recording time in each time slice. Each entry
-        * consists of a time stamp and one data point per recordable.
+        * The buffer has two entries, to provide for alternate
+        * writing/reading using a toggle. Each entry holds the records
+        * of one time slice, one column per recordable.
         */
        std::vector<DataLoggingReply::Container> data_;
-
-       //! Next buffer entry to write to, with read/write toggle
-       std::vector<size_t> next_rec_;
      };
 
      HostNode& host_;            //!< node to which logger belongs
@@ -234,9 +251,13 @@ namespace nest {
       recording_interval_(Time::neg_inf()),
       rec_int_steps_(0),
       next_rec_step_(-1),  // flag as uninitialized
+      reduction_(req.get_reduction()),
+      reduction_window_(req.get_reduction_window()),
+      win_steps_(0),
+      acc_(),
+      n_acc_(0),
       node_access_(),
-      data_(),
-      next_rec_(2,0)
+      data_()
    {
      const std::vector<Name>& recvars = req.record_from();
      for ( size_t j = 0 ; j < recvars.size() ; ++j )
@@ -264,6 +285,12 @@ namespace nest {
 			       "recording interval must be >= resolution.");
 
      recording_interval_ = req.get_recording_interval();
+
+     if ( num_vars_ > 0 && reduction_ != DataLoggingRequest::NO_REDUCTION
+	  && ( reduction_window_ < recording_interval_
+	       || reduction_window_.get_steps() % recording_interval_.get_steps() != 0 ) )
+       throw IllegalConnection("UniversalDataLogger::connect_logging_device(): "
+			       "reduction window must be a multiple of the recording interval.");
    }
    
 }
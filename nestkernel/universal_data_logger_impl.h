@@ -20,6 +20,8 @@
  *
  */
 
+#include <algorithm>
+
 #include "universal_data_logger.h"
 #include "nest_time.h"
 #include "network.h"
@@ -66,6 +68,7 @@ template <typename HostNode>
 void nest::UniversalDataLogger<HostNode>::DataLogger_::reset()
 {
   data_.clear();
+  n_acc_ = 0;
   next_rec_step_ = -1;  // flag as uninitialized
 }
    
@@ -85,8 +88,22 @@ void nest::UniversalDataLogger<HostNode>::DataLogger_::init()
   // (re-)initialize.
   data_.clear();
 
-  // store recording time in steps
-  rec_int_steps_ = recording_interval_.get_steps();
+  // store recording time in steps; decimation is the same as sampling
+  // at the end of each window only
+  if ( reduction_ == DataLoggingRequest::DECIMATE )
+    rec_int_steps_ = reduction_window_.get_steps();
+  else
+    rec_int_steps_ = recording_interval_.get_steps();
+
+  // length of the intervals at which records are stored
+  if ( reduction_ == DataLoggingRequest::NO_REDUCTION
+       || reduction_ == DataLoggingRequest::DECIMATE )
+    win_steps_ = rec_int_steps_;
+  else
+    win_steps_ = reduction_window_.get_steps();
+
+  acc_.assign(num_vars_, 0.0);
+  n_acc_ = 0;
   
   // set next recording step to first multiple of rec_int_steps_
   // beyond current time, shifted one to left, since rec_step marks
@@ -95,19 +112,14 @@ void nest::UniversalDataLogger<HostNode>::DataLogger_::init()
   next_rec_step_ = 
     ( Node::network()->get_time().get_steps() / rec_int_steps_ + 1 ) * rec_int_steps_ - 1;
 
-  // number of data points per slice
+  // number of records per slice
   const long_t recs_per_slice = 
     static_cast<long_t>(std::ceil(Node::network()->get_min_delay() 
-				    / static_cast<double>(rec_int_steps_)));
-
-  data_.resize(2, 
-	       DataLoggingReply::Container(recs_per_slice,
-					   DataLoggingReply::Item(num_vars_)
-					  )
-	       );
+				    / static_cast<double>(win_steps_)));
 
-  next_rec_.resize(2);  // just for safety's sake
-  next_rec_[0] = next_rec_[1] = 0;  // start at beginning of buffer
+  data_.resize(2);
+  data_[0].resize(num_vars_, recs_per_slice);
+  data_[1].resize(num_vars_, recs_per_slice);
 }
 
 template <typename HostNode>
@@ -116,37 +128,62 @@ void nest::UniversalDataLogger<HostNode>::DataLogger_::record_data(const HostNod
   if ( num_vars_ < 1 || step < next_rec_step_ )  
     return; 
 
+  next_rec_step_ += rec_int_steps_;
+
+  // time stamp: step is left end of update interval, so add 1
+  const long_t stamp = step + 1;
+
+  if ( win_steps_ > rec_int_steps_ )
+  {
+    // reduce sample into the current window
+    for ( size_t j = 0 ; j < num_vars_ ; ++j )
+    {
+      const double_t v = ((host).*(node_access_[j]))();
+      if ( n_acc_ == 0 )
+        acc_[j] = v;
+      else if ( reduction_ == DataLoggingRequest::MINIMUM )
+        acc_[j] = std::min(acc_[j], v);
+      else if ( reduction_ == DataLoggingRequest::MAXIMUM )
+        acc_[j] = std::max(acc_[j], v);
+      else
+        acc_[j] += v;
+    }
+    ++n_acc_;
+
+    if ( stamp % win_steps_ != 0 )
+      return;  // window not yet complete
+  }
+
   const size_t wt = Node::network()->write_toggle();
 
-  assert(wt < next_rec_.size());
   assert(wt < data_.size());
 
   /* The following assertion may fire if the multimeter connected to 
      this logger is frozen. In that case, handle() is not called and
-     next_rec_[wt] never reset. The assert() prevents error propagation.
+     the buffer never cleared. The assert() prevents error propagation.
      This is not an exception, since I consider the chance of users
      freezing multimeters very slim.
      See #464 for details.
    */
-  assert(next_rec_[wt] < data_[wt].size());
-
-  DataLoggingReply::Item& dest = data_[wt][next_rec_[wt]];
-
-  // set time stamp: step is left end of update interval, so add 1
-  dest.timestamp = Time::step(step + 1);
+  assert(data_[wt].size() < data_[wt].capacity());
 
-  // obtain data through access functions, calling via pointer-to-member
-  for ( size_t j = 0 ; j < num_vars_ ; ++j )
-    dest.data[j] = ((host).*(node_access_[j]))();
+  DataLoggingReply::Container& dest = data_[wt];
+  const size_t k = dest.push_back(Time::step(stamp));
 
-  next_rec_step_ += rec_int_steps_;
-
-  /* We just increment. Construction ensures that we cannot overflow,
-     and read-out resets. 
-     Overflow is possible if the multimeter is frozen, see #464.
-     In that case, the assertion above will trigger.
-  */
-  ++next_rec_[wt];  
+  if ( win_steps_ > rec_int_steps_ )
+  {
+    const double_t scale =
+      reduction_ == DataLoggingRequest::MEAN ? 1.0 / n_acc_ : 1.0;
+    for ( size_t j = 0 ; j < num_vars_ ; ++j )
+      dest.value(j, k) = scale * acc_[j];
+    n_acc_ = 0;
+  }
+  else
+  {
+    // obtain data through access functions, calling via pointer-to-member
+    for ( size_t j = 0 ; j < num_vars_ ; ++j )
+      dest.value(j, k) = ((host).*(node_access_[j]))();
+  }
 }
 
 template <typename HostNode>
@@ -156,39 +193,27 @@ void nest::UniversalDataLogger<HostNode>::DataLogger_::handle(HostNode& host,
   if ( num_vars_ < 1 )
     return;  // nothing to do
 
-  // The following assertions will fire if the user forgot to call init()
+  // The following assertion will fire if the user forgot to call init()
   // on the data logger.
-  assert(next_rec_.size() == 2);
-  assert(data_.size()     == 2);
+  assert(data_.size() == 2);
 
-  // get read toggle and start and end of slice
+  // get read toggle
   const size_t rt = Node::network()->read_toggle();
-  assert(not data_[rt].empty());
 
   // Check if we have valid data, i.e., data with time stamps within the
-  // past time slice. This may not be the case if the node has been frozen.
-  // In that case, we still reset the recording marker, to prepare for the next
-  // round.
-  if ( data_[rt][0].timestamp <= Node::network()->get_previous_slice_origin() )
+  // past time slice. This may not be the case if the node has been frozen,
+  // or if no reduction window ended during the past slice. In that case,
+  // we still clear the buffer, to prepare for the next round.
+  if ( data_[rt].size() == 0
+       || data_[rt].timestamp(0) <= Node::network()->get_previous_slice_origin() )
   {
-    next_rec_[rt] = 0;
+    data_[rt].clear();
     return;
   }
 
-  // If recording interval and min_delay are not commensurable,
-  // the last entry of data_ will not contain useful data for every
-  // other slice. We mark this by time stamp -infinity.
-  // Applying this mark here is less work than initializing all time stamps
-  // to -infinity after each call to this function.
-  if ( next_rec_[rt] < data_[rt].size() )
-    data_[rt][next_rec_[rt]].timestamp = Time::neg_inf();
-   
   // now create reply event and rigg it
   DataLoggingReply reply(data_[rt]);
 
-  // "clear" data
-  next_rec_[rt] = 0;
-
   reply.set_sender(host);
   reply.set_sender_gid(host.get_gid());
   reply.set_receiver(request.get_sender());
@@ -196,4 +221,7 @@ void nest::UniversalDataLogger<HostNode>::DataLogger_::handle(HostNode& host,
 
   // send it off
   host.network()->send_to_node(reply);
+
+  // "clear" data; the reply only references the buffer
+  data_[rt].clear();
 }
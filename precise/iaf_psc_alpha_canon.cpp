@@ -262,7 +262,7 @@ void nest::iaf_psc_alpha_canon::update(Time const & origin,
   
   // at start of slice, tell input queue to prepare for delivery
   if ( from == 0 )
-    B_.events_.prepare_delivery();
+    B_.events_.prepare_delivery(get_thread());
 
   /* Neurons may have been initialized to superthreshold potentials.
      We need to check for this here and issue spikes at the beginning of
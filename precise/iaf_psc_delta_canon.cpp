@@ -231,7 +231,7 @@ void iaf_psc_delta_canon::update(Time const & origin,
 
   // at start of slice, tell input queue to prepare for delivery
   if ( from == 0 )
-    B_.events_.prepare_delivery();
+    B_.events_.prepare_delivery(get_thread());
 
   /*
     The psc_delta neuron can fire only 
@@ -53,7 +53,7 @@ void parrot_neuron_ps::update(Time const &origin,
 
   // at start of slice, tell input queue to prepare for delivery
   if ( from == 0 )
-    B_.events_.prepare_delivery();
+    B_.events_.prepare_delivery(get_thread());
 
   for ( long_t lag = from; lag < to; ++lag )
   {
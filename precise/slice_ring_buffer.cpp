@@ -55,13 +55,87 @@ void nest::SliceRingBuffer::clear()
     queue_[j].clear();
 }
 
-void nest::SliceRingBuffer::prepare_delivery()
+void nest::SliceRingBuffer::prepare_delivery(thread t)
 {
   // vector to deliver from in this slice
   deliver_ = &(queue_[Scheduler::get_slice_modulo(0)]);
-  
-  // sort events, first event last
-  std::sort(deliver_->begin(), deliver_->end(), std::greater<SpikeInfo>());
+
+  // small slots are sorted directly, counting does not pay off there
+  if ( deliver_->size() < min_counted_events_ )
+  {
+    // sort events, first event last
+    std::sort(deliver_->begin(), deliver_->end(), std::greater<SpikeInfo>());
+    return;
+  }
+
+  long_t min_stamp = deliver_->front().stamp_;
+  long_t max_stamp = min_stamp;
+  for ( std::vector<SpikeInfo>::const_iterator it = deliver_->begin() ;
+        it != deliver_->end() ; ++it )
+  {
+    min_stamp = std::min(min_stamp, it->stamp_);
+    max_stamp = std::max(max_stamp, it->stamp_);
+  }
+
+  // all stamps should lie within the slice; if not, sort the slow way
+  const size_t n_steps = static_cast<size_t>(max_stamp - min_stamp) + 1;
+  if ( n_steps > static_cast<size_t>(Scheduler::get_min_delay()) )
+  {
+    std::sort(deliver_->begin(), deliver_->end(), std::greater<SpikeInfo>());
+    return;
+  }
+
+  // scratch of the thread: end[j] is the end of the events of step j,
+  // next[j] the position at which the next event of step j is placed;
+  // index 0 is the last step, which is delivered last
+  std::vector<size_t>& buffer = Scheduler::get_sort_buffer(t);
+  assert(buffer.size() >= 2 * n_steps + 1);
+  size_t* const end = &buffer[0];
+  size_t* const next = &buffer[n_steps + 1];
+
+  // count events per step
+  std::fill(end, end + n_steps + 1, 0);
+  bool distinct = true;
+  for ( std::vector<SpikeInfo>::const_iterator it = deliver_->begin() ;
+        it != deliver_->end() ; ++it )
+    if ( ++end[max_stamp - it->stamp_] > 1 )
+      distinct = false;
+
+  // turn counts into the bounds of the steps
+  size_t pos = 0;
+  for ( size_t j = 0 ; j < n_steps ; ++j )
+  {
+    next[j] = pos;
+    pos += end[j];
+    end[j] = pos;
+  }
+
+  // move each event to its step in place, first step last; every swap
+  // puts one event into its final step
+  std::vector<SpikeInfo>& events = *deliver_;
+  for ( size_t j = 0 ; j < n_steps ; ++j )
+    while ( next[j] < end[j] )
+    {
+      const size_t k = max_stamp - events[next[j]].stamp_;
+      if ( k == j )
+        ++next[j];
+      else
+        std::swap(events[next[j]], events[next[k]++]);
+    }
+
+  // with at most one event per step, the events are sorted now;
+  // otherwise sort events within steps by offset, first event last
+  if ( distinct )
+    return;
+
+  size_t begin = 0;
+  for ( size_t j = 0 ; j < n_steps ; ++j )
+  {
+    if ( end[j] - begin > 1 )
+      std::sort(events.begin() + begin, events.begin() + end[j],
+                std::greater<SpikeInfo>());
+    begin = end[j];
+  }
 }
 
 void nest::SliceRingBuffer::discard_events()
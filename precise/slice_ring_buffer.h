@@ -41,6 +41,13 @@ namespace nest
    * one by one in correct temporal order.  Coinciding spikes
    * are combined into one, see get_next_spike().
    *
+   * Slots with fewer than min_counted_events_ spikes are sorted
+   * directly.  Larger slots exploit that a slice spans only
+   * min_delay steps: their spikes are distributed over their steps
+   * in place (counting sort), and only steps receiving more than
+   * one spike are sorted by offset.  The counts are kept in scratch
+   * memory of the thread, see Scheduler::get_sort_buffer().
+   *
    * Data is organized as follows:
    * - The time of the next return from refractoriness is 
    *   stored in a separate variable and checked explicitly;
@@ -78,8 +85,10 @@ namespace nest
 
     /**
      * Prepare for spike delivery in current slice by sorting.
+     * @param t  thread of the neuron owning the buffer
+     * @see SliceRingBuffer
      */
-    void prepare_delivery();
+    void prepare_delivery(thread t);
 
     /**
      * Discard all events in current slice.
@@ -122,6 +131,7 @@ namespace nest
      * Information about spike.
      */
     struct SpikeInfo {
+      SpikeInfo() {}
       SpikeInfo(long_t stamp, double_t ps_offset, double_t weight);
       
       bool operator< (const SpikeInfo& b) const;
@@ -135,6 +145,12 @@ namespace nest
       double_t weight_;    //<! spike weight
     };
 
+    /**
+     * Smallest slot that is sorted by step.  Below, std::sort is
+     * faster for min_delay between 2 and 100 steps.
+     */
+    static const size_t min_counted_events_ = 32;
+
     //! entire queue, one slot per min_delay block within max_delay
     std::vector<std::vector<SpikeInfo> > queue_;
 
@@ -0,0 +1,252 @@
+/*
+ *  cell_list.h
+ *
+ *  This file is part of NEST.
+ *
+ *  Copyright (C) 2004 The NEST Initiative
+ *
+ *  NEST is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  NEST is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with NEST.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef CELL_LIST_H
+#define CELL_LIST_H
+
+#include <vector>
+#include <bitset>
+#include <cmath>
+#include <algorithm>
+#include "nest.h"
+#include "position.h"
+#include "ntree_impl.h"
+#include "mask.h"
+
+namespace nest
+{
+
+  /**
+   * A uniform grid of cells covering the region of an Ntree, each cell
+   * holding the nodes positioned inside it.
+   *
+   * The cell list is used instead of Ntree::masked_iterator when the same
+   * mask is applied at many anchor positions, e.g., once for each target
+   * when connecting layers. The nodes are stored cell by cell in one
+   * contiguous array, so that a query only visits the cells overlapping
+   * the bounding box of the mask. All nodes of a cell whose bounding box
+   * is inside the mask are taken without testing each of them. The cell
+   * size is chosen such that a cell holds nodes_per_cell nodes on average.
+   *
+   * The mask is applied exactly as by Ntree::masked_iterator, including
+   * the treatment of periodic boundary conditions, but the nodes are
+   * found in a different order. The list is not modified by queries and
+   * may be used by several threads at the same time.
+   */
+  template<int D>
+  class CellList
+  {
+  public:
+    typedef std::pair<Position<D>,index> value_type;
+
+    static const index nodes_per_cell = 4;
+
+    /**
+     * Create a cell list containing the nodes of the given Ntree.
+     */
+    CellList(Ntree<D,index>& tree);
+
+    /**
+     * Store all nodes inside the mask centered on the anchor in result.
+     */
+    void get_nodes(const Mask<D>& mask, const Position<D>& anchor,
+                   std::vector<value_type>& result) const;
+
+  private:
+    /**
+     * Append the nodes inside the mask for a single image of the anchor.
+     */
+    void append_nodes_(const Mask<D>& mask, const Position<D>& anchor,
+                       std::vector<value_type>& result) const;
+
+    /**
+     * @returns index of the cell containing x in dimension i, clamped to
+     *          the range of cells.
+     */
+    int cell_index_(double_t x, int i) const;
+
+    Position<D> lower_left_;
+    Position<D> extent_;
+    std::bitset<D> periodic_;
+
+    Position<D> cell_extent_;
+    Position<D,int> n_cells_;     //!< number of cells in each dimension
+
+    std::vector<size_t> cell_begin_;    //!< first node of each cell, one extra entry at end
+    std::vector<Box<D> > cell_bbox_;    //!< bounding box of the nodes in each cell
+    std::vector<value_type> nodes_;     //!< nodes ordered by cell
+  };
+
+  template<int D>
+  CellList<D>::CellList(Ntree<D,index>& tree):
+    lower_left_(tree.get_lower_left()),
+    extent_(tree.get_extent()),
+    periodic_(tree.get_periodic_mask())
+  {
+    std::vector<value_type> nodes = tree.get_nodes();
+
+    // choose cubic cells holding nodes_per_cell nodes on average
+    double_t volume = 1.0;
+    for(int i=0;i<D;++i)
+      volume *= extent_[i];
+    const double_t n_target = std::max(1.0, double_t(nodes.size()) / nodes_per_cell);
+    const double_t side = std::pow(volume / n_target, 1.0/D);
+
+    size_t n_total = 1;
+    for(int i=0;i<D;++i) {
+      n_cells_[i] = std::max(1, int(std::min(extent_[i] / side, n_target)));
+      cell_extent_[i] = extent_[i] / n_cells_[i];
+      n_total *= n_cells_[i];
+    }
+
+    // counting sort of the nodes by cell, preserving their order within cells
+    std::vector<size_t> cell(nodes.size());
+    cell_begin_.assign(n_total+1, 0);
+    for(size_t j=0;j<nodes.size();++j) {
+      size_t c = 0;
+      for(int i=D-1;i>=0;--i)
+        c = c * n_cells_[i] + cell_index_(nodes[j].first[i], i);
+      cell[j] = c;
+      ++cell_begin_[c+1];
+    }
+    for(size_t c=0;c<n_total;++c)
+      cell_begin_[c+1] += cell_begin_[c];
+
+    std::vector<size_t> next(cell_begin_.begin(), cell_begin_.end()-1);
+    nodes_.resize(nodes.size());
+    for(size_t j=0;j<nodes.size();++j)
+      nodes_[next[cell[j]]++] = nodes[j];
+
+    cell_bbox_.resize(n_total);
+    for(size_t c=0;c<n_total;++c) {
+      if (cell_begin_[c] == cell_begin_[c+1])
+        continue;
+      Box<D> &bb = cell_bbox_[c];
+      bb.lower_left = bb.upper_right = nodes_[cell_begin_[c]].first;
+      for(size_t j=cell_begin_[c]+1;j<cell_begin_[c+1];++j) {
+        for(int i=0;i<D;++i) {
+          bb.lower_left[i] = std::min(bb.lower_left[i], nodes_[j].first[i]);
+          bb.upper_right[i] = std::max(bb.upper_right[i], nodes_[j].first[i]);
+        }
+      }
+    }
+  }
+
+  template<int D>
+  inline
+  int CellList<D>::cell_index_(double_t x, int i) const
+  {
+    const double_t c = std::floor((x - lower_left_[i]) / cell_extent_[i]);
+    if (not (c > 0))
+      return 0;
+    if (c >= n_cells_[i])
+      return n_cells_[i]-1;
+    return int(c);
+  }
+
+  template<int D>
+  void CellList<D>::get_nodes(const Mask<D>& mask, const Position<D>& anchor,
+                              std::vector<value_type>& result) const
+  {
+    result.clear();
+
+    if (not periodic_.any()) {
+      append_nodes_(mask, anchor, result);
+      return;
+    }
+
+    // Images of the anchor as in Ntree::masked_iterator
+    Box<D> mask_bb = mask.get_bbox();
+    Position<D> main_anchor = anchor;
+
+    // Move lower left corner of mask into main image of layer
+    for(int i=0;i<D;++i) {
+      if (periodic_[i]) {
+        main_anchor[i] = nest::mod(main_anchor[i] + mask_bb.lower_left[i] - lower_left_[i], extent_[i]) - mask_bb.lower_left[i] + lower_left_[i];
+      }
+    }
+
+    std::vector<Position<D> > anchors(1, main_anchor);
+
+    // Add extra anchors for each dimension where this is needed
+    // (Assumes that the mask is not wider than the layer)
+    for(int i=0;i<D;++i) {
+      if (periodic_[i]) {
+        const size_t n = anchors.size();
+        if ((main_anchor[i] + mask_bb.upper_right[i] - lower_left_[i]) > extent_[i]) {
+          for(size_t j=0;j<n;++j) {
+            Position<D> p = anchors[j];
+            p[i] -= extent_[i];
+            anchors.push_back(p);
+          }
+        }
+      }
+    }
+
+    for(size_t j=0;j<anchors.size();++j)
+      append_nodes_(mask, anchors[j], result);
+  }
+
+  template<int D>
+  void CellList<D>::append_nodes_(const Mask<D>& mask, const Position<D>& anchor,
+                                  std::vector<value_type>& result) const
+  {
+    const Box<D> mask_bb = mask.get_bbox();
+
+    Position<D,int> lo, hi;
+    for(int i=0;i<D;++i) {
+      lo[i] = cell_index_(anchor[i] + mask_bb.lower_left[i], i);
+      hi[i] = cell_index_(anchor[i] + mask_bb.upper_right[i], i);
+    }
+
+    // visit all cells in [lo, hi], dimension 0 running fastest
+    Position<D,int> c = lo;
+    while (true) {
+      size_t k = 0;
+      for(int i=D-1;i>=0;--i)
+        k = k * n_cells_[i] + c[i];
+
+      if (cell_begin_[k] < cell_begin_[k+1]) {
+        const Box<D> bb(cell_bbox_[k].lower_left - anchor, cell_bbox_[k].upper_right - anchor);
+        if (mask.inside(bb)) {
+          result.insert(result.end(), nodes_.begin() + cell_begin_[k], nodes_.begin() + cell_begin_[k+1]);
+        } else if (not mask.outside(bb)) {
+          for(size_t j=cell_begin_[k];j<cell_begin_[k+1];++j)
+            if (mask.inside(nodes_[j].first - anchor))
+              result.push_back(nodes_[j]);
+        }
+      }
+
+      int i = 0;
+      while (i < D and c[i] == hi[i]) {
+        c[i] = lo[i];
+        ++i;
+      }
+      if (i == D)
+        break;
+      ++c[i];
+    }
+  }
+
+} // namespace nest
+
+#endif
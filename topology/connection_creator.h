@@ -32,6 +32,7 @@
 #include "mask.h"
 #include "parameter.h"
 #include "selector.h"
+#include "cell_list.h"
 
 namespace nest
 {
@@ -103,7 +104,9 @@ namespace nest
      * Wrapper for masked and unmasked pools.
      *
      * The purpose is to avoid code doubling for cases with and without masks.
-     * Essentially, the class works as a fancy union.
+     * Essentially, the class works as a fancy union. For masked pools, the
+     * nodes are binned into a CellList once, which is then queried for
+     * each target.
      */
     template <int D>
     class PoolWrapper_
@@ -113,21 +116,46 @@ namespace nest
       ~PoolWrapper_();
       void define(MaskedLayer<D>*);
       void define(std::vector<std::pair<Position<D>,index> >*); 
-      
-      typename Ntree<D,index>::masked_iterator masked_begin(const Position<D>& pos) const;
-      typename Ntree<D,index>::masked_iterator masked_end() const;
+
+      /**
+       * Store the nodes inside the mask centered on pos in nodes.
+       */
+      void get_masked_nodes(const Position<D>& pos, std::vector<std::pair<Position<D>,index> >& nodes) const;
 
       typename std::vector<std::pair<Position<D>,index> >::iterator begin() const;
       typename std::vector<std::pair<Position<D>,index> >::iterator end() const;
 
     private:
       MaskedLayer<D>* masked_layer_;
+      CellList<D>* cell_list_;
       std::vector<std::pair<Position<D>,index> >* positions_;
     };
 
+    /**
+     * Connect the given sources to the target, conditionally on the
+     * kernel. The kernel is evaluated for all sources at once.
+     */
     template<typename Iterator, int D>
     void connect_to_target_(Iterator from, Iterator to, index tgt_id, 
-			    const Position<D>& tgt_pos, thread tgt_thread, const Layer<D>& source);
+			    const Position<D>& tgt_pos, thread tgt_thread,
+			    const Layer<D>& source, const Layer<D>& target);
+
+    /**
+     * Connect the given sources to the target, with weights and delays
+     * computed for all connections at once. Only used if weights and
+     * delays are deterministic.
+     */
+    template<int D>
+    void connect_sources_(const std::vector<index>& sources,
+			  const std::vector<Position<D> >& displacements,
+			  index tgt_id, librandom::RngPtr& rng);
+
+    /**
+     * Loop over the local targets in parallel and connect each to the
+     * sources in the pool. Used for target and source driven connections.
+     */
+    template<int D>
+    void pool_connect_(Layer<D>& source, Layer<D>& target, const PoolWrapper_<D>& pool);
 
     template<int D>
     void target_driven_connect_(Layer<D>& source, Layer<D>& target);
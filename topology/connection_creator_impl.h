@@ -76,38 +76,94 @@ namespace nest
   template<typename Iterator, int D>
   void ConnectionCreator::connect_to_target_(Iterator from, Iterator to, index tgt_id, 
 					     const Position<D>& tgt_pos, thread tgt_thread,
-					     const Layer<D>& source)
+					     const Layer<D>& source, const Layer<D>& target)
   {
     librandom::RngPtr rng = net_.get_rng(tgt_thread);
 
-    const bool without_kernel = not kernel_.valid();
+    // Collect the candidate sources and their displacements. For source
+    // driven connections, displacements are computed in the target layer.
+    std::vector<index> sources;
+    std::vector<Position<D> > displacements;
     for ( Iterator iter = from ; iter != to ; ++iter )
     {
       if ( (not allow_autapses_) and (iter->second == tgt_id) )
 	continue;
 
-      if ( without_kernel or
-	   rng->drand() < kernel_->value(source.compute_displacement(tgt_pos, iter->first), rng)
-	 ) 
+      sources.push_back(iter->second);
+      if ( type_ == Source_driven )
+	displacements.push_back(target.compute_displacement(iter->first, tgt_pos));
+      else
+	displacements.push_back(source.compute_displacement(tgt_pos, iter->first));
+    }
+
+    const bool without_kernel = not kernel_.valid();
+    std::vector<double_t> probabilities;
+    if ( not without_kernel )
+      kernel_->values(displacements, rng, probabilities);
+
+    // Random weights and delays must be drawn connection by connection to
+    // keep the order of random numbers, deterministic ones are computed
+    // for all connections of the target at once.
+    const bool batch = weight_->is_deterministic() and delay_->is_deterministic();
+    std::vector<index> selected_sources;
+    std::vector<Position<D> > selected_displacements;
+
+    for ( index i = 0 ; i < sources.size() ; ++i )
+    {
+      if ( without_kernel or rng->drand() < probabilities[i] )
       {
-	const Position<D> disp = source.compute_displacement(tgt_pos,iter->first);
-	net_.connect(iter->second, tgt_id, 
-		     weight_->value(disp, rng),
-		     delay_->value(disp, rng),
-		     synapse_model_);
+	if ( batch )
+	{
+	  selected_sources.push_back(sources[i]);
+	  selected_displacements.push_back(displacements[i]);
+	}
+	else
+	{
+	  // target driven connections draw the delay first, as g++ did when
+	  // both were evaluated as arguments of connect(); source driven
+	  // connections draw the weight first
+	  double w,d;
+	  if ( type_ == Target_driven )
+	  {
+	    d = delay_->value(displacements[i], rng);
+	    w = weight_->value(displacements[i], rng);
+	  }
+	  else
+	    get_parameters_(displacements[i], rng, w,d);
+	  net_.connect(sources[i], tgt_id, w,d, synapse_model_);
+	}
       }
     }
+
+    if ( batch )
+      connect_sources_(selected_sources, selected_displacements, tgt_id, rng);
+  }
+
+  template<int D>
+  void ConnectionCreator::connect_sources_(const std::vector<index>& sources,
+					   const std::vector<Position<D> >& displacements,
+					   index tgt_id, librandom::RngPtr& rng)
+  {
+    std::vector<double_t> weights, delays;
+    weight_->values(displacements, rng, weights);
+    delay_->values(displacements, rng, delays);
+
+    for ( index i = 0 ; i < sources.size() ; ++i )
+      net_.connect(sources[i], tgt_id, weights[i], delays[i], synapse_model_);
   }
 
   template <int D>
   ConnectionCreator::PoolWrapper_<D>::PoolWrapper_():
     masked_layer_(0),
+    cell_list_(0),
     positions_(0)
   {}
 
   template <int D>
   ConnectionCreator::PoolWrapper_<D>::~PoolWrapper_()
   {
+    if ( cell_list_ )
+      delete cell_list_;
     if ( masked_layer_ )
       delete masked_layer_;
   }
@@ -119,6 +175,7 @@ namespace nest
     assert(positions_ == 0);
     assert(ml != 0);
     masked_layer_ = ml;
+    cell_list_ = new CellList<D>(*masked_layer_->get_ntree());
   }
   
   template <int D>
@@ -131,15 +188,10 @@ namespace nest
   }
 
   template <int D>
-  typename Ntree<D,index>::masked_iterator ConnectionCreator::PoolWrapper_<D>::masked_begin(const Position<D>& pos) const
+  void ConnectionCreator::PoolWrapper_<D>::get_masked_nodes(const Position<D>& pos,
+							    std::vector<std::pair<Position<D>,index> >& nodes) const
   { 
-    return masked_layer_->begin(pos); 
-  }
-  
-  template <int D>
-  typename Ntree<D,index>::masked_iterator ConnectionCreator::PoolWrapper_<D>::masked_end() const
-  { 
-    return masked_layer_->end(); 
+    cell_list_->get_nodes(masked_layer_->get_mask(), pos, nodes);
   }
 
   template <int D>
@@ -156,14 +208,8 @@ namespace nest
 
 
   template<int D>
-  void ConnectionCreator::target_driven_connect_(Layer<D>& source, Layer<D>& target)
+  void ConnectionCreator::pool_connect_(Layer<D>& source, Layer<D>& target, const PoolWrapper_<D>& pool)
   {
-    // Target driven connect
-    // For each local target node:
-    //  1. Apply Mask to source layer
-    //  2. For each source node: Compute probability, draw random number, make
-    //     connection conditionally
-
     // Nodes in the subnet are grouped by depth, so to select by depth, we
     // just adjust the begin and end pointers:
     std::vector<Node*>::const_iterator target_begin;
@@ -176,16 +222,12 @@ namespace nest
       target_end = target.local_end();
     }
 
-    // retrieve global positions, either for masked or unmasked pool
-    PoolWrapper_<D> pool;
-    if ( mask_.valid() )  // MaskedLayer will be freed by PoolWrapper d'tor
-      pool.define(new MaskedLayer<D>(source,source_filter_,mask_,true,allow_oversized_));
-    else
-      pool.define(source.get_global_positions_vector(source_filter_));
-
     // sharing specs on next line commented out because gcc 4.2 cannot handle them
-#pragma omp parallel //default(none) shared(source, target, masked_layer, target_begin, target_end)
+#pragma omp parallel //default(none) shared(source, target, pool, target_begin, target_end)
     {
+      // sources inside the mask, reused for all targets of this thread
+      std::vector<std::pair<Position<D>,index> > masked_sources;
+
       for ( std::vector<Node*>::const_iterator tgt_it = target_begin;
 	    tgt_it != target_end;
 	    ++tgt_it ) 
@@ -204,15 +246,37 @@ namespace nest
 	const Position<D> target_pos = target.get_position((*tgt_it)->get_subnet_index());
 
 	if ( mask_.valid() )
-	  connect_to_target_(pool.masked_begin(target_pos), pool.masked_end(), 
-			     target_id, target_pos, target_thread, source);
+	{
+	  pool.get_masked_nodes(target_pos, masked_sources);
+	  connect_to_target_(masked_sources.begin(), masked_sources.end(), 
+			     target_id, target_pos, target_thread, source, target);
+	}
 	else
 	  connect_to_target_(pool.begin(), pool.end(), 
-			     target_id, target_pos, target_thread, source);
+			     target_id, target_pos, target_thread, source, target);
       } // for target_begin
     }  // omp parallel
   }
 
+  template<int D>
+  void ConnectionCreator::target_driven_connect_(Layer<D>& source, Layer<D>& target)
+  {
+    // Target driven connect
+    // For each local target node:
+    //  1. Apply Mask to source layer
+    //  2. For each source node: Compute probability, draw random number, make
+    //     connection conditionally
+
+    // retrieve global positions, either for masked or unmasked pool
+    PoolWrapper_<D> pool;
+    if ( mask_.valid() )  // MaskedLayer will be freed by PoolWrapper d'tor
+      pool.define(new MaskedLayer<D>(source,source_filter_,mask_,true,allow_oversized_));
+    else
+      pool.define(source.get_global_positions_vector(source_filter_));
+
+    pool_connect_(source, target, pool);
+  }
+
 
   template<int D>
   void ConnectionCreator::source_driven_connect_(Layer<D>& source, Layer<D>& target)
@@ -225,113 +289,16 @@ namespace nest
     //  2. For each source node: Compute probability, draw random number, make
     //     connection conditionally
 
-    // Nodes in the subnet are grouped by depth, so to select by depth, we
-    // just adjust the begin and end pointers:
-    std::vector<Node*>::const_iterator target_begin;
-    std::vector<Node*>::const_iterator target_end;
-    if (target_filter_.select_depth()) {
-      target_begin = target.local_begin(target_filter_.depth);
-      target_end = target.local_end(target_filter_.depth);
-    } else {
-      target_begin = target.local_begin();
-      target_end = target.local_end();
-    }
-
-    if (mask_.valid()) {
-
+    // retrieve global positions, either for masked or unmasked pool
+    PoolWrapper_<D> pool;
+    if ( mask_.valid() )
       // By supplying the target layer to the MaskedLayer constructor, the
       // mask is mirrored so it may be applied to the source layer instead
-      MaskedLayer<D> masked_layer(source,source_filter_,mask_,true,allow_oversized_,target);
-
-      for (std::vector<Node*>::const_iterator tgt_it = target_begin;tgt_it != target_end;++tgt_it) {
-
-        if (target_filter_.select_model() && ((*tgt_it)->get_model_id() != target_filter_.model))
-          continue;
-
-        index target_id = (*tgt_it)->get_gid();
-        librandom::RngPtr rng = net_.get_rng((*tgt_it)->get_thread());
-        Position<D> target_pos = target.get_position((*tgt_it)->get_subnet_index());
-
-        // If there is a kernel, we create connections conditionally,
-        // otherwise all sources within the mask are created. Test moved
-        // outside the loop for efficiency.
-        if (kernel_.valid()) {
-
-          for(typename Ntree<D,index>::masked_iterator iter=masked_layer.begin(target_pos); iter!=masked_layer.end(); ++iter) {
-
-            if ((not allow_autapses_) and (iter->second == target_id))
-              continue;
-
-            if (rng->drand() < kernel_->value(target.compute_displacement(iter->first, target_pos), rng)) {
-	      double w, d;
-              get_parameters_(target.compute_displacement(iter->first, target_pos), rng, w, d);
-              net_.connect(iter->second,target_id, w, d,synapse_model_);
-            }
-
-          }
-
-        } else {
-
-          // no kernel
-
-          for(typename Ntree<D,index>::masked_iterator iter=masked_layer.begin(target_pos); iter!=masked_layer.end(); ++iter) {
-
-            if ((not allow_autapses_) and (iter->second == target_id))
-              continue;
-	    double w, d;
-            get_parameters_(target.compute_displacement(iter->first,target_pos), rng, w, d);
-            net_.connect(iter->second,target_id,w,d,synapse_model_);
-          }
-
-        }
-
-      }
-
-    } else {
-      // no mask
-
-      std::vector<std::pair<Position<D>,index> >* positions = source.get_global_positions_vector(source_filter_);
-      for (std::vector<Node*>::const_iterator tgt_it = target_begin;tgt_it != target_end;++tgt_it) {
-
-        if (target_filter_.select_model() && ((*tgt_it)->get_model_id() != target_filter_.model))
-          continue;
-
-        index target_id = (*tgt_it)->get_gid();
-        librandom::RngPtr rng = net_.get_rng((*tgt_it)->get_thread());
-        Position<D> target_pos = target.get_position((*tgt_it)->get_subnet_index());
-
-        // If there is a kernel, we create connections conditionally,
-        // otherwise all sources within the mask are created. Test moved
-        // outside the loop for efficiency.
-        if (kernel_.valid()) {
-
-          for(typename std::vector<std::pair<Position<D>,index> >::iterator iter=positions->begin();iter!=positions->end();++iter) {
-
-            if ((not allow_autapses_) and (iter->second == target_id))
-              continue;
-
-            if (rng->drand() < kernel_->value(target.compute_displacement(iter->first,target_pos), rng)) {
-	      double w,d;
-              get_parameters_(target.compute_displacement(iter->first,target_pos), rng, w, d);
-              net_.connect(iter->second,target_id,w,d,synapse_model_);
-            }
-          }
-
-        } else {
-
-          for(typename std::vector<std::pair<Position<D>,index> >::iterator iter=positions->begin();iter!=positions->end();++iter) {
-
-            if ((not allow_autapses_) and (iter->second == target_id))
-              continue;
-	    double w,d;
-            get_parameters_(target.compute_displacement(iter->first,target_pos), rng, w, d);
-            net_.connect(iter->second,target_id,w,d,synapse_model_);
-          }
-
-        }
-      }
-    }
+      pool.define(new MaskedLayer<D>(source,source_filter_,mask_,true,allow_oversized_,target));
+    else
+      pool.define(source.get_global_positions_vector(source_filter_));
 
+    pool_connect_(source, target, pool);
   }
 
   template<int D>
@@ -357,125 +324,76 @@ namespace nest
       target_end = target.local_end();
     }
 
-    if (mask_.valid()) {
-
-      for (std::vector<Node*>::const_iterator tgt_it = target_begin;tgt_it != target_end;++tgt_it) {
-
-        if (target_filter_.select_model() && ((*tgt_it)->get_model_id() != target_filter_.model))
-          continue;
-
-        index target_id = (*tgt_it)->get_gid();
-        librandom::RngPtr rng = net_.get_rng((*tgt_it)->get_thread());
-        Position<D> target_pos = target.get_position((*tgt_it)->get_subnet_index());
-
-        // Get (position,GID) pairs for sources inside mask
-        std::vector<std::pair<Position<D>,index> > positions =
-            source.get_global_positions_vector(source_filter_, mask_,
-                                               target.get_position((*tgt_it)->get_subnet_index()),
-                                               allow_oversized_);
-
-        // We will select `number_of_connections_` sources within the mask.
-        // If there is no kernel, we can just draw uniform random numbers,
-        // but with a kernel we have to set up a probability distribution
-        // function using the Vose class.
-        if (kernel_.valid()) {
-
-          std::vector<double_t> probabilities;
-
-          // Collect probabilities for the sources
-          for(typename std::vector<std::pair<Position<D>,index> >::iterator iter=positions.begin();iter!=positions.end();++iter) {
-
-              probabilities.push_back(kernel_->value(source.compute_displacement(target_pos,iter->first), rng));
-
-          }
-
-          if ( positions.empty() or
-              ((not allow_autapses_) and (positions.size()==1) and (positions[0].second==target_id)) or
-              ((not allow_multapses_) and (positions.size()<number_of_connections_)) ) {
-            std::string msg = String::compose("Global target ID %1: Not enough sources found inside mask", target_id);
-            throw KernelException(msg.c_str());
-          }
-
-          // A Vose object draws random integers with a non-uniform
-          // distribution.
-          Vose lottery(probabilities);
-
-          // If multapses are not allowed, we must keep track of which
-          // sources have been selected already.
-          std::vector<bool> is_selected(positions.size());
-
-          // Draw `number_of_connections_` sources
-          for(int i=0;i<(int)number_of_connections_;++i) {
-            index random_id = lottery.get_random_id(rng);
-            if ((not allow_multapses_) and (is_selected[random_id])) {
-              --i;
-              continue;
-            }
-
-            index source_id = positions[random_id].second;
-            if ((not allow_autapses_) and (source_id == target_id)) {
-              --i;
-              continue;
-            }
-	    double w,d;
-            get_parameters_(source.compute_displacement(target_pos,positions[random_id].first), rng, w,d);
-            net_.connect(source_id, target_id, w,d, synapse_model_);
-            is_selected[random_id] = true;
-          }
-
-        } else {
-
-          // no kernel
-
-          if ( positions.empty() or
-              ((not allow_autapses_) and (positions.size()==1) and (positions[0].second==target_id)) or
-              ((not allow_multapses_) and (positions.size()<number_of_connections_)) ) {
-            std::string msg = String::compose("Global target ID %1: Not enough sources found inside mask", target_id);
-            throw KernelException(msg.c_str());
-          }
-
-          // If multapses are not allowed, we must keep track of which
-          // sources have been selected already.
-          std::vector<bool> is_selected(positions.size());
+    // Get (position,GID) pairs for all nodes in source layer, or prepare
+    // the masked pool from which the sources inside the mask are taken
+    PoolWrapper_<D> pool;
+    std::vector<std::pair<Position<D>,index> >* all_positions = 0;
+    if ( mask_.valid() )
+      pool.define(new MaskedLayer<D>(source,source_filter_,mask_,true,allow_oversized_));
+    else
+      all_positions = source.get_global_positions_vector(source_filter_);
 
-          // Draw `number_of_connections_` sources
-          for(int i=0;i<(int)number_of_connections_;++i) {
-            index random_id = rng->ulrand(positions.size());
-            if ((not allow_multapses_) and (is_selected[random_id])) {
-              --i;
-              continue;
-            }
-            index source_id = positions[random_id].second;
-	    double w,d;
-            get_parameters_(source.compute_displacement(target_pos,positions[random_id].first), rng, w,d);
-            net_.connect(source_id, target_id, w,d, synapse_model_);
-            is_selected[random_id] = true;
-          }
+    // Exceptions must not be thrown in the parallel section. If not enough
+    // sources are found for a target, all threads stop and the error is
+    // reported afterwards. We don't use omp flush for abort, see
+    // Network::convergent_connect().
+    bool abort = false;
+    std::string error;
 
-        }
+    // Deterministic weights and delays are computed for all connections
+    // of a target at once, see connect_to_target_().
+    const bool batch = weight_->is_deterministic() and delay_->is_deterministic();
 
-      }
+#pragma omp parallel
+    {
+      std::vector<std::pair<Position<D>,index> > masked_positions;
+      std::vector<Position<D> > displacements;
+      std::vector<double_t> probabilities;
+      std::vector<index> selected_sources;
+      std::vector<Position<D> > selected_displacements;
 
-    } else {
-      // no mask
+      for (std::vector<Node*>::const_iterator tgt_it = target_begin;tgt_it != target_end && !abort;++tgt_it) {
 
-      // Get (position,GID) pairs for all nodes in source layer
-      std::vector<std::pair<Position<D>,index> >* positions = source.get_global_positions_vector(source_filter_);
+	const thread target_thread = (*tgt_it)->get_thread();
 
-      for (std::vector<Node*>::const_iterator tgt_it = target_begin;tgt_it != target_end;++tgt_it) {
+#ifdef _OPENMP
+	if ( target_thread != omp_get_thread_num() )
+	  continue;
+#endif
 
         if (target_filter_.select_model() && ((*tgt_it)->get_model_id() != target_filter_.model))
           continue;
 
         index target_id = (*tgt_it)->get_gid();
-        librandom::RngPtr rng = net_.get_rng((*tgt_it)->get_thread());
+        librandom::RngPtr rng = net_.get_rng(target_thread);
         Position<D> target_pos = target.get_position((*tgt_it)->get_subnet_index());
 
-        if ( (positions->size()==0) or
-             ((not allow_autapses_) and (positions->size()==1) and ((*positions)[0].second==target_id)) or
-             ((not allow_multapses_) and (positions->size()<number_of_connections_)) ) {
-          std::string msg = String::compose("Global target ID %1: Not enough sources found", target_id);
-          throw KernelException(msg.c_str());
+        // Get (position,GID) pairs for sources inside mask
+        const std::vector<std::pair<Position<D>,index> >* positions = all_positions;
+        if ( mask_.valid() ) {
+          pool.get_masked_nodes(target_pos, masked_positions);
+          positions = &masked_positions;
+        }
+
+        // Number of sources other than the target itself, if autapses are
+        // not allowed. Counted only for the sources inside the mask, as this
+        // would require a pass over the whole layer otherwise.
+        index n_available = positions->size();
+        if ((not allow_autapses_) and (mask_.valid() or n_available==1))
+          for(index j=0;j<positions->size();++j)
+            if ((*positions)[j].second == target_id)
+              --n_available;
+
+        if ( (n_available==0) or
+             ((not allow_multapses_) and (n_available<number_of_connections_)) ) {
+#pragma omp critical
+          {
+            if (not abort)
+              error = String::compose(mask_.valid() ? "Global target ID %1: Not enough sources found inside mask"
+                                                    : "Global target ID %1: Not enough sources found", target_id);
+            abort = true;
+          }
+          continue;
         }
 
         // We will select `number_of_connections_` sources within the mask.
@@ -484,12 +402,11 @@ namespace nest
         // function using the Vose class.
         if (kernel_.valid()) {
 
-          std::vector<double_t> probabilities;
-
           // Collect probabilities for the sources
-          for(typename std::vector<std::pair<Position<D>,index> >::iterator iter=positions->begin();iter!=positions->end();++iter) {
-            probabilities.push_back(kernel_->value(source.compute_displacement(target_pos,iter->first), rng));
-          }
+          displacements.resize(positions->size());
+          for(index j=0;j<positions->size();++j)
+            displacements[j] = source.compute_displacement(target_pos,(*positions)[j].first);
+          kernel_->values(displacements, rng, probabilities);
 
           // A Vose object draws random integers with a non-uniform
           // distribution.
@@ -498,6 +415,8 @@ namespace nest
           // If multapses are not allowed, we must keep track of which
           // sources have been selected already.
           std::vector<bool> is_selected(positions->size());
+          selected_sources.clear();
+          selected_displacements.clear();
 
           // Draw `number_of_connections_` sources
           for(int i=0;i<(int)number_of_connections_;++i) {
@@ -512,14 +431,20 @@ namespace nest
               --i;
               continue;
             }
-
-            Position<D> source_pos = (*positions)[random_id].first;
-	    double w,d;
-            get_parameters_(source.compute_displacement(target_pos,source_pos), rng, w,d);
-            net_.connect(source_id, target_id, w,d, synapse_model_);
+            if (batch) {
+              selected_sources.push_back(source_id);
+              selected_displacements.push_back(displacements[random_id]);
+            } else {
+              double w,d;
+              get_parameters_(displacements[random_id], rng, w,d);
+              net_.connect(source_id, target_id, w,d, synapse_model_);
+            }
             is_selected[random_id] = true;
           }
 
+          if (batch)
+            connect_sources_(selected_sources, selected_displacements, target_id, rng);
+
         } else {
 
           // no kernel
@@ -527,6 +452,8 @@ namespace nest
           // If multapses are not allowed, we must keep track of which
           // sources have been selected already.
           std::vector<bool> is_selected(positions->size());
+          selected_sources.clear();
+          selected_displacements.clear();
 
           // Draw `number_of_connections_` sources
           for(int i=0;i<(int)number_of_connections_;++i) {
@@ -543,16 +470,28 @@ namespace nest
             }
 
             Position<D> source_pos = (*positions)[random_id].first;
-	    double w,d;
-            get_parameters_(source.compute_displacement(target_pos,source_pos), rng, w,d);
-            net_.connect(source_id, target_id, w,d, synapse_model_);
+            Position<D> displacement = source.compute_displacement(target_pos,source_pos);
+            if (batch) {
+              selected_sources.push_back(source_id);
+              selected_displacements.push_back(displacement);
+            } else {
+              double w,d;
+              get_parameters_(displacement, rng, w,d);
+              net_.connect(source_id, target_id, w,d, synapse_model_);
+            }
             is_selected[random_id] = true;
           }
 
+          if (batch)
+            connect_sources_(selected_sources, selected_displacements, target_id, rng);
+
         }
 
       }
-    }
+    } // omp parallel
+
+    if (abort)
+      throw KernelException(error.c_str());
   }
 
 
@@ -569,6 +508,7 @@ namespace nest
     MaskedLayer<D> masked_target(target,target_filter_,mask_,true,allow_oversized_);
 
     std::vector<std::pair<Position<D>,index> >* sources = source.get_global_positions_vector(source_filter_);
+    librandom::RngPtr rng = net_.get_grng();
 
     for (typename std::vector<std::pair<Position<D>,index> >::iterator src_it = sources->begin(); src_it != sources->end(); ++src_it) {
 
@@ -585,18 +525,15 @@ namespace nest
         if ((not allow_autapses_) and (source_id == tgt_it->second))
           continue;
 
-        Position<D> target_displ = target.compute_displacement(source_pos, tgt_it->first);
-        librandom::RngPtr rng = net_.get_grng();
-
         targets.push_back(tgt_it->second);
-        displacements.push_back(target_displ);
-
-        if (kernel_.valid())
-          probabilities.push_back(kernel_->value(target_displ, rng));
-        else
-          probabilities.push_back(1.0);
+        displacements.push_back(target.compute_displacement(source_pos, tgt_it->first));
       }
 
+      if (kernel_.valid())
+        kernel_->values(displacements, rng, probabilities);
+      else
+        probabilities.assign(targets.size(), 1.0);
+
       if ( targets.empty() or
           ((not allow_multapses_) and (targets.size()<number_of_connections_)) ) {
         std::string msg = String::compose("Global source ID %1: Not enough targets found", source_id);
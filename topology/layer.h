@@ -450,6 +450,18 @@ namespace nest
      */
     typename Ntree<D,index>::masked_iterator end();
 
+    /**
+     * @returns the mask as applied by begin(), i.e., converted to a box
+     *          mask for grid masks and mirrored for converse masks.
+     */
+    const Mask<D>& get_mask() const;
+
+    /**
+     * @returns the Ntree holding the positions of the nodes in the layer
+     */
+    lockPTR<Ntree<D,index> > get_ntree() const
+      { return ntree_; }
+
   protected:
 
     /**
@@ -519,6 +531,17 @@ namespace nest
     return ntree_->masked_end();
   }
 
+  template<int D>
+  inline
+  const Mask<D>& MaskedLayer<D>::get_mask() const
+  {
+    try {
+      return dynamic_cast<const Mask<D>&>(*mask_);
+    } catch (std::bad_cast e) {
+      throw BadProperty("Mask is incompatible with layer.");
+    }
+  }
+
   template<int D>
   inline
   Layer<D>::Layer()
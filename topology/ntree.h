@@ -281,6 +281,24 @@ namespace nest
      */
     bool is_leaf() const;
 
+    /**
+     * @returns lower left corner of ntree.
+     */
+    const Position<D>& get_lower_left() const
+      { return lower_left_; }
+
+    /**
+     * @returns extent of ntree.
+     */
+    const Position<D>& get_extent() const
+      { return extent_; }
+
+    /**
+     * @returns a bitmask specifying which directions are periodic
+     */
+    std::bitset<D> get_periodic_mask() const
+      { return periodic_; }
+
   protected:
     /**
      * Change a leaf ntree to a regular ntree with four
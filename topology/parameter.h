@@ -123,6 +123,56 @@ namespace nest
      */
     double_t value(const std::vector<double_t> &pt, librandom::RngPtr& rng) const;
 
+    /**
+     * Compute the values of the parameter at a batch of points.
+     * @param p      points at which to evaluate the parameter
+     * @param values vector receiving the values, resized to p.size()
+     */
+    void values(const std::vector<Position<2> > &p, librandom::RngPtr& rng,
+                std::vector<double_t> &values) const
+      {
+        raw_values(p,rng,values);
+        apply_cutoff_(values);
+      }
+
+    /**
+     * Compute the values of the parameter at a batch of points.
+     * @param p      points at which to evaluate the parameter
+     * @param values vector receiving the values, resized to p.size()
+     */
+    void values(const std::vector<Position<3> > &p, librandom::RngPtr& rng,
+                std::vector<double_t> &values) const
+      {
+        raw_values(p,rng,values);
+        apply_cutoff_(values);
+      }
+
+    /**
+     * Raw values disregarding cutoff. The default implementation calls
+     * raw_value() for each point, derived classes may evaluate the
+     * whole batch in a single loop instead.
+     */
+    virtual void raw_values(const std::vector<Position<2> > &p, librandom::RngPtr& rng,
+                            std::vector<double_t> &values) const
+      { raw_values_(p,rng,values); }
+
+    /**
+     * Raw values disregarding cutoff. The default implementation calls
+     * raw_value() for each point, derived classes may evaluate the
+     * whole batch in a single loop instead.
+     */
+    virtual void raw_values(const std::vector<Position<3> > &p, librandom::RngPtr& rng,
+                            std::vector<double_t> &values) const
+      { raw_values_(p,rng,values); }
+
+    /**
+     * @returns true if the parameter does not draw random numbers, so
+     *          that its values may be computed in any order. Parameters
+     *          are assumed to be random unless they declare otherwise.
+     */
+    virtual bool is_deterministic() const
+      { return false; }
+
     /**
      * Clone method.
      * @returns dynamically allocated copy of parameter object
@@ -151,6 +201,24 @@ namespace nest
     virtual Parameter* subtract_parameter(const Parameter & other) const;
 
   private:
+    template<int D>
+    void raw_values_(const std::vector<Position<D> > &p, librandom::RngPtr& rng,
+                     std::vector<double_t> &values) const
+      {
+        values.resize(p.size());
+        for(size_t i=0;i<p.size();++i)
+          values[i] = raw_value(p[i],rng);
+      }
+
+    void apply_cutoff_(std::vector<double_t> &values) const
+      {
+        if (cutoff_ == -std::numeric_limits<double>::infinity())
+          return;
+        for(size_t i=0;i<values.size();++i)
+          if (values[i]<cutoff_)
+            values[i] = 0.0;
+      }
+
     double_t cutoff_;
   };
 
@@ -185,6 +253,16 @@ namespace nest
     double_t raw_value(const Position<3> &, librandom::RngPtr&) const
       { return value_; }
 
+    void raw_values(const std::vector<Position<2> > &p, librandom::RngPtr&,
+                    std::vector<double_t> &values) const
+      { values.assign(p.size(), value_); }
+    void raw_values(const std::vector<Position<3> > &p, librandom::RngPtr&,
+                    std::vector<double_t> &values) const
+      { values.assign(p.size(), value_); }
+
+    bool is_deterministic() const
+      { return true; }
+
     Parameter * clone() const
       { return new ConstantParameter(value_); }
 
@@ -209,11 +287,40 @@ namespace nest
 
     virtual double_t raw_value(double_t) const = 0;
 
+    /**
+     * Replace each distance in x by the raw value of the parameter.
+     * Derived classes should override this with a loop over their own
+     * raw_value(double_t).
+     */
+    virtual void raw_values(std::vector<double_t> &x) const
+      {
+        for(size_t i=0;i<x.size();++i)
+          x[i] = raw_value(x[i]);
+      }
+
     double_t raw_value(const Position<2> &p, librandom::RngPtr&) const
       { return raw_value(p.length()); }
     double_t raw_value(const Position<3> &p, librandom::RngPtr&) const
       { return raw_value(p.length()); }
 
+    void raw_values(const std::vector<Position<2> > &p, librandom::RngPtr&,
+                    std::vector<double_t> &values) const
+      { lengths_(p,values); raw_values(values); }
+    void raw_values(const std::vector<Position<3> > &p, librandom::RngPtr&,
+                    std::vector<double_t> &values) const
+      { lengths_(p,values); raw_values(values); }
+
+    bool is_deterministic() const
+      { return true; }
+
+  private:
+    template<int D>
+    static void lengths_(const std::vector<Position<D> > &p, std::vector<double_t> &x)
+      {
+        x.resize(p.size());
+        for(size_t i=0;i<p.size();++i)
+          x[i] = p[i].length();
+      }
   };
 
   /**
@@ -241,6 +348,12 @@ namespace nest
         return a_*x + c_;
       }
 
+    void raw_values(std::vector<double_t> &x) const
+      {
+        for(size_t i=0;i<x.size();++i)
+          x[i] = a_*x[i] + c_;
+      }
+
     Parameter * clone() const
       { return new LinearParameter(*this); }
 
@@ -277,6 +390,12 @@ namespace nest
         return c_ + a_*std::exp(-x/tau_);
       }
 
+    void raw_values(std::vector<double_t> &x) const
+      {
+        for(size_t i=0;i<x.size();++i)
+          x[i] = c_ + a_*std::exp(-x[i]/tau_);
+      }
+
     Parameter * clone() const
       { return new ExponentialParameter(*this); }
 
@@ -317,6 +436,13 @@ namespace nest
           std::exp(-std::pow(x - mean_,2)/(2*std::pow(sigma_,2)));
       }
 
+    void raw_values(std::vector<double_t> &x) const
+      {
+        const double_t s = 2*std::pow(sigma_,2);
+        for(size_t i=0;i<x.size();++i)
+          x[i] = c_ + p_center_*std::exp(-std::pow(x[i] - mean_,2)/s);
+      }
+
     Parameter * clone() const
       { return new GaussianParameter(*this); }
 
@@ -360,10 +486,29 @@ namespace nest
         return raw_value(Position<2>(pos[0],pos[1]),rng);
       }
 
+    void raw_values(const std::vector<Position<2> > &p, librandom::RngPtr& rng,
+                    std::vector<double_t> &values) const
+      { raw_values_(p,rng,values); }
+    void raw_values(const std::vector<Position<3> > &p, librandom::RngPtr& rng,
+                    std::vector<double_t> &values) const
+      { raw_values_(p,rng,values); }
+
+    bool is_deterministic() const
+      { return true; }
+
     Parameter * clone() const
       { return new Gaussian2DParameter(*this); }
 
   private:
+    template<int D>
+    void raw_values_(const std::vector<Position<D> > &p, librandom::RngPtr& rng,
+                     std::vector<double_t> &values) const
+      {
+        values.resize(p.size());
+        for(size_t i=0;i<p.size();++i)
+          values[i] = Gaussian2DParameter::raw_value(p[i],rng);
+      }
+
     double_t c_, p_center_, mean_x_, sigma_x_, mean_y_, sigma_y_, rho_;
   };
 
@@ -454,10 +599,37 @@ namespace nest
         return raw_value(rng);
       }
 
+    void raw_values(const std::vector<Position<2> > &p, librandom::RngPtr& rng,
+                    std::vector<double_t> &values) const
+      { raw_values_(p,rng,values); }
+    void raw_values(const std::vector<Position<3> > &p, librandom::RngPtr& rng,
+                    std::vector<double_t> &values) const
+      { raw_values_(p,rng,values); }
+
     Parameter * clone() const
       { return new NormalParameter(*this); }
 
   private:
+    /**
+     * Without truncation, all deviates are drawn at once. Otherwise
+     * values are drawn point by point, since rejected values must be
+     * redrawn before the next point is drawn.
+     */
+    template<int D>
+    void raw_values_(const std::vector<Position<D> > &p, librandom::RngPtr& rng,
+                     std::vector<double_t> &values) const
+      {
+        if ((min_ != -std::numeric_limits<double>::infinity()) or
+            (max_ != std::numeric_limits<double>::infinity())) {
+          Parameter::raw_values(p,rng,values);
+          return;
+        }
+        values.resize(p.size());
+        rdev.get_values(rng, values);
+        for(size_t i=0;i<values.size();++i)
+          values[i] = mean_ + values[i]*sigma_;
+      }
+
     double_t mean_, sigma_, min_, max_;
     librandom::NormalRandomDev rdev;
   };
@@ -510,10 +682,35 @@ namespace nest
         return raw_value(rng);
       }
 
+    void raw_values(const std::vector<Position<2> > &p, librandom::RngPtr& rng,
+                    std::vector<double_t> &values) const
+      { raw_values_(p,rng,values); }
+    void raw_values(const std::vector<Position<3> > &p, librandom::RngPtr& rng,
+                    std::vector<double_t> &values) const
+      { raw_values_(p,rng,values); }
+
     Parameter * clone() const
       { return new LognormalParameter(*this); }
 
   private:
+    /**
+     * @see NormalParameter::raw_values_()
+     */
+    template<int D>
+    void raw_values_(const std::vector<Position<D> > &p, librandom::RngPtr& rng,
+                     std::vector<double_t> &values) const
+      {
+        if ((min_ != -std::numeric_limits<double>::infinity()) or
+            (max_ != std::numeric_limits<double>::infinity())) {
+          Parameter::raw_values(p,rng,values);
+          return;
+        }
+        values.resize(p.size());
+        rdev.get_values(rng, values);
+        for(size_t i=0;i<values.size();++i)
+          values[i] = std::exp(mu_ + values[i]*sigma_);
+      }
+
     double_t mu_, sigma_, min_, max_;
     librandom::NormalRandomDev rdev;
   };
@@ -545,6 +742,22 @@ namespace nest
         return p_->raw_value(p-anchor_, rng);
       }
 
+    void raw_values(const std::vector<Position<D xor 1> > &p, librandom::RngPtr& rng,
+                    std::vector<double_t> &values) const
+      { Parameter::raw_values(p,rng,values); }
+
+    void raw_values(const std::vector<Position<D> > &p, librandom::RngPtr& rng,
+                    std::vector<double_t> &values) const
+      {
+        std::vector<Position<D> > q(p.size());
+        for(size_t i=0;i<p.size();++i)
+          q[i] = p[i]-anchor_;
+        p_->raw_values(q, rng, values);
+      }
+
+    bool is_deterministic() const
+      { return p_->is_deterministic(); }
+
     Parameter * clone() const
       { return new AnchoredParameter(*this); }
 
@@ -587,11 +800,42 @@ namespace nest
     double_t raw_value(const Position<3> &p, librandom::RngPtr& rng) const
       { return parameter1_->value(p,rng) * parameter2_->value(p,rng); }
 
+    void raw_values(const std::vector<Position<2> > &p, librandom::RngPtr& rng,
+                    std::vector<double_t> &values) const
+      { raw_values_(p,rng,values); }
+    void raw_values(const std::vector<Position<3> > &p, librandom::RngPtr& rng,
+                    std::vector<double_t> &values) const
+      { raw_values_(p,rng,values); }
+
+    bool is_deterministic() const
+      { return parameter1_->is_deterministic() and parameter2_->is_deterministic(); }
+
     Parameter * clone() const
       { return new ProductParameter(*this); }
 
   protected:
     Parameter *parameter1_, *parameter2_;
+
+  private:
+    /**
+     * Evaluate each operand for the whole batch. If both operands are
+     * random, the values are computed point by point instead, so that
+     * random numbers are drawn in the same order as by raw_value().
+     */
+    template<int D>
+    void raw_values_(const std::vector<Position<D> > &p, librandom::RngPtr& rng,
+                     std::vector<double_t> &values) const
+      {
+        if (not (parameter1_->is_deterministic() or parameter2_->is_deterministic())) {
+          Parameter::raw_values(p,rng,values);
+          return;
+        }
+        std::vector<double_t> values2;
+        parameter1_->values(p,rng,values);
+        parameter2_->values(p,rng,values2);
+        for(size_t i=0;i<values.size();++i)
+          values[i] *= values2[i];
+      }
   };
 
   /**
@@ -628,11 +872,40 @@ namespace nest
     double_t raw_value(const Position<3> &p, librandom::RngPtr& rng) const
       { return parameter1_->value(p,rng) / parameter2_->value(p,rng); }
 
+    void raw_values(const std::vector<Position<2> > &p, librandom::RngPtr& rng,
+                    std::vector<double_t> &values) const
+      { raw_values_(p,rng,values); }
+    void raw_values(const std::vector<Position<3> > &p, librandom::RngPtr& rng,
+                    std::vector<double_t> &values) const
+      { raw_values_(p,rng,values); }
+
+    bool is_deterministic() const
+      { return parameter1_->is_deterministic() and parameter2_->is_deterministic(); }
+
     Parameter * clone() const
       { return new QuotientParameter(*this); }
 
   protected:
     Parameter *parameter1_, *parameter2_;
+
+  private:
+    /**
+     * @see ProductParameter::raw_values_()
+     */
+    template<int D>
+    void raw_values_(const std::vector<Position<D> > &p, librandom::RngPtr& rng,
+                     std::vector<double_t> &values) const
+      {
+        if (not (parameter1_->is_deterministic() or parameter2_->is_deterministic())) {
+          Parameter::raw_values(p,rng,values);
+          return;
+        }
+        std::vector<double_t> values2;
+        parameter1_->values(p,rng,values);
+        parameter2_->values(p,rng,values2);
+        for(size_t i=0;i<values.size();++i)
+          values[i] /= values2[i];
+      }
   };
 
   /**
@@ -669,11 +942,40 @@ namespace nest
     double_t raw_value(const Position<3> &p, librandom::RngPtr& rng) const
       { return parameter1_->value(p,rng) + parameter2_->value(p,rng); }
 
+    void raw_values(const std::vector<Position<2> > &p, librandom::RngPtr& rng,
+                    std::vector<double_t> &values) const
+      { raw_values_(p,rng,values); }
+    void raw_values(const std::vector<Position<3> > &p, librandom::RngPtr& rng,
+                    std::vector<double_t> &values) const
+      { raw_values_(p,rng,values); }
+
+    bool is_deterministic() const
+      { return parameter1_->is_deterministic() and parameter2_->is_deterministic(); }
+
     Parameter * clone() const
       { return new SumParameter(*this); }
 
   protected:
     Parameter *parameter1_, *parameter2_;
+
+  private:
+    /**
+     * @see ProductParameter::raw_values_()
+     */
+    template<int D>
+    void raw_values_(const std::vector<Position<D> > &p, librandom::RngPtr& rng,
+                     std::vector<double_t> &values) const
+      {
+        if (not (parameter1_->is_deterministic() or parameter2_->is_deterministic())) {
+          Parameter::raw_values(p,rng,values);
+          return;
+        }
+        std::vector<double_t> values2;
+        parameter1_->values(p,rng,values);
+        parameter2_->values(p,rng,values2);
+        for(size_t i=0;i<values.size();++i)
+          values[i] += values2[i];
+      }
   };
 
   /**
@@ -710,11 +1012,40 @@ namespace nest
     double_t raw_value(const Position<3> &p, librandom::RngPtr& rng) const
       { return parameter1_->value(p,rng) - parameter2_->value(p,rng); }
 
+    void raw_values(const std::vector<Position<2> > &p, librandom::RngPtr& rng,
+                    std::vector<double_t> &values) const
+      { raw_values_(p,rng,values); }
+    void raw_values(const std::vector<Position<3> > &p, librandom::RngPtr& rng,
+                    std::vector<double_t> &values) const
+      { raw_values_(p,rng,values); }
+
+    bool is_deterministic() const
+      { return parameter1_->is_deterministic() and parameter2_->is_deterministic(); }
+
     Parameter * clone() const
       { return new DifferenceParameter(*this); }
 
   protected:
     Parameter *parameter1_, *parameter2_;
+
+  private:
+    /**
+     * @see ProductParameter::raw_values_()
+     */
+    template<int D>
+    void raw_values_(const std::vector<Position<D> > &p, librandom::RngPtr& rng,
+                     std::vector<double_t> &values) const
+      {
+        if (not (parameter1_->is_deterministic() or parameter2_->is_deterministic())) {
+          Parameter::raw_values(p,rng,values);
+          return;
+        }
+        std::vector<double_t> values2;
+        parameter1_->values(p,rng,values);
+        parameter2_->values(p,rng,values2);
+        for(size_t i=0;i<values.size();++i)
+          values[i] -= values2[i];
+      }
   };
 
   /**
@@ -750,11 +1081,32 @@ namespace nest
     double_t raw_value(const Position<3> &p, librandom::RngPtr& rng) const
       { return p_->raw_value(-p,rng); }
 
+    void raw_values(const std::vector<Position<2> > &p, librandom::RngPtr& rng,
+                    std::vector<double_t> &values) const
+      { raw_values_(p,rng,values); }
+    void raw_values(const std::vector<Position<3> > &p, librandom::RngPtr& rng,
+                    std::vector<double_t> &values) const
+      { raw_values_(p,rng,values); }
+
+    bool is_deterministic() const
+      { return p_->is_deterministic(); }
+
     Parameter * clone() const
       { return new ConverseParameter(*this); }
 
   protected:
     Parameter *p_;
+
+  private:
+    template<int D>
+    void raw_values_(const std::vector<Position<D> > &p, librandom::RngPtr& rng,
+                     std::vector<double_t> &values) const
+      {
+        std::vector<Position<D> > q(p.size());
+        for(size_t i=0;i<p.size();++i)
+          q[i] = -p[i];
+        p_->raw_values(q, rng, values);
+      }
   };
 
   inline